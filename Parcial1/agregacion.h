@@ -0,0 +1,250 @@
+#ifndef AGREGACION_H
+#define AGREGACION_H
+
+#include "persona.h"
+#include "paralelo.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <utility>
+#include <cstddef>
+
+/**
+ * Núcleos genéricos de agregación sobre el conjunto.
+ *
+ * POR QUÉ: Cada consulta de generador.cpp (país, por ciudad, por calendario y otra vez
+ *          cada una en versión por valor) era un ciclo escrito a mano casi idéntico a
+ *          los demás; mejorar uno no mejoraba los otros.
+ * CÓMO: Un solo recorrido parametrizado en tiempo de compilación por:
+ *         - el extractor de la clave (qué se compara o se suma);
+ *         - la política de agrupamiento (sin grupo, ciudad o calendario);
+ *         - el comparador (std::greater<> para el mayor, std::less<> para el menor).
+ *       Todo es plantilla en el encabezado, así el compilador ve el ciclo completo y lo
+ *       puede alinear y optimizar por instancia. Los recorridos se reparten con
+ *       ejecutarPorBloques; cada hilo acumula en su propia tabla y las tablas se
+ *       combinan en orden de hilo, así que el resultado es el mismo con 1 o N hilos
+ *       (en empate gana la primera persona, igual que los ciclos originales).
+ * PARA QUÉ: Cada consulta es una línea, y una mejora del núcleo llega a todas.
+ */
+namespace agregacion {
+
+    // ===== Extractores de clave =====
+
+    struct Patrimonio {
+        double operator()(const Persona& p) const { return p.getPatrimonio(); }
+    };
+
+    struct Ingresos {
+        double operator()(const Persona& p) const { return p.getIngresosAnuales(); }
+    };
+
+    struct Deudas {
+        double operator()(const Persona& p) const { return p.getDeudas(); }
+    };
+
+    // AAAAMMDD: la fecha menor es la persona más longeva
+    struct FechaNacimiento {
+        int operator()(const Persona& p) const { return p.claveFechaNacimiento(); }
+    };
+
+    // Nombre + apellidos, desde las tablas de largos (sin resolver texto)
+    struct LargoNombre {
+        size_t operator()(const Persona& p) const { return p.largoNombreCompleto(); }
+    };
+
+    // ===== Políticas de agrupamiento (sin grupo: ver mejor()) =====
+    // Clave: lo que se compara en el ciclo (barato); Resultado: la clave del mapa devuelto
+
+    struct PorCiudad {
+        using Clave = std::string_view;
+        using Resultado = std::string;
+        static Clave clave(const Persona& p) { return p.getCiudadNacimiento(); }
+    };
+
+    struct PorCalendario {
+        using Clave = char;
+        using Resultado = char;
+        static Clave clave(const Persona& p) { return p.getCalendarioTributario(); }
+    };
+
+    /**
+     * Tabla pequeña de grupos para un recorrido.
+     *
+     * POR QUÉ: Un std::map con claves std::string por persona domina el costo de las
+     *          consultas agrupadas (hay 20 ciudades y 3 calendarios).
+     * CÓMO: Vector de (clave, estado) con búsqueda lineal, empezando por el último
+     *       grupo encontrado (personas consecutivas suelen repetir grupo en los datos
+     *       sesgados y, en cualquier caso, la búsqueda cabe en una línea de caché).
+     */
+    template <typename Clave, typename Estado>
+    class TablaGrupos {
+    public:
+        Estado& obtener(const Clave& clave, bool& nuevo) {
+            nuevo = false;
+            if (ultimo < grupos.size() && grupos[ultimo].first == clave) {
+                return grupos[ultimo].second;
+            }
+            for (ultimo = 0; ultimo < grupos.size(); ++ultimo) {
+                if (grupos[ultimo].first == clave) {
+                    return grupos[ultimo].second;
+                }
+            }
+            nuevo = true;
+            grupos.emplace_back(clave, Estado());
+            return grupos.back().second;
+        }
+
+        std::vector<std::pair<Clave, Estado>>& datos() { return grupos; }
+
+    private:
+        std::vector<std::pair<Clave, Estado>> grupos;
+        size_t ultimo = 0;
+    };
+
+    /**
+     * Persona con el mejor valor de la clave en cada grupo.
+     *
+     * @return Grupo -> persona (apunta dentro de `personas`).
+     */
+    template <typename Grupo, typename Extractor, typename Comparador>
+    std::map<typename Grupo::Resultado, const Persona*> mejorPorGrupo(const std::vector<Persona>& personas,
+                                                                      unsigned hilos = 1) {
+        using Valor = decltype(Extractor()(personas[0]));
+        struct Mejor {
+            const Persona* persona = nullptr;
+            Valor valor{};
+        };
+        const Extractor extraer;
+        const Comparador mejorQue;
+
+        hilos = hilosParaTamano(personas.size(), hilos);
+        std::vector<TablaGrupos<typename Grupo::Clave, Mejor>> parciales(hilos);
+        ejecutarPorBloques(personas.size(), [&](unsigned h, size_t inicio, size_t fin) {
+            auto& tabla = parciales[h];
+            for (size_t i = inicio; i < fin; ++i) {
+                const Persona& p = personas[i];
+                bool nuevo;
+                Mejor& mejor = tabla.obtener(Grupo::clave(p), nuevo);
+                Valor valor = extraer(p);
+                if (nuevo || mejorQue(valor, mejor.valor)) {
+                    mejor.persona = &p;
+                    mejor.valor = valor;
+                }
+            }
+        }, hilos);
+
+        // Combinación en orden de hilo: un bloque posterior solo gana si es estrictamente mejor
+        std::map<typename Grupo::Resultado, const Persona*> resultado;
+        std::map<typename Grupo::Resultado, Valor> valores;
+        for (auto& tabla : parciales) {
+            for (const auto& [clave, mejor] : tabla.datos()) {
+                typename Grupo::Resultado llave(clave);
+                auto it = valores.find(llave);
+                if (it == valores.end() || mejorQue(mejor.valor, it->second)) {
+                    valores[llave] = mejor.valor;
+                    resultado[llave] = mejor.persona;
+                }
+            }
+        }
+        return resultado;
+    }
+
+    /**
+     * Persona con el mejor valor de la clave en todo el conjunto.
+     *
+     * CÓMO: Sin grupos no hace falta tabla: cada hilo lleva solo (posición, valor).
+     * @return nullptr si el conjunto está vacío.
+     */
+    template <typename Extractor, typename Comparador>
+    const Persona* mejor(const std::vector<Persona>& personas, unsigned hilos = 1) {
+        if (personas.empty()) {
+            return nullptr;
+        }
+        using Valor = decltype(Extractor()(personas[0]));
+        const Extractor extraer;
+        const Comparador mejorQue;
+
+        hilos = hilosParaTamano(personas.size(), hilos);
+        std::vector<std::pair<size_t, Valor>> parciales(hilos, {personas.size(), Valor{}});
+        ejecutarPorBloques(personas.size(), [&](unsigned h, size_t inicio, size_t fin) {
+            if (inicio == fin) {
+                return;
+            }
+            size_t posicion = inicio;
+            Valor valor = extraer(personas[inicio]);
+            for (size_t i = inicio + 1; i < fin; ++i) {
+                Valor actual = extraer(personas[i]);
+                if (mejorQue(actual, valor)) {
+                    posicion = i;
+                    valor = actual;
+                }
+            }
+            parciales[h] = {posicion, valor};
+        }, hilos);
+
+        std::pair<size_t, Valor> ganador = parciales[0];
+        for (const auto& parcial : parciales) {
+            if (parcial.first < personas.size() && mejorQue(parcial.second, ganador.second)) {
+                ganador = parcial;
+            }
+        }
+        return &personas[ganador.first];
+    }
+
+    // Conteo y suma de la clave dentro de un grupo
+    struct Suma {
+        size_t conteo = 0;
+        double total = 0;
+        double promedio() const { return conteo ? total / conteo : 0.0; }
+    };
+
+    /**
+     * Conteo y suma de la clave por grupo (para promedios).
+     *
+     * CÓMO: Igual que mejorPorGrupo; las sumas parciales se combinan en orden de hilo.
+     */
+    template <typename Grupo, typename Extractor>
+    std::map<typename Grupo::Resultado, Suma> sumarPorGrupo(const std::vector<Persona>& personas,
+                                                            unsigned hilos = 1) {
+        const Extractor extraer;
+        hilos = hilosParaTamano(personas.size(), hilos);
+        std::vector<TablaGrupos<typename Grupo::Clave, Suma>> parciales(hilos);
+        ejecutarPorBloques(personas.size(), [&](unsigned h, size_t inicio, size_t fin) {
+            auto& tabla = parciales[h];
+            for (size_t i = inicio; i < fin; ++i) {
+                bool nuevo;
+                Suma& suma = tabla.obtener(Grupo::clave(personas[i]), nuevo);
+                ++suma.conteo;
+                suma.total += extraer(personas[i]);
+            }
+        }, hilos);
+
+        std::map<typename Grupo::Resultado, Suma> resultado;
+        for (auto& tabla : parciales) {
+            for (const auto& [clave, suma] : tabla.datos()) {
+                Suma& destino = resultado[typename Grupo::Resultado(clave)];
+                destino.conteo += suma.conteo;
+                destino.total += suma.total;
+            }
+        }
+        return resultado;
+    }
+
+    // Copia los resultados para las versiones por valor de las consultas
+    template <typename Clave>
+    std::map<Clave, Persona> copiar(const std::map<Clave, const Persona*>& resultado) {
+        std::map<Clave, Persona> copia;
+        for (const auto& [clave, persona] : resultado) {
+            copia.emplace(clave, *persona);
+        }
+        return copia;
+    }
+
+    inline Persona copiar(const Persona* persona) {
+        return persona ? *persona : Persona();
+    }
+}
+
+#endif // AGREGACION_H
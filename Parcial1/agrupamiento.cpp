@@ -0,0 +1,289 @@
+#include "agrupamiento.h"
+#include <chrono>
+#include <algorithm>
+#include <string_view>
+#include <iostream>
+
+namespace {
+    const uint64_t CLAVE_VACIA = ~uint64_t{0}; // Ninguna clave válida usa los 64 bits en 1
+    const unsigned BITS_PARTICION = 6;          // 64 particiones
+
+    const struct {
+        const char* nombre;
+        DimensionGrupo dimension;
+    } DIMENSIONES[] = {
+        {"ciudad", DimensionGrupo::Ciudad},
+        {"nombre", DimensionGrupo::Nombre},
+        {"apellido", DimensionGrupo::PrimerApellido},
+        {"segundo_apellido", DimensionGrupo::SegundoApellido},
+        {"anio", DimensionGrupo::AnioNacimiento},
+        {"decada", DimensionGrupo::Decada},
+        {"calendario", DimensionGrupo::Calendario},
+        {"declarante", DimensionGrupo::Declarante},
+    };
+
+    uint64_t dispersar(uint64_t clave) {
+        return clave * 0x9E3779B97F4A7C15ULL; // Hash de Fibonacci: los bits altos son los mejores
+    }
+
+    // Partición de una clave con un hash distinto al de la tabla (finalizador de MurmurHash3).
+    // Con los bits altos de dispersar() todas las claves de una partición caerían en el
+    // mismo 1/64 de los slots de la tabla que las combina.
+    size_t particionDe(uint64_t clave) {
+        clave ^= clave >> 33;
+        clave *= 0xFF51AFD7ED558CCDULL;
+        clave ^= clave >> 33;
+        clave *= 0xC4CEB9FE1A85EC53ULL;
+        clave ^= clave >> 33;
+        return clave & ((uint64_t{1} << BITS_PARTICION) - 1);
+    }
+
+    using Reloj = std::chrono::high_resolution_clock;
+
+    double milisegundos(Reloj::time_point desde) {
+        return std::chrono::duration<double, std::milli>(Reloj::now() - desde).count();
+    }
+
+    /**
+     * Tabla hash de direccionamiento abierto con sondeo lineal.
+     *
+     * POR QUÉ: std::unordered_map asigna un nodo por grupo y sigue apuntadores.
+     * CÓMO: Claves y agregados en dos arreglos paralelos de tamaño potencia de 2; el
+     *       slot sale de los bits altos del hash y se duplica al pasar del 50 % de carga.
+     */
+    class TablaAgregados {
+    public:
+        TablaAgregados() { redimensionar(64); }
+
+        Agregado& obtener(uint64_t clave) {
+            if ((ocupados + 1) * 2 > claves.size()) {
+                redimensionar(claves.size() * 2);
+            }
+            size_t slot = dispersar(clave) >> desplazamiento;
+            while (claves[slot] != clave) {
+                if (claves[slot] == CLAVE_VACIA) {
+                    claves[slot] = clave;
+                    ++ocupados;
+                    break;
+                }
+                slot = (slot + 1) & (claves.size() - 1);
+            }
+            return agregados[slot];
+        }
+
+        template <typename Funcion>
+        void recorrer(Funcion fn) const {
+            for (size_t slot = 0; slot < claves.size(); ++slot) {
+                if (claves[slot] != CLAVE_VACIA) {
+                    fn(claves[slot], agregados[slot]);
+                }
+            }
+        }
+
+        size_t size() const { return ocupados; }
+
+    private:
+        void redimensionar(size_t capacidad) {
+            std::vector<uint64_t> clavesViejas;
+            std::vector<Agregado> agregadosViejos;
+            clavesViejas.swap(claves);
+            agregadosViejos.swap(agregados);
+
+            claves.assign(capacidad, CLAVE_VACIA);
+            agregados.assign(capacidad, Agregado());
+            desplazamiento = 64;
+            for (size_t c = capacidad; c > 1; c >>= 1) {
+                --desplazamiento;
+            }
+            ocupados = 0;
+            for (size_t slot = 0; slot < clavesViejas.size(); ++slot) {
+                if (clavesViejas[slot] != CLAVE_VACIA) {
+                    obtener(clavesViejas[slot]) = agregadosViejos[slot];
+                }
+            }
+        }
+
+        std::vector<uint64_t> claves;
+        std::vector<Agregado> agregados;
+        unsigned desplazamiento = 64; // 64 - log2(capacidad)
+        size_t ocupados = 0;
+    };
+
+    // Valor de una dimensión que no es la ciudad (esa pasa por el diccionario)
+    uint16_t valorDimension(DimensionGrupo dimension, const Persona& p) {
+        switch (dimension) {
+            case DimensionGrupo::Nombre: return p.getIndiceNombre();
+            case DimensionGrupo::PrimerApellido: return p.getIndicePrimerApellido();
+            case DimensionGrupo::SegundoApellido: return p.getIndiceSegundoApellido();
+            case DimensionGrupo::AnioNacimiento: return static_cast<uint16_t>(p.claveFechaNacimiento() / 10000);
+            case DimensionGrupo::Decada: return static_cast<uint16_t>(p.claveFechaNacimiento() / 100000 * 10);
+            case DimensionGrupo::Calendario: return static_cast<uint16_t>(p.getCalendarioTributario());
+            case DimensionGrupo::Declarante: return p.getDeclaranteRenta() ? 1 : 0;
+            case DimensionGrupo::Ciudad: break;
+        }
+        return 0;
+    }
+
+    std::string textoDimension(DimensionGrupo dimension, uint16_t valor, std::string_view ciudad) {
+        switch (dimension) {
+            case DimensionGrupo::Ciudad: return std::string(ciudad);
+            case DimensionGrupo::Nombre: return std::string(nombrePorIndice(static_cast<uint8_t>(valor)));
+            case DimensionGrupo::PrimerApellido:
+            case DimensionGrupo::SegundoApellido: return std::string(apellidoPorIndice(static_cast<uint8_t>(valor)));
+            case DimensionGrupo::AnioNacimiento: return std::to_string(valor);
+            case DimensionGrupo::Decada: return std::to_string(valor) + "s";
+            case DimensionGrupo::Calendario: return std::string(1, static_cast<char>(valor));
+            case DimensionGrupo::Declarante: return valor ? "declarante" : "no declarante";
+        }
+        return "";
+    }
+
+    double valorCampo(const Persona& p, CampoFinanciero campo) {
+        switch (campo) {
+            case CampoFinanciero::Ingresos: return p.getIngresosAnuales();
+            case CampoFinanciero::Deudas: return p.getDeudas();
+            default: return p.getPatrimonio();
+        }
+    }
+}
+
+/**
+ * Implementación de agrupar.
+ *
+ * POR QUÉ: Ver agrupamiento.h.
+ * CÓMO: La clave empaqueta 16 bits por dimensión (la primera en los bits altos). En la fase 2 cada hilo
+ *       escribe en sus propios P vectores de salida, y en la fase 3 la partición p la
+ *       combina solo el hilo p % hilos: ningún dato se comparte para escritura.
+ * PARA QUÉ: Que el único punto secuencial sea armar el texto de los grupos finales.
+ */
+ResultadoAgrupamiento agrupar(const std::vector<Persona>& personas, const std::vector<DimensionGrupo>& dimensiones,
+                              CampoFinanciero campo, unsigned hilos) {
+    ResultadoAgrupamiento resultado;
+    if (dimensiones.empty() || dimensiones.size() > MAXIMO_DIMENSIONES) {
+        std::cerr << "Error: se necesitan entre 1 y " << MAXIMO_DIMENSIONES << " dimensiones\n";
+        return resultado;
+    }
+    hilos = hilosParaTamano(personas.size(), hilos);
+    const size_t particiones = size_t{1} << BITS_PARTICION;
+    resultado.hilos = hilos;
+    resultado.particiones = particiones;
+    DiccionarioCiudades diccionario;
+
+    // Fase 1: agregación local por hilo
+    auto inicio = Reloj::now();
+    std::vector<TablaAgregados> locales(hilos);
+    ejecutarPorBloques(personas.size(), [&](unsigned h, size_t desde, size_t hasta) {
+        DiccionarioCiudades::Conocidas conocidas;
+        TablaAgregados& tabla = locales[h];
+        for (size_t i = desde; i < hasta; ++i) {
+            const Persona& p = personas[i];
+            uint64_t clave = 0;
+            for (DimensionGrupo dimension : dimensiones) {
+                clave = clave << 16 | (dimension == DimensionGrupo::Ciudad
+                                           ? diccionario.codigo(p.getCiudadNacimiento(), conocidas)
+                                           : valorDimension(dimension, p));
+            }
+            tabla.obtener(clave).agregar(valorCampo(p, campo));
+        }
+    }, hilos);
+    resultado.tiempoLocal = milisegundos(inicio);
+
+    // Fase 2: cada hilo reparte sus grupos por partición (hash propio, independiente del slot)
+    inicio = Reloj::now();
+    using Parcial = std::pair<uint64_t, Agregado>;
+    std::vector<std::vector<std::vector<Parcial>>> repartidos(hilos, std::vector<std::vector<Parcial>>(particiones));
+    ejecutarPorBloques(hilos, [&](unsigned, size_t desde, size_t hasta) {
+        for (size_t h = desde; h < hasta; ++h) {
+            locales[h].recorrer([&](uint64_t clave, const Agregado& agregado) {
+                repartidos[h][particionDe(clave)].emplace_back(clave, agregado);
+            });
+        }
+    }, hilos, 1);
+    for (const auto& tabla : locales) {
+        resultado.gruposLocales += tabla.size();
+    }
+    locales.clear();
+    resultado.tiempoParticion = milisegundos(inicio);
+
+    // Fase 3: cada partición se combina completa en un solo hilo
+    inicio = Reloj::now();
+    std::vector<std::vector<Parcial>> combinados(particiones);
+    ejecutarPorBloques(hilos, [&](unsigned, size_t desde, size_t hasta) {
+        for (size_t h = desde; h < hasta; ++h) {
+            for (size_t p = h; p < particiones; p += hilos) {
+                TablaAgregados tabla;
+                for (unsigned origen = 0; origen < hilos; ++origen) {
+                    for (const auto& [clave, agregado] : repartidos[origen][p]) {
+                        tabla.obtener(clave).combinar(agregado);
+                    }
+                }
+                tabla.recorrer([&](uint64_t clave, const Agregado& agregado) {
+                    combinados[p].emplace_back(clave, agregado);
+                });
+            }
+        }
+    }, hilos, 1);
+
+    std::vector<Parcial> grupos;
+    for (auto& particion : combinados) {
+        grupos.insert(grupos.end(), particion.begin(), particion.end());
+    }
+    resultado.filas.reserve(grupos.size());
+    for (const auto& [clave, agregado] : grupos) {
+        std::string texto;
+        for (size_t d = 0; d < dimensiones.size(); ++d) {
+            uint16_t valor = static_cast<uint16_t>(clave >> (16 * (dimensiones.size() - 1 - d)));
+            std::string_view ciudad = dimensiones[d] == DimensionGrupo::Ciudad ? diccionario.nombre(valor) : "";
+            texto += (d ? " | " : "") + textoDimension(dimensiones[d], valor, ciudad);
+        }
+        resultado.filas.push_back({std::move(texto), agregado});
+    }
+    // Por texto: los códigos de ciudad dependen de qué hilo vio primero cada ciudad
+    std::sort(resultado.filas.begin(), resultado.filas.end(),
+              [](const FilaAgrupada& a, const FilaAgrupada& b) { return a.grupo < b.grupo; });
+    resultado.tiempoCombinacion = milisegundos(inicio);
+    return resultado;
+}
+
+std::string textoGrupo(const Persona& p, const std::vector<DimensionGrupo>& dimensiones) {
+    std::string texto;
+    for (size_t d = 0; d < dimensiones.size(); ++d) {
+        texto += (d ? " | " : "") + textoDimension(dimensiones[d], valorDimension(dimensiones[d], p),
+                                                   p.getCiudadNacimiento());
+    }
+    return texto;
+}
+
+bool dimensionPorNombre(const std::string& nombre, DimensionGrupo& dimension) {
+    for (const auto& entrada : DIMENSIONES) {
+        if (nombre == entrada.nombre) {
+            dimension = entrada.dimension;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string nombresDimensiones() {
+    std::string nombres;
+    for (const auto& entrada : DIMENSIONES) {
+        nombres += (nombres.empty() ? "" : " ") + std::string(entrada.nombre);
+    }
+    return nombres;
+}
+
+uint16_t DiccionarioCiudades::codigo(std::string_view ciudad, Conocidas& conocidas) {
+    for (const auto& [vista, codigo] : conocidas) {
+        if (vista.data() == ciudad.data() && vista.size() == ciudad.size()) {
+            return codigo;
+        }
+    }
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    auto it = std::find(ciudades.begin(), ciudades.end(), ciudad);
+    uint16_t codigo = static_cast<uint16_t>(it - ciudades.begin());
+    if (it == ciudades.end()) {
+        ciudades.push_back(ciudad);
+    }
+    conocidas.emplace_back(ciudad, codigo);
+    return codigo;
+}
@@ -0,0 +1,122 @@
+#ifndef AGRUPAMIENTO_H
+#define AGRUPAMIENTO_H
+
+#include "persona.h"
+#include "paralelo.h"
+#include "indice_valores.h" // CampoFinanciero
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <mutex>
+
+// Atributos por los que se puede agrupar (hasta MAXIMO_DIMENSIONES a la vez)
+enum class DimensionGrupo {
+    Ciudad, Nombre, PrimerApellido, SegundoApellido, AnioNacimiento, Decada, Calendario, Declarante
+};
+
+constexpr size_t MAXIMO_DIMENSIONES = 4; // Cada dimensión ocupa 16 bits de la clave
+
+/**
+ * Conteo, suma, mínimo y máximo de un campo dentro de un grupo.
+ */
+struct Agregado {
+    uint64_t conteo = 0;
+    double suma = 0;
+    double minimo = std::numeric_limits<double>::infinity();
+    double maximo = -std::numeric_limits<double>::infinity();
+
+    void agregar(double valor) {
+        ++conteo;
+        suma += valor;
+        minimo = valor < minimo ? valor : minimo;
+        maximo = valor > maximo ? valor : maximo;
+    }
+
+    void combinar(const Agregado& otro) {
+        conteo += otro.conteo;
+        suma += otro.suma;
+        minimo = otro.minimo < minimo ? otro.minimo : minimo;
+        maximo = otro.maximo > maximo ? otro.maximo : maximo;
+    }
+
+    double promedio() const { return conteo ? suma / conteo : 0.0; }
+};
+
+/**
+ * Numeración de ciudades compartida entre hilos.
+ *
+ * CÓMO: Cada hilo recuerda las vistas que ya vio (comparadas por apuntador y largo,
+ *       porque las personas de una misma ciudad comparten el texto); el mutex solo se
+ *       toma la primera vez que un hilo encuentra una ciudad.
+ * Las vistas deben seguir vivas mientras se use el diccionario.
+ */
+class DiccionarioCiudades {
+public:
+    using Conocidas = std::vector<std::pair<std::string_view, uint16_t>>; // Caché de un hilo
+
+    uint16_t codigo(std::string_view ciudad, Conocidas& conocidas);
+    std::string_view nombre(uint16_t codigo) const { return ciudades[codigo]; }
+    size_t size() const { return ciudades.size(); }
+
+private:
+    std::mutex mutex;
+    std::vector<std::string_view> ciudades;
+};
+
+struct FilaAgrupada {
+    std::string grupo;  // Valores de las dimensiones separados por " | "
+    Agregado agregado;
+};
+
+struct ResultadoAgrupamiento {
+    std::vector<FilaAgrupada> filas; // Ordenadas por el texto del grupo
+    unsigned hilos = 0;
+    size_t particiones = 0;
+    size_t gruposLocales = 0;        // Suma de los grupos de todas las tablas por hilo
+    // Tiempos por fase en ms
+    double tiempoLocal = 0;          // Agregación en las tablas de cada hilo
+    double tiempoParticion = 0;      // Reparto de los parciales por partición
+    double tiempoCombinacion = 0;    // Combinación de cada partición (y armado de filas)
+};
+
+/**
+ * Agrupamiento paralelo por dimensiones arbitrarias (GROUP BY).
+ *
+ * POR QUÉ: Las consultas fijas por ciudad o calendario no cubren preguntas como
+ *          "patrimonio por (apellido, ciudad)" o "por año de nacimiento", y con 100
+ *          millones de filas un std::map global protegido por mutex no escala.
+ * CÓMO: Tres fases sin bloqueos globales:
+ *         1. Cada hilo agrega su bloque en una tabla hash propia de direccionamiento
+ *            abierto (sondeo lineal, clave de 64 bits con las dimensiones empaquetadas).
+ *         2. Cada hilo reparte sus grupos en P particiones según un segundo hash,
+ *            independiente del que elige el slot (partición radix).
+ *         3. Cada hilo combina las particiones que le tocan leyendo los parciales de
+ *            todos los hilos para esa partición; dos hilos nunca tocan el mismo grupo.
+ *       Las ciudades se numeran con un diccionario compartido que cada hilo consulta
+ *       solo la primera vez que ve una ciudad (como el cubo OLAP).
+ * PARA QUÉ: Agregaciones libres que escalan con los núcleos y reportan el costo de
+ *           cada fase.
+ *
+ * @param dimensiones Entre 1 y MAXIMO_DIMENSIONES dimensiones.
+ * @return Filas vacías si las dimensiones no son válidas (el error va a std::cerr).
+ */
+ResultadoAgrupamiento agrupar(const std::vector<Persona>& personas, const std::vector<DimensionGrupo>& dimensiones,
+                              CampoFinanciero campo, unsigned hilos = numeroHilos());
+
+// Texto del grupo de una persona, igual al de FilaAgrupada::grupo (para agrupamientos de referencia)
+std::string textoGrupo(const Persona& p, const std::vector<DimensionGrupo>& dimensiones);
+
+/**
+ * Traduce "ciudad", "apellido", "anio"... a su dimensión.
+ *
+ * @return false si el nombre no corresponde a ninguna dimensión.
+ */
+bool dimensionPorNombre(const std::string& nombre, DimensionGrupo& dimension);
+
+// Lista de nombres aceptados por dimensionPorNombre, separados por espacios
+std::string nombresDimensiones();
+
+#endif // AGRUPAMIENTO_H
@@ -0,0 +1,65 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+/**
+ * Arena monotónica (asignador por desplazamiento) para las cadenas de las personas.
+ *
+ * POR QUÉ: Cada Persona tenía cinco std::string propios; generarPersona construía el
+ *          apellido con += y cada cadena larga era un bloque independiente en el heap.
+ *          Con millones de personas eso son millones de asignaciones y liberaciones.
+ * CÓMO: Reserva bloques grandes (4 MB) y entrega memoria avanzando un apuntador. Nunca
+ *       libera cadenas individuales: todos los bloques se liberan juntos al destruir la
+ *       arena. En Linux los bloques se piden con mmap usando páginas enormes cuando el
+ *       sistema las ofrece (MAP_HUGETLB, o madvise(MADV_HUGEPAGE) como alternativa).
+ * PARA QUÉ: Cero asignaciones por persona y liberación del conjunto en O(bloques).
+ *
+ * No es segura entre hilos: cada hilo generador debe usar su propia arena.
+ */
+class ArenaCadenas {
+public:
+    explicit ArenaCadenas(size_t tamBloque = size_t{4} << 20);
+    ~ArenaCadenas();
+
+    ArenaCadenas(const ArenaCadenas&) = delete;
+    ArenaCadenas& operator=(const ArenaCadenas&) = delete;
+
+    /**
+     * Reserva n bytes contiguos (sin alineación: solo se guardan caracteres).
+     *
+     * @return Apuntador válido hasta que se destruya la arena.
+     */
+    char* reservar(size_t n);
+
+    // Copia el texto a la arena y devuelve una vista sobre la copia
+    std::string_view guardar(std::string_view texto);
+
+    // Bytes pedidos al sistema (bloques completos) y bytes realmente usados
+    size_t bytesReservados() const { return reservados; }
+    size_t bytesUsados() const { return usados; }
+
+    // true si al menos un bloque quedó respaldado por páginas enormes
+    bool usaPaginasEnormes() const { return paginasEnormes; }
+
+private:
+    struct Bloque {
+        char* datos;
+        size_t tam;
+        bool mapeado; // true: liberar con munmap; false: con delete[]
+    };
+
+    void nuevoBloque(size_t minimo);
+
+    size_t tamBloque;
+    std::vector<Bloque> bloques;
+    char* actual = nullptr;   // Siguiente byte libre del bloque activo
+    size_t disponibles = 0;   // Bytes libres en el bloque activo
+    size_t reservados = 0;
+    size_t usados = 0;
+    bool paginasEnormes = false;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,206 @@
+#include "barrido.h"
+#include "motor_consultas.h"
+#include "generador.h"
+#include "histogramas.h"
+#include "monitor.h"
+#include "radix.h"
+#include "cubo_olap.h"
+#include "agregacion.h"
+#include "pool_hilos.h"
+#include "paralelo.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <unistd.h> // sysconf
+
+namespace {
+    const size_t N_INICIAL = 1000;
+    const size_t CONSULTAS_POR_LOTE = 100000;  // buscar_id concurrentes por medición
+    const double BYTES_POR_PERSONA_INICIAL = 400; // Persona + arena + índices, antes de medir
+
+    // 1, 2, 4... hasta el número de núcleos (incluido aunque no sea potencia de 2)
+    std::vector<unsigned> serieHilos() {
+        std::vector<unsigned> serie;
+        unsigned maximo = numeroHilos();
+        for (unsigned h = 1; h < maximo; h *= 2) {
+            serie.push_back(h);
+        }
+        serie.push_back(maximo);
+        return serie;
+    }
+
+    size_t memoriaFisicaMB() {
+        long paginas = sysconf(_SC_PHYS_PAGES);
+        long tamano = sysconf(_SC_PAGESIZE);
+        return paginas > 0 && tamano > 0 ? static_cast<size_t>(paginas) / 1024 * static_cast<size_t>(tamano) / 1024 : 0;
+    }
+
+    struct Barrido {
+        Monitor monitor;
+        long memoriaPico = 0; // KB de RSS más alto visto en el tamaño actual
+
+        /**
+         * Mide una operación y registra su punto.
+         *
+         * @param elementos Filas o consultas procesadas (para el rendimiento).
+         * @param base Tiempo con 1 hilo para la aceleración (0 si este es el de 1 hilo).
+         * @return Tiempo en ms.
+         */
+        double medir(const std::string& operacion, size_t n, unsigned hilos, size_t elementos,
+                     double base, const std::function<void()>& operacionMedida) {
+            long memoriaInicio = monitor.obtener_memoria();
+            monitor.iniciar_tiempo();
+            operacionMedida();
+            double tiempo = monitor.detener_tiempo();
+            long memoriaFin = monitor.obtener_memoria();
+            memoriaPico = std::max(memoriaPico, memoriaFin);
+
+            double rendimiento = tiempo > 0 ? elementos / (tiempo / 1000.0) : 0.0;
+            double aceleracion = base > 0 && tiempo > 0 ? base / tiempo : 1.0;
+            monitor.registrar_escalado(operacion, n, hilos, tiempo, memoriaFin - memoriaInicio,
+                                       rendimiento, aceleracion);
+            std::cout << std::left << std::setw(14) << operacion << std::right
+                      << std::setw(12) << n << std::setw(7) << hilos
+                      << std::fixed << std::setprecision(3) << std::setw(13) << tiempo
+                      << std::setprecision(0) << std::setw(16) << rendimiento
+                      << std::setprecision(2) << std::setw(10) << aceleracion
+                      << std::setw(10) << aceleracion / hilos << "\n";
+            std::cout.unsetf(std::ios::floatfield);
+            std::cout << std::setprecision(6);
+            return tiempo;
+        }
+    };
+}
+
+/**
+ * Implementación de ejecutarBarrido.
+ *
+ * POR QUÉ: Ver barrido.h.
+ * CÓMO: La proyección parte del pico de RSS del tamaño anterior y suma las personas
+ *       nuevas por el costo marginal medido entre los dos últimos tamaños (así los
+ *       costos fijos, como las pilas de los hilos, no inflan la estimación en n
+ *       pequeños). El costo solo puede crecer: la proyección peca de conservadora.
+ * PARA QUÉ: Que un nMaximo demasiado grande termine el barrido con un aviso en lugar
+ *           de llevar la máquina a intercambiar con disco.
+ */
+int ejecutarBarrido(size_t nMaximo, size_t limiteMB, const std::string& archivo) {
+    if (limiteMB == 0) {
+        limiteMB = memoriaFisicaMB() / 2;
+    }
+    const std::vector<unsigned> hilos = serieHilos();
+    Barrido barrido;
+    double bytesPorPersona = BYTES_POR_PERSONA_INICIAL;
+    long picoAnterior = barrido.monitor.obtener_memoria(); // KB
+    size_t nAnterior = 0;
+
+    std::cout << "=== BARRIDO DE ESCALADO ===\n"
+              << "n de " << N_INICIAL << " a " << nMaximo << " (x10), hilos:";
+    for (unsigned h : hilos) {
+        std::cout << " " << h;
+    }
+    std::cout << ", límite de memoria " << limiteMB << " MB\n\n"
+              << std::left << std::setw(14) << "Operación" << std::right << std::setw(12) << "N"
+              << std::setw(7) << "Hilos" << std::setw(13) << "Tiempo(ms)" << std::setw(16) << "Elem/s"
+              << std::setw(10) << "Acel." << std::setw(10) << "Efic." << "\n";
+
+    for (size_t n = N_INICIAL; n <= nMaximo; n *= 10) {
+        double proyectadoMB = (picoAnterior * 1024.0 + (n - nAnterior) * bytesPorPersona) / (1024.0 * 1024.0);
+        if (proyectadoMB > limiteMB) {
+            std::cout << "\nSe detiene antes de n = " << n << ": se proyectan " << std::fixed
+                      << std::setprecision(0) << proyectadoMB << " MB (" << bytesPorPersona
+                      << " bytes por persona) y el límite es " << limiteMB << " MB\n";
+            std::cout.unsetf(std::ios::floatfield);
+            std::cout << std::setprecision(6);
+            break;
+        }
+        barrido.memoriaPico = 0;
+
+        MotorConsultas motor;
+        motor.usarCache = false; // Se mide el recorrido: desde la segunda medición respondería la caché
+        ColeccionPersonas personas;
+        barrido.medir("generar", n, 1, n, 0, [&]() { personas = generarColeccion(static_cast<int>(n)); });
+        barrido.medir("indexar", n, 1, n, 0, [&]() { motor.cargar(std::move(personas)); });
+        const std::vector<Persona>& datos = motor.personas.datos();
+
+        // Consultas secuenciales del motor: un solo hilo, sin aceleración que medir
+        const std::pair<const char*, TipoConsulta> secuenciales[] = {
+            {"longeva", TipoConsulta::LongevaPais}, {"patrimonio", TipoConsulta::PatrimonioPais},
+            {"deudas", TipoConsulta::DeudasPais}, {"nombre_largo", TipoConsulta::NombreMasLargo},
+            {"contar_ciudad", TipoConsulta::ContarCiudad}};
+        const std::string ciudad(datos[0].getCiudadNacimiento());
+        for (const auto& [nombre, tipo] : secuenciales) {
+            std::string arg = tipo == TipoConsulta::ContarCiudad ? ciudad : "";
+            barrido.medir(nombre, n, 1, n, 0, [&]() {
+                std::string texto;
+                resolverConsulta(motor, tipo, arg, texto);
+            });
+        }
+
+        // Operaciones paralelas: la aceleración es contra la medición con 1 hilo del mismo n
+        std::vector<uint64_t> claves(n);
+        for (size_t i = 0; i < n; ++i) {
+            claves[i] = claveOrdenable(datos[i].getPatrimonio());
+        }
+        std::vector<std::string> ids;
+        size_t consultas = std::min(n, CONSULTAS_POR_LOTE);
+        for (size_t i = 0; i < consultas; ++i) {
+            ids.emplace_back(datos[i * (n / consultas)].getId());
+        }
+
+        double baseRadix = 0, basePorCiudad = 0, baseCubo = 0, baseIds = 0, baseLotes = 0, baseHistogramas = 0;
+        for (unsigned h : hilos) {
+            double t = barrido.medir("generar_lotes", n, h, n, baseLotes, [&]() {
+                generarColeccionPorLotes(static_cast<int>(n), h);
+            });
+            baseLotes = baseLotes > 0 ? baseLotes : t;
+
+            t = barrido.medir("radix", n, h, n, baseRadix, [&]() { ordenarRadixParalelo(claves, nullptr, h); });
+            baseRadix = baseRadix > 0 ? baseRadix : t;
+
+            t = barrido.medir("por_ciudad", n, h, n, basePorCiudad, [&]() {
+                agregacion::mejorPorGrupo<agregacion::PorCiudad, agregacion::Patrimonio, std::greater<>>(datos, h);
+            });
+            basePorCiudad = basePorCiudad > 0 ? basePorCiudad : t;
+
+            t = barrido.medir("histogramas", n, h, n, baseHistogramas, [&]() { construirHistogramas(datos, 1e8, 2025, h); });
+            baseHistogramas = baseHistogramas > 0 ? baseHistogramas : t;
+
+            CuboOLAP cubo;
+            t = barrido.medir("cubo_olap", n, h, n, baseCubo, [&]() { cubo.construir(datos, h); });
+            baseCubo = baseCubo > 0 ? baseCubo : t;
+
+            PoolHilos pool(h); // Creado fuera de la medición, como en el servidor
+            t = barrido.medir("buscar_id", n, h, consultas, baseIds, [&]() {
+                std::vector<std::future<void>> pendientes;
+                for (unsigned b = 0; b < h; ++b) {
+                    size_t inicio = consultas * b / h;
+                    size_t fin = consultas * (b + 1) / h;
+                    pendientes.push_back(pool.enviar([&, inicio, fin]() {
+                        std::string texto;
+                        for (size_t i = inicio; i < fin; ++i) {
+                            resolverConsulta(motor, TipoConsulta::BuscarID, ids[i], texto);
+                        }
+                    }));
+                }
+                for (auto& f : pendientes) {
+                    f.get();
+                }
+            });
+            baseIds = baseIds > 0 ? baseIds : t;
+        }
+
+        if (nAnterior > 0) { // El primer tamaño carga con todos los costos fijos
+            double marginal = (barrido.memoriaPico - picoAnterior) * 1024.0 / (n - nAnterior);
+            bytesPorPersona = std::max(bytesPorPersona, marginal);
+        }
+        picoAnterior = std::max(picoAnterior, barrido.memoriaPico);
+        nAnterior = n;
+    }
+
+    std::cout << "\n";
+    barrido.monitor.exportar_csv(archivo);
+    return std::ifstream(archivo) ? 0 : 1;
+}
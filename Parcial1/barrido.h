@@ -0,0 +1,31 @@
+#ifndef BARRIDO_H
+#define BARRIDO_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * Barrido de escalado: tamaño del conjunto × número de hilos.
+ *
+ * POR QUÉ: Cada medición del menú es un punto suelto (un n, todos los hilos); para
+ *          planear capacidad hace falta ver cómo crecen tiempo y memoria con n y cuánto
+ *          aportan los hilos en cada tamaño.
+ * CÓMO: Para n = 1e3, 1e4, ... hasta nMaximo genera el conjunto, lo indexa y corre:
+ *         - las consultas secuenciales del motor (longeva, patrimonio, deudas,
+ *           nombre_largo, contar_ciudad), con un solo hilo;
+ *         - las operaciones paralelas (generación por lotes, radix sobre el patrimonio,
+ *           mayor patrimonio por ciudad con agregacion.h, histogramas por ciudad,
+ *           construcción del cubo OLAP y un lote de buscar_id concurrentes) con 1, 2, 4... hilos hasta el número de núcleos; la
+ *           aceleración se mide contra 1 hilo en el mismo n.
+ *       Antes de cada tamaño proyecta la memoria con los bytes por persona medidos en
+ *       el tamaño anterior y se detiene si superaría el límite.
+ * PARA QUÉ: `./programa --barrido [nMaximo] [limiteMB] [archivo.csv]` deja todas las
+ *           curvas en un CSV (formato de Monitor::exportar_csv con columnas de escalado).
+ *
+ * @param nMaximo A lo sumo INT_MAX: los generadores reciben el tamaño como int.
+ * @param limiteMB Memoria máxima proyectada; 0 usa la mitad de la RAM física.
+ * @return 0 si se exportó el CSV; 1 si no se pudo escribir.
+ */
+int ejecutarBarrido(size_t nMaximo, size_t limiteMB, const std::string& archivo);
+
+#endif // BARRIDO_H
@@ -0,0 +1,77 @@
+#ifndef CACHE_CONSULTAS_H
+#define CACHE_CONSULTAS_H
+
+#include <any>
+#include <map>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Caché de resultados de consultas, válida para una generación del conjunto.
+ *
+ * POR QUÉ: Las opciones 8 y 10 del menú y las consultas de recorrido completo del
+ *          motor (servidor y scripts) se repiten sobre el mismo conjunto y cada vez
+ *          recorren todas las personas para obtener exactamente el mismo resultado.
+ * CÓMO: Cada resultado se guarda bajo (consulta, parámetros) junto con la generación
+ *       (versión publicada) del conjunto para la que se calculó y lo que tardó en
+ *       calcularse. Si la generación pedida no coincide, se recalcula y se reemplaza;
+ *       descartarAnteriores() libera de una vez los resultados de versiones viejas
+ *       (guardan apuntadores a personas de esos conjuntos). Los resultados se guardan
+ *       en std::any, así cada consulta conserva su propio tipo.
+ * PARA QUÉ: Responder consultas repetidas sin recorrer el conjunto y saber cuánto
+ *           tiempo se ahorró.
+ *
+ * No es segura entre hilos: el menú la usa desde un solo hilo y MotorConsultas la
+ * protege con su propio candado.
+ */
+class CacheConsultas {
+public:
+    /**
+     * Devuelve el resultado guardado o lo calcula con calcular() y lo guarda.
+     *
+     * @param acierto Recibe true si el resultado ya estaba en la caché.
+     * @param ahorro Recibe los ms que tomó calcularlo originalmente (0 si fue un fallo).
+     */
+    template <typename Calcular>
+    const auto& obtener(const std::string& consulta, const std::string& parametros, uint64_t generacion,
+                        Calcular calcular, bool& acierto, double& ahorro) {
+        using Resultado = decltype(calcular());
+        Entrada& entrada = entradas[consulta + '\0' + parametros];
+
+        acierto = entrada.generacion == generacion && entrada.valor.has_value();
+        if (acierto) {
+            ahorro = entrada.costo;
+            return *std::any_cast<Resultado>(&entrada.valor);
+        }
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        entrada.valor = calcular();
+        std::chrono::duration<double, std::milli> costo = std::chrono::high_resolution_clock::now() - inicio;
+        entrada.generacion = generacion;
+        entrada.costo = costo.count();
+        ahorro = 0;
+        return *std::any_cast<Resultado>(&entrada.valor);
+    }
+
+    // Elimina los resultados calculados para otras generaciones del conjunto
+    void descartarAnteriores(uint64_t generacion) {
+        for (auto it = entradas.begin(); it != entradas.end();) {
+            it = it->second.generacion == generacion ? std::next(it) : entradas.erase(it);
+        }
+    }
+
+    size_t size() const { return entradas.size(); }
+
+private:
+    struct Entrada {
+        uint64_t generacion = 0;
+        std::any valor;
+        double costo = 0; // ms que tomó calcular el resultado
+    };
+
+    std::map<std::string, Entrada> entradas;
+};
+
+#endif // CACHE_CONSULTAS_H
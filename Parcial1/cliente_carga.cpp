@@ -0,0 +1,219 @@
+#include "protocolo.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Generador de carga para el modo servidor (./programa --servidor).
+ *
+ * POR QUÉ: Medir cuántas consultas por segundo sostiene el motor y con qué latencia.
+ * CÓMO: Abre varias conexiones en paralelo; cada una envía lotes de `profundidad`
+ *       solicitudes con una sola escritura (pipelining) y luego lee sus respuestas.
+ *       La latencia de cada solicitud va desde el envío de su lote hasta la llegada de
+ *       su respuesta.
+ * PARA QUÉ: ./cliente_carga [ruta] [conexiones] [solicitudes por conexión]
+ *           [profundidad] [id|rango|percentil|ciudad|recorrido|mixta] [--apagar]
+ */
+
+namespace {
+    using Reloj = std::chrono::steady_clock;
+
+    const char* const CIUDADES[] = {"Bogotá", "Medellín", "Cali", "Barranquilla", "Cartagena",
+                                    "Pasto", "Tunja", "Pereira", "Ibagué", "Neiva"};
+
+    int conectar(const std::string& ruta) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        sockaddr_un direccion{};
+        direccion.sun_family = AF_UNIX;
+        std::strncpy(direccion.sun_path, ruta.c_str(), sizeof(direccion.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    void agregarSolicitud(std::string& salida, uint32_t id, TipoConsulta tipo, const std::string& arg) {
+        CabeceraSolicitud cabecera{id, static_cast<uint16_t>(tipo), static_cast<uint16_t>(arg.size())};
+        salida.append(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+        salida.append(arg);
+    }
+
+    // Lee una respuesta completa; false si la conexión se cerró
+    bool leerRespuesta(int fd, CabeceraRespuesta& cabecera, std::string& cuerpo) {
+        if (!leerTodo(fd, reinterpret_cast<char*>(&cabecera), sizeof(cabecera))) {
+            return false;
+        }
+        cuerpo.resize(cabecera.largo);
+        return cabecera.largo == 0 || leerTodo(fd, &cuerpo[0], cabecera.largo);
+    }
+
+    struct ResultadoConexion {
+        std::vector<double> latencias; // microsegundos
+        size_t noEncontradas = 0;
+        size_t errores = 0;
+    };
+}
+
+int main(int argc, char* argv[]) {
+    std::string ruta = argc > 1 ? argv[1] : RUTA_SOCKET_PREDETERMINADA;
+    int conexiones = argc > 2 ? std::atoi(argv[2]) : 4;
+    long porConexion = argc > 3 ? std::atol(argv[3]) : 10000;
+    int profundidad = argc > 4 ? std::atoi(argv[4]) : 16;
+    std::string mezcla = argc > 5 ? argv[5] : "mixta";
+    bool apagar = argc > 6 && std::string(argv[6]) == "--apagar";
+
+    if (conexiones <= 0 || porConexion <= 0 || profundidad <= 0) {
+        std::cerr << "Error: conexiones, solicitudes y profundidad deben ser positivas\n";
+        return 1;
+    }
+
+    // Tamaño del conjunto y primer ID, para pedir cédulas que existen
+    int fd = conectar(ruta);
+    if (fd < 0) {
+        perror("Error al conectar con el servidor");
+        return 1;
+    }
+    std::string solicitud;
+    agregarSolicitud(solicitud, 0, TipoConsulta::Tamano, "");
+    CabeceraRespuesta cabecera;
+    std::string cuerpo;
+    if (!escribirTodo(fd, solicitud.data(), solicitud.size()) || !leerRespuesta(fd, cabecera, cuerpo)) {
+        std::cerr << "Error: el servidor no respondió\n";
+        close(fd);
+        return 1;
+    }
+    close(fd);
+    unsigned long long personas = 0, primerID = 0;
+    std::sscanf(cuerpo.c_str(), "%llu %llu", &personas, &primerID);
+    if (personas == 0) {
+        std::cerr << "Error: el servidor no tiene datos\n";
+        return 1;
+    }
+
+    std::vector<ResultadoConexion> resultados(conexiones);
+    std::vector<std::thread> hilos;
+    auto inicio = Reloj::now();
+
+    for (int c = 0; c < conexiones; ++c) {
+        hilos.emplace_back([&, c]() {
+            ResultadoConexion& r = resultados[c];
+            r.latencias.reserve(porConexion);
+            int conexion = conectar(ruta);
+            if (conexion < 0) {
+                r.errores = porConexion;
+                return;
+            }
+            std::mt19937_64 azar(12345 + c);
+            std::uniform_int_distribution<unsigned long long> cedula(primerID, primerID + personas - 1);
+            std::uniform_int_distribution<int> dado(0, 99);
+            std::string lote;
+            std::string respuesta;
+
+            for (long enviadas = 0; enviadas < porConexion; ) {
+                int enEsteLote = static_cast<int>(std::min<long>(profundidad, porConexion - enviadas));
+                lote.clear();
+                for (int i = 0; i < enEsteLote; ++i) {
+                    std::string tipo = mezcla;
+                    if (mezcla == "mixta") {
+                        int d = dado(azar);
+                        tipo = d < 70 ? "id" : d < 80 ? "rango" : d < 90 ? "percentil" : "ciudad";
+                    }
+                    uint32_t id = static_cast<uint32_t>(enviadas + i);
+                    if (tipo == "id") {
+                        agregarSolicitud(lote, id, TipoConsulta::BuscarID, std::to_string(cedula(azar)));
+                    } else if (tipo == "rango") {
+                        agregarSolicitud(lote, id, TipoConsulta::RangoPatrimonio, std::to_string(cedula(azar)));
+                    } else if (tipo == "percentil") {
+                        agregarSolicitud(lote, id, TipoConsulta::PercentilPatrimonio, std::to_string(dado(azar)));
+                    } else if (tipo == "ciudad") {
+                        agregarSolicitud(lote, id, TipoConsulta::ContarCiudad, CIUDADES[dado(azar) % 10]);
+                    } else {
+                        agregarSolicitud(lote, id, TipoConsulta::PatrimonioPais, "");
+                    }
+                }
+
+                auto envio = Reloj::now();
+                if (!escribirTodo(conexion, lote.data(), lote.size())) {
+                    r.errores += porConexion - enviadas;
+                    break;
+                }
+                for (int i = 0; i < enEsteLote; ++i) {
+                    CabeceraRespuesta cab;
+                    if (!leerRespuesta(conexion, cab, respuesta)) {
+                        r.errores += enEsteLote - i;
+                        enviadas = porConexion;
+                        break;
+                    }
+                    std::chrono::duration<double, std::micro> latencia = Reloj::now() - envio;
+                    r.latencias.push_back(latencia.count());
+                    if (cab.estado == static_cast<uint16_t>(EstadoRespuesta::NoEncontrado)) {
+                        ++r.noEncontradas;
+                    } else if (cab.estado != static_cast<uint16_t>(EstadoRespuesta::Ok)) {
+                        ++r.errores;
+                    }
+                }
+                enviadas += enEsteLote;
+            }
+            close(conexion);
+        });
+    }
+    for (auto& h : hilos) {
+        h.join();
+    }
+    std::chrono::duration<double> duracion = Reloj::now() - inicio;
+
+    std::vector<double> latencias;
+    size_t noEncontradas = 0, errores = 0;
+    for (const auto& r : resultados) {
+        latencias.insert(latencias.end(), r.latencias.begin(), r.latencias.end());
+        noEncontradas += r.noEncontradas;
+        errores += r.errores;
+    }
+    std::sort(latencias.begin(), latencias.end());
+    auto percentil = [&](double p) {
+        if (latencias.empty()) {
+            return 0.0;
+        }
+        size_t pos = static_cast<size_t>(p / 100.0 * (latencias.size() - 1) + 0.5);
+        return latencias[pos];
+    };
+
+    std::cout << "=== CARGA: " << mezcla << " ===\n";
+    std::cout << "Conexiones: " << conexiones << ", profundidad de pipeline: " << profundidad
+              << ", conjunto de " << personas << " personas\n";
+    std::cout << "Respuestas: " << latencias.size() << " en " << std::fixed << std::setprecision(3)
+              << duracion.count() << " s (" << std::setprecision(0)
+              << latencias.size() / duracion.count() << " consultas/s)\n";
+    std::cout << "No encontradas: " << noEncontradas << ", errores: " << errores << "\n";
+    std::cout << std::setprecision(1) << "Latencia (us): p50 " << percentil(50) << ", p90 " << percentil(90)
+              << ", p99 " << percentil(99) << ", p99.9 " << percentil(99.9)
+              << ", máx " << (latencias.empty() ? 0.0 : latencias.back()) << "\n";
+
+    if (apagar) {
+        int control = conectar(ruta);
+        if (control >= 0) {
+            std::string orden;
+            agregarSolicitud(orden, 0, TipoConsulta::Apagar, "");
+            if (escribirTodo(control, orden.data(), orden.size())) {
+                leerRespuesta(control, cabecera, cuerpo);
+            }
+            close(control);
+        }
+    }
+    return errores == 0 ? 0 : 1;
+}
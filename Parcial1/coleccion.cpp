@@ -0,0 +1,62 @@
+#include "coleccion.h"
+
+/**
+ * Implementación del constructor a partir de un vector.
+ *
+ * POR QUÉ: Convertir el resultado de generarColeccion() en un buffer compartido.
+ * CÓMO: make_shared reserva el bloque de control (contador atómico) y el buffer juntos.
+ * PARA QUÉ: Una sola asignación de memoria para el manejador.
+ */
+ColeccionPersonas::ColeccionPersonas(std::vector<Persona> personas,
+                                     std::shared_ptr<const ArenaCadenas> arena)
+    : buffer(std::make_shared<Buffer>()) {
+    buffer->personas = std::move(personas);
+    if (arena) {
+        buffer->arenas.push_back(std::move(arena));
+    }
+}
+
+/**
+ * Implementación de datos.
+ *
+ * POR QUÉ: Las consultas por referencia necesitan un vector válido aun sin datos.
+ * CÓMO: Retornando un vector vacío estático cuando no hay buffer.
+ * PARA QUÉ: Evitar desreferenciar un puntero nulo.
+ */
+const std::vector<Persona>& ColeccionPersonas::datos() const {
+    static const std::vector<Persona> vacio;
+    return buffer ? buffer->personas : vacio;
+}
+
+/**
+ * Implementación de modificar (copia en escritura).
+ *
+ * POR QUÉ: Solo se debe pagar la copia profunda cuando realmente hay escritura.
+ * CÓMO: use_count() > 1 significa que otro manejador observa el mismo buffer,
+ *       así que se clona antes de entregar la referencia mutable.
+ * PARA QUÉ: Mantener la semántica de valor entre copias del manejador.
+ */
+std::vector<Persona>& ColeccionPersonas::modificar() {
+    if (!buffer) {
+        buffer = std::make_shared<Buffer>();
+    } else if (buffer.use_count() > 1) {
+        buffer = std::make_shared<Buffer>(*buffer);
+    }
+    return buffer->personas;
+}
+
+void ColeccionPersonas::adjuntarArena(std::shared_ptr<const ArenaCadenas> arena) {
+    modificar(); // Garantiza que el buffer es propio antes de tocar la lista de arenas
+    buffer->arenas.push_back(std::move(arena));
+}
+
+size_t ColeccionPersonas::bytesTotales() const {
+    if (!buffer) {
+        return 0;
+    }
+    size_t bytes = buffer->personas.capacity() * sizeof(Persona);
+    for (const auto& arena : buffer->arenas) {
+        bytes += arena->bytesReservados();
+    }
+    return bytes;
+}
@@ -0,0 +1,104 @@
+#ifndef COLECCION_H
+#define COLECCION_H
+
+#include "persona.h"
+#include "arena.h"
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/**
+ * Manejador con copia-en-escritura (copy-on-write) de un conjunto de personas.
+ *
+ * POR QUÉ: Las funciones *Valor reciben la colección por valor para demostrar
+ *          esa semántica, pero copiar millones de Persona en cada llamada es costoso.
+ * CÓMO: Todas las copias del manejador comparten un mismo buffer inmutable a través
+ *       de std::shared_ptr, cuyo contador de referencias es atómico. Copiar el
+ *       manejador solo incrementa ese contador; el buffer se duplica únicamente
+ *       cuando alguien pide modificarlo mientras otra copia lo sigue usando.
+ * PARA QUÉ: Conservar la semántica de valor (ninguna copia ve los cambios de otra)
+ *           con costo O(1) por copia.
+ *
+ * El buffer también es dueño de las arenas donde viven las cadenas de las personas
+ * (Persona solo guarda vistas). Mientras exista una copia del manejador, o una Persona
+ * obtenida de ella se use dentro de la vida de alguna copia, las cadenas son válidas.
+ */
+class ColeccionPersonas {
+public:
+    using const_iterator = std::vector<Persona>::const_iterator;
+
+    /**
+     * Crea una colección vacía (sin buffer asignado).
+     */
+    ColeccionPersonas() = default;
+
+    /**
+     * Toma posesión de un vector de personas y de la arena que guarda sus cadenas.
+     *
+     * POR QUÉ: generarColeccion() produce las personas y sus textos por separado.
+     * CÓMO: Moviendo el vector al buffer compartido (sin copiar personas) y guardando
+     *       la arena junto a él. La arena puede ser nula si todas las vistas apuntan a
+     *       memoria estática.
+     * PARA QUÉ: Publicar un conjunto recién generado como colección compartible.
+     */
+    explicit ColeccionPersonas(std::vector<Persona> personas,
+                               std::shared_ptr<const ArenaCadenas> arena = nullptr);
+
+    // Acceso de solo lectura: nunca dispara una copia del buffer
+    size_t size() const { return buffer ? buffer->personas.size() : 0; }
+    bool empty() const { return !buffer || buffer->personas.empty(); }
+    const Persona& operator[](size_t i) const { return buffer->personas[i]; }
+    const_iterator begin() const { return datos().begin(); }
+    const_iterator end() const { return datos().end(); }
+
+    /**
+     * Devuelve el vector subyacente para las funciones que trabajan por referencia.
+     *
+     * POR QUÉ: Las funciones por apuntador reciben const std::vector<Persona>&.
+     * CÓMO: Retornando el buffer compartido (o un vector vacío estático si no hay datos).
+     * PARA QUÉ: Reutilizar las consultas existentes sin duplicar código.
+     */
+    const std::vector<Persona>& datos() const;
+
+    /**
+     * Obtiene acceso de escritura al buffer, copiándolo solo si está compartido.
+     *
+     * POR QUÉ: Un cambio no debe ser visible para las demás copias del manejador.
+     * CÓMO: Si el contador de referencias es mayor que 1, se clona el vector y este
+     *       manejador pasa a ser el único dueño de la copia. Las arenas no se clonan:
+     *       su contenido es inmutable y se comparte.
+     * PARA QUÉ: Implementar la "copia perezosa" de copy-on-write.
+     * @return Referencia mutable al vector propio de este manejador.
+     */
+    std::vector<Persona>& modificar();
+
+    /**
+     * Agrega una arena a la colección (p. ej. con las cadenas de personas añadidas
+     * mediante modificar()). Aplica la misma copia-en-escritura que modificar().
+     */
+    void adjuntarArena(std::shared_ptr<const ArenaCadenas> arena);
+
+    /**
+     * Número de manejadores que comparten actualmente el buffer.
+     *
+     * POR QUÉ: Permite observar en el menú que copiar no duplica los datos.
+     * CÓMO: Consultando use_count() del shared_ptr.
+     * PARA QUÉ: Diagnóstico y demostración de la semántica COW.
+     */
+    long referencias() const { return buffer.use_count(); }
+
+    // Bytes ocupados: objetos Persona (capacidad del vector) + bloques de las arenas
+    size_t bytesTotales() const;
+
+private:
+    struct Buffer {
+        std::vector<Persona> personas;
+        std::vector<std::shared_ptr<const ArenaCadenas>> arenas; // Dueñas de las cadenas
+    };
+
+    // Buffer compartido. Se guarda como no-const solo para que modificar() pueda
+    // escribir sobre él cuando este manejador es su único dueño.
+    std::shared_ptr<Buffer> buffer;
+};
+
+#endif // COLECCION_H
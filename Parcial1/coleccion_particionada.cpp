@@ -0,0 +1,118 @@
+#include "coleccion_particionada.h"
+#include "generador.h"
+#include <memory>
+
+size_t ColeccionParticionada::size() const {
+    size_t total = 0;
+    for (const auto& parte : partes) {
+        total += parte.personas.size();
+    }
+    return total;
+}
+
+namespace {
+    // Genera una partición completa desde el hilo llamador, que se fija al nodo
+    ParticionNodo generarParticion(int nodo, size_t n) {
+        ParticionNodo parte;
+        parte.nodo = nodo;
+        parte.fijada = fijarHiloEnNodo(nodo);
+        auto inicio = std::chrono::high_resolution_clock::now();
+
+        // El vector se construye (y sus páginas se tocan) desde este hilo ya fijado
+        std::vector<Persona> datos(n);
+        parte.hilos = hilosParaTamano(n, hilosPorNodo(nodo));
+        std::vector<std::shared_ptr<ArenaCadenas>> arenas(parte.hilos);
+
+        ejecutarPorBloques(n, [&](unsigned h, size_t desde, size_t hasta) {
+            arenas[h] = std::make_shared<ArenaCadenas>();
+            for (size_t i = desde; i < hasta; ++i) {
+                datos[i] = generarPersona(*arenas[h]);
+            }
+        }, parte.hilos);
+
+        parte.personas = ColeccionPersonas(std::move(datos), arenas[0]);
+        for (size_t h = 1; h < arenas.size(); ++h) {
+            parte.personas.adjuntarArena(arenas[h]);
+        }
+
+        std::chrono::duration<double, std::milli> duracion =
+            std::chrono::high_resolution_clock::now() - inicio;
+        parte.tiempoGeneracion = duracion.count();
+        return parte;
+    }
+}
+
+ColeccionParticionada generarColeccionParticionada(size_t n) {
+    const std::vector<int> nodos = nodosNUMA();
+    std::vector<ParticionNodo> partes(nodos.size());
+    std::vector<std::thread> coordinadores;
+
+    size_t base = n / nodos.size();
+    size_t resto = n % nodos.size();
+    for (size_t p = 0; p < nodos.size(); ++p) {
+        size_t cantidad = base + (p < resto ? 1 : 0);
+        int nodo = nodos[p];
+        coordinadores.emplace_back([&partes, p, nodo, cantidad]() {
+            partes[p] = generarParticion(nodo, cantidad);
+        });
+    }
+    for (auto& c : coordinadores) {
+        c.join();
+    }
+    return ColeccionParticionada(std::move(partes));
+}
+
+void AgregadoCiudad::agregar(const Persona& p) {
+    ++personas;
+    if (p.getDeclaranteRenta()) {
+        ++declarantes;
+    }
+    patrimonioTotal += p.getPatrimonio();
+    if (p.getPatrimonio() > patrimonioMaximo) {
+        patrimonioMaximo = p.getPatrimonio();
+        masRica = &p;
+    }
+    int fecha = p.claveFechaNacimiento();
+    if (fecha < fechaMasAntigua) {
+        fechaMasAntigua = fecha;
+        masLongeva = &p;
+    }
+}
+
+void AgregadoCiudad::combinar(const AgregadoCiudad& otro) {
+    personas += otro.personas;
+    declarantes += otro.declarantes;
+    patrimonioTotal += otro.patrimonioTotal;
+    if (otro.patrimonioMaximo > patrimonioMaximo) {
+        patrimonioMaximo = otro.patrimonioMaximo;
+        masRica = otro.masRica;
+    }
+    if (otro.fechaMasAntigua < fechaMasAntigua) {
+        fechaMasAntigua = otro.fechaMasAntigua;
+        masLongeva = otro.masLongeva;
+    }
+}
+
+ResumenCiudades resumirPorCiudad(const ColeccionParticionada& conjunto,
+                                 std::vector<double>& tiemposParticion) {
+    return agregarPorNodo(conjunto, ResumenCiudades(),
+        [](ResumenCiudades& parcial, const Persona& p) {
+            parcial[p.getCiudadNacimiento()].agregar(p);
+        },
+        [](ResumenCiudades& destino, const ResumenCiudades& origen) {
+            for (const auto& [ciudad, agregado] : origen) {
+                destino[ciudad].combinar(agregado);
+            }
+        },
+        tiemposParticion);
+}
+
+ResumenCiudades resumirPorCiudadSecuencial(const ColeccionParticionada& conjunto) {
+    ResumenCiudades resumen;
+    for (const auto& parte : conjunto.particiones()) {
+        for (const auto& p : parte.personas) {
+            resumen[p.getCiudadNacimiento()].agregar(p);
+        }
+    }
+    return resumen;
+}
@@ -0,0 +1,148 @@
+#ifndef COLECCION_PARTICIONADA_H
+#define COLECCION_PARTICIONADA_H
+
+#include "coleccion.h"
+#include "nodos_numa.h"
+#include "paralelo.h"
+#include <vector>
+#include <map>
+#include <string_view>
+#include <thread>
+#include <chrono>
+#include <limits>
+
+/**
+ * Trozo del conjunto que vive en un nodo NUMA.
+ */
+struct ParticionNodo {
+    int nodo = 0;
+    bool fijada = false;          // El hilo generador quedó fijado al nodo (false sin NUMA)
+    unsigned hilos = 1;           // Hilos que generaron (y recorren) la partición
+    ColeccionPersonas personas;   // Personas y arenas reservadas desde el nodo
+    double tiempoGeneracion = 0;  // ms
+};
+
+/**
+ * Conjunto de personas repartido en una partición por nodo NUMA.
+ *
+ * POR QUÉ: ColeccionPersonas es un único vector llenado por un solo hilo, así que
+ *          todas sus páginas quedan en el nodo de ese hilo.
+ * CÓMO: Cada partición la reserva y la genera un hilo fijado a su nodo (las páginas
+ *       se asignan en el primer acceso, que ocurre desde ese nodo). Las consultas
+ *       también se ejecutan con hilos fijados: agregan localmente y solo los parciales
+ *       (pequeños) cruzan al hilo principal para la combinación final.
+ * PARA QUÉ: Recorridos paralelos que leen memoria local en máquinas de varios sockets.
+ */
+class ColeccionParticionada {
+public:
+    ColeccionParticionada() = default;
+    explicit ColeccionParticionada(std::vector<ParticionNodo> particiones)
+        : partes(std::move(particiones)) {}
+
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    const std::vector<ParticionNodo>& particiones() const { return partes; }
+
+private:
+    std::vector<ParticionNodo> partes;
+};
+
+/**
+ * Genera n personas repartidas en partes iguales entre los nodos NUMA.
+ *
+ * POR QUÉ: El primer acceso decide el nodo de cada página.
+ * CÓMO: Un hilo coordinador por nodo se fija a él, crea el vector (tocándolo) y
+ *       reparte la generación entre hilosPorNodo() hilos, que heredan la afinidad y
+ *       la política de memoria del coordinador. Cada hilo usa su propia arena.
+ * PARA QUÉ: Que cada partición quede completa en la memoria de su nodo.
+ */
+ColeccionParticionada generarColeccionParticionada(size_t n);
+
+/**
+ * Ejecuta una agregación con parciales locales por nodo y una combinación final.
+ *
+ * POR QUÉ: Plantilla común para cualquier consulta que se pueda expresar como
+ *          acumular(parcial, persona) y combinar(parcial, otroParcial).
+ * CÓMO: Un coordinador fijado por partición divide su rango con ejecutarPorBloques
+ *       (los hilos creados heredan la afinidad), combina los parciales de sus hilos y
+ *       mide su tiempo. El hilo llamador combina los parciales de todos los nodos.
+ * PARA QUÉ: Reutilizar el mismo esquema para resúmenes por ciudad, calendario, etc.
+ * @param tiemposParticion Recibe el tiempo (ms) de cada partición, en su orden.
+ */
+template <typename Parcial, typename Acumular, typename Combinar>
+Parcial agregarPorNodo(const ColeccionParticionada& conjunto, const Parcial& vacio,
+                       Acumular acumular, Combinar combinar,
+                       std::vector<double>& tiemposParticion) {
+    const auto& partes = conjunto.particiones();
+    std::vector<Parcial> porNodo(partes.size(), vacio);
+    tiemposParticion.assign(partes.size(), 0.0);
+
+    std::vector<std::thread> coordinadores;
+    for (size_t p = 0; p < partes.size(); ++p) {
+        coordinadores.emplace_back([&, p]() {
+            const ParticionNodo& parte = partes[p];
+            fijarHiloEnNodo(parte.nodo);
+            auto inicio = std::chrono::high_resolution_clock::now();
+
+            const std::vector<Persona>& datos = parte.personas.datos();
+            unsigned hilos = hilosParaTamano(datos.size(), hilosPorNodo(parte.nodo));
+            std::vector<Parcial> parciales(hilos, vacio);
+            ejecutarPorBloques(datos.size(), [&](unsigned h, size_t desde, size_t hasta) {
+                for (size_t i = desde; i < hasta; ++i) {
+                    acumular(parciales[h], datos[i]);
+                }
+            }, hilos);
+
+            for (unsigned h = 1; h < hilos; ++h) {
+                combinar(parciales[0], parciales[h]);
+            }
+            porNodo[p] = std::move(parciales[0]);
+
+            std::chrono::duration<double, std::milli> duracion =
+                std::chrono::high_resolution_clock::now() - inicio;
+            tiemposParticion[p] = duracion.count();
+        });
+    }
+    for (auto& c : coordinadores) {
+        c.join();
+    }
+
+    Parcial total = vacio;
+    for (const auto& parcial : porNodo) {
+        combinar(total, parcial);
+    }
+    return total;
+}
+
+/**
+ * Agregados de una ciudad para el resumen particionado.
+ */
+struct AgregadoCiudad {
+    size_t personas = 0;
+    size_t declarantes = 0;
+    double patrimonioTotal = 0.0;
+    double patrimonioMaximo = -std::numeric_limits<double>::infinity();
+    int fechaMasAntigua = std::numeric_limits<int>::max(); // Clave AAAAMMDD
+    const Persona* masRica = nullptr;
+    const Persona* masLongeva = nullptr;
+
+    void agregar(const Persona& p);
+    void combinar(const AgregadoCiudad& otro);
+};
+
+using ResumenCiudades = std::map<std::string_view, AgregadoCiudad>;
+
+/**
+ * Resumen por ciudad (conteo, declarantes, patrimonio total y máximo, más longeva).
+ *
+ * POR QUÉ: Es la consulta agregada que más recorre el conjunto completo.
+ * CÓMO: agregarPorNodo con un mapa ciudad -> AgregadoCiudad por hilo.
+ * PARA QUÉ: Comparar el recorrido local por nodo con uno de un solo hilo.
+ */
+ResumenCiudades resumirPorCiudad(const ColeccionParticionada& conjunto,
+                                 std::vector<double>& tiemposParticion);
+
+// Misma consulta recorriendo todas las particiones desde el hilo llamador (referencia)
+ResumenCiudades resumirPorCiudadSecuencial(const ColeccionParticionada& conjunto);
+
+#endif // COLECCION_PARTICIONADA_H
@@ -0,0 +1,364 @@
+#include "columnas_comprimidas.h"
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <charconv>
+#include <limits>
+
+namespace {
+    const uint64_t BIT_SIGNO = uint64_t{1} << 63;
+
+    // Centavos con signo -> entero sin signo que conserva el orden
+    uint64_t codificarDinero(double pesos) {
+        return static_cast<uint64_t>(std::llround(pesos * 100.0)) ^ BIT_SIGNO;
+    }
+
+    double decodificarDinero(uint64_t codigo) {
+        return static_cast<double>(static_cast<int64_t>(codigo ^ BIT_SIGNO)) / 100.0;
+    }
+
+    // Día ordinal que conserva el orden cronológico (meses de 31 días)
+    uint64_t codificarFecha(int dia, int mes, int anio) {
+        return static_cast<uint64_t>(anio) * 372 + (mes - 1) * 31 + (dia - 1);
+    }
+
+    uint64_t zigzag(uint64_t diferencia) {
+        int64_t d = static_cast<int64_t>(diferencia);
+        return (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+    }
+
+    uint64_t deshacerZigzag(uint64_t valor) {
+        return (valor >> 1) ^ (~(valor & 1) + 1);
+    }
+
+    unsigned bitsNecesarios(uint64_t valor) {
+        unsigned bits = 0;
+        while (valor) {
+            ++bits;
+            valor >>= 1;
+        }
+        return bits;
+    }
+
+    uint64_t mascara(unsigned ancho) {
+        return ancho >= 64 ? ~uint64_t{0} : (uint64_t{1} << ancho) - 1;
+    }
+
+    // Cédula puramente numérica sin ceros a la izquierda (cabe en 64 bits hasta 19 dígitos)
+    bool idNumerico(std::string_view id, uint64_t& valor) {
+        if (id.empty() || id.size() > 19 || (id.size() > 1 && id[0] == '0')) {
+            return false;
+        }
+        auto [fin, error] = std::from_chars(id.data(), id.data() + id.size(), valor);
+        return error == std::errc() && fin == id.data() + id.size();
+    }
+}
+
+/**
+ * Implementación del constructor de ColumnaEmpaquetada.
+ *
+ * POR QUÉ: Ver columnas_comprimidas.h.
+ * CÓMO: Por bloque: se codifican los valores (resta del mínimo o zigzag de la
+ *       diferencia), el ancho es el del mayor código y los códigos se escriben uno
+ *       tras otro sin alinear, cruzando palabras de 64 bits cuando hace falta.
+ * PARA QUÉ: Que cada bloque use solo los bits que sus propios valores necesitan.
+ */
+ColumnaEmpaquetada::ColumnaEmpaquetada(const std::vector<uint64_t>& valores, Codificacion tipo)
+    : n(valores.size()), codificacion(tipo) {
+    uint64_t codigos[BLOQUE];
+    for (size_t inicio = 0; inicio < n; inicio += BLOQUE) {
+        size_t cuenta = std::min(BLOQUE, n - inicio);
+        const uint64_t* v = valores.data() + inicio;
+
+        Cabecera cabecera{v[0], v[0], v[0], static_cast<uint32_t>(palabras.size()), 0};
+        for (size_t k = 0; k < cuenta; ++k) {
+            cabecera.minimo = std::min(cabecera.minimo, v[k]);
+            cabecera.maximo = std::max(cabecera.maximo, v[k]);
+        }
+        uint64_t mayorCodigo = 0;
+        for (size_t k = 0; k < cuenta; ++k) {
+            codigos[k] = tipo == Codificacion::Delta ? (k ? zigzag(v[k] - v[k - 1]) : 0)
+                                                     : v[k] - cabecera.minimo;
+            mayorCodigo = std::max(mayorCodigo, codigos[k]);
+        }
+        cabecera.ancho = static_cast<uint8_t>(bitsNecesarios(mayorCodigo));
+
+        palabras.resize(palabras.size() + (cuenta * cabecera.ancho + 63) / 64, 0);
+        uint64_t* destino = palabras.data() + cabecera.palabra;
+        for (size_t k = 0; k < cuenta && cabecera.ancho > 0; ++k) {
+            size_t bit = k * cabecera.ancho;
+            unsigned desplazamiento = bit % 64;
+            destino[bit / 64] |= codigos[k] << desplazamiento;
+            if (desplazamiento + cabecera.ancho > 64) {
+                destino[bit / 64 + 1] |= codigos[k] >> (64 - desplazamiento);
+            }
+        }
+        cabeceras.push_back(cabecera);
+    }
+    palabras.shrink_to_fit();
+}
+
+size_t ColumnaEmpaquetada::decodificar(size_t b, uint64_t* salida) const {
+    const Cabecera& cabecera = cabeceras[b];
+    size_t cuenta = tamanoBloque(b);
+    const uint64_t* origen = palabras.data() + cabecera.palabra;
+    const unsigned ancho = cabecera.ancho;
+    const uint64_t m = mascara(ancho);
+
+    for (size_t k = 0; k < cuenta; ++k) {
+        uint64_t codigo = 0;
+        if (ancho > 0) {
+            size_t bit = k * ancho;
+            unsigned desplazamiento = bit % 64;
+            codigo = origen[bit / 64] >> desplazamiento;
+            if (desplazamiento + ancho > 64) {
+                codigo |= origen[bit / 64 + 1] << (64 - desplazamiento);
+            }
+            codigo &= m;
+        }
+        salida[k] = codigo;
+    }
+
+    if (codificacion == Codificacion::Delta) {
+        salida[0] = cabecera.primero;
+        for (size_t k = 1; k < cuenta; ++k) {
+            salida[k] = salida[k - 1] + deshacerZigzag(salida[k]);
+        }
+    } else {
+        for (size_t k = 0; k < cuenta; ++k) {
+            salida[k] += cabecera.minimo;
+        }
+    }
+    return cuenta;
+}
+
+uint64_t ColumnaEmpaquetada::operator[](size_t i) const {
+    uint64_t bloque[BLOQUE];
+    decodificar(i / BLOQUE, bloque);
+    return bloque[i % BLOQUE];
+}
+
+size_t ColumnaEmpaquetada::bytes() const {
+    return cabeceras.capacity() * sizeof(Cabecera) + palabras.capacity() * sizeof(uint64_t);
+}
+
+/**
+ * Implementación del constructor de ColeccionComprimida.
+ *
+ * POR QUÉ: Los datos se generan como Persona.
+ * CÓMO: Una pasada llena un vector temporal por columna (ciudades internadas en una
+ *       tabla hash local) y luego cada columna se empaqueta por separado.
+ * PARA QUÉ: Que la representación comprimida sea solo otra vista del mismo conjunto.
+ */
+ColeccionComprimida::ColeccionComprimida(const std::vector<Persona>& personas) {
+    const size_t n = personas.size();
+    std::unordered_map<std::string_view, uint64_t> codigos;
+    std::vector<uint64_t> columnaIds(n), columnaFechas(n), columnaCiudades(n), columnaCalendarios(n),
+                          columnaDeclarantes(n), columnaNombres[3], columnaDinero[3];
+    for (int c = 0; c < 3; ++c) {
+        columnaNombres[c].resize(n);
+        columnaDinero[c].resize(n);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        const Persona& p = personas[i];
+        if (!idNumerico(p.getId(), columnaIds[i])) {
+            columnaIds[i] = 0;
+            idsExcepcionales[i] = std::string(p.getId());
+        }
+
+        int dia, mes, anio;
+        p.obtenerFechaNacimiento(dia, mes, anio);
+        columnaFechas[i] = codificarFecha(dia, mes, anio);
+
+        auto [it, nueva] = codigos.emplace(p.getCiudadNacimiento(), ciudades.size());
+        if (nueva) {
+            ciudades.emplace_back(p.getCiudadNacimiento());
+        }
+        columnaCiudades[i] = it->second;
+        columnaCalendarios[i] = static_cast<uint64_t>(std::clamp(p.getCalendarioTributario() - 'A', 0, 2));
+        columnaDeclarantes[i] = p.getDeclaranteRenta() ? 1 : 0;
+
+        columnaNombres[0][i] = p.getIndiceNombre();
+        columnaNombres[1][i] = p.getIndicePrimerApellido();
+        columnaNombres[2][i] = p.getIndiceSegundoApellido();
+        columnaDinero[static_cast<int>(CampoFinanciero::Patrimonio)][i] = codificarDinero(p.getPatrimonio());
+        columnaDinero[static_cast<int>(CampoFinanciero::Ingresos)][i] = codificarDinero(p.getIngresosAnuales());
+        columnaDinero[static_cast<int>(CampoFinanciero::Deudas)][i] = codificarDinero(p.getDeudas());
+    }
+
+    using C = ColumnaEmpaquetada::Codificacion;
+    ids = ColumnaEmpaquetada(columnaIds, C::Delta);
+    fechas = ColumnaEmpaquetada(columnaFechas, C::Referencia);
+    codigosCiudad = ColumnaEmpaquetada(columnaCiudades, C::Referencia);
+    calendarios = ColumnaEmpaquetada(columnaCalendarios, C::Referencia);
+    declarantes = ColumnaEmpaquetada(columnaDeclarantes, C::Referencia);
+    for (int c = 0; c < 3; ++c) {
+        nombres[c] = ColumnaEmpaquetada(columnaNombres[c], C::Referencia);
+        dinero[c] = ColumnaEmpaquetada(columnaDinero[c], C::Referencia);
+    }
+}
+
+std::string ColeccionComprimida::id(size_t i) const {
+    auto it = idsExcepcionales.find(i);
+    return it != idsExcepcionales.end() ? it->second : std::to_string(ids[i]);
+}
+
+Persona ColeccionComprimida::aPersona(size_t i, ArenaCadenas& arena) const {
+    uint64_t fecha = fechas[i];
+    char* texto = arena.reservar(10);
+    size_t largo = escribirFecha(texto, static_cast<int>(fecha % 31 + 1), static_cast<int>(fecha % 372 / 31 + 1),
+                                 static_cast<int>(fecha / 372));
+    return Persona(static_cast<uint8_t>(nombres[0][i]), static_cast<uint8_t>(nombres[1][i]),
+                   static_cast<uint8_t>(nombres[2][i]), arena.guardar(id(i)), arena.guardar(ciudad(i)),
+                   std::string_view(texto, largo),
+                   decodificarDinero(dinero[static_cast<int>(CampoFinanciero::Ingresos)][i]),
+                   decodificarDinero(dinero[static_cast<int>(CampoFinanciero::Patrimonio)][i]),
+                   decodificarDinero(dinero[static_cast<int>(CampoFinanciero::Deudas)][i]),
+                   declarantes[i] != 0);
+}
+
+/**
+ * Implementación de mayor.
+ *
+ * POR QUÉ: Es el escaneo más frecuente (mayor patrimonio, más deudas...).
+ * CÓMO: Los códigos de dinero conservan el orden, así que se comparan sin pasar a
+ *       pesos. Un bloque cuyo máximo no supera al mejor actual no puede cambiar el
+ *       resultado (en empate gana la posición anterior) y no se desempaqueta.
+ * PARA QUÉ: En datos aleatorios, tras los primeros bloques casi todos se descartan.
+ */
+size_t ColeccionComprimida::mayor(CampoFinanciero campo) const {
+    const ColumnaEmpaquetada& columna = dinero[static_cast<int>(campo)];
+    uint64_t valores[ColumnaEmpaquetada::BLOQUE];
+    size_t mejor = size();
+    uint64_t mejorValor = 0;
+    for (size_t b = 0; b < columna.bloques(); ++b) {
+        if (mejor != size() && columna.maximo(b) <= mejorValor) {
+            continue;
+        }
+        size_t cuenta = columna.decodificar(b, valores);
+        for (size_t k = 0; k < cuenta; ++k) {
+            if (mejor == size() || valores[k] > mejorValor) {
+                mejor = b * ColumnaEmpaquetada::BLOQUE + k;
+                mejorValor = valores[k];
+            }
+        }
+    }
+    return mejor;
+}
+
+// Igual que mayor(), con el mínimo del bloque sobre la columna de fechas
+size_t ColeccionComprimida::masLongeva() const {
+    uint64_t valores[ColumnaEmpaquetada::BLOQUE];
+    size_t mejor = size();
+    uint64_t mejorValor = 0;
+    for (size_t b = 0; b < fechas.bloques(); ++b) {
+        if (mejor != size() && fechas.minimo(b) >= mejorValor) {
+            continue;
+        }
+        size_t cuenta = fechas.decodificar(b, valores);
+        for (size_t k = 0; k < cuenta; ++k) {
+            if (mejor == size() || valores[k] < mejorValor) {
+                mejor = b * ColumnaEmpaquetada::BLOQUE + k;
+                mejorValor = valores[k];
+            }
+        }
+    }
+    return mejor;
+}
+
+// Solo se desempaquetan los bloques cuyo rango de cédulas contiene la buscada
+size_t ColeccionComprimida::buscarPorID(std::string_view buscado) const {
+    uint64_t objetivo;
+    if (!idNumerico(buscado, objetivo)) {
+        for (const auto& [posicion, id] : idsExcepcionales) {
+            if (id == buscado) {
+                return posicion;
+            }
+        }
+        return size();
+    }
+    uint64_t valores[ColumnaEmpaquetada::BLOQUE];
+    for (size_t b = 0; b < ids.bloques(); ++b) {
+        if (objetivo < ids.minimo(b) || objetivo > ids.maximo(b)) {
+            continue;
+        }
+        size_t cuenta = ids.decodificar(b, valores);
+        for (size_t k = 0; k < cuenta; ++k) {
+            size_t posicion = b * ColumnaEmpaquetada::BLOQUE + k;
+            if (valores[k] == objetivo && !idsExcepcionales.count(posicion)) {
+                return posicion;
+            }
+        }
+    }
+    return size();
+}
+
+// Bloques sin el código se saltan; bloques con un solo código se cuentan completos
+size_t ColeccionComprimida::contarCiudad(std::string_view nombre) const {
+    auto it = std::find(ciudades.begin(), ciudades.end(), nombre);
+    if (it == ciudades.end()) {
+        return 0;
+    }
+    const uint64_t codigo = static_cast<uint64_t>(it - ciudades.begin());
+    uint64_t valores[ColumnaEmpaquetada::BLOQUE];
+    size_t total = 0;
+    for (size_t b = 0; b < codigosCiudad.bloques(); ++b) {
+        if (codigo < codigosCiudad.minimo(b) || codigo > codigosCiudad.maximo(b)) {
+            continue;
+        }
+        if (codigosCiudad.minimo(b) == codigosCiudad.maximo(b)) {
+            total += codigosCiudad.tamanoBloque(b);
+            continue;
+        }
+        size_t cuenta = codigosCiudad.decodificar(b, valores);
+        for (size_t k = 0; k < cuenta; ++k) {
+            total += valores[k] == codigo;
+        }
+    }
+    return total;
+}
+
+std::array<size_t, 3> ColeccionComprimida::contarPorCalendario() const {
+    std::array<size_t, 3> conteo{};
+    uint64_t valores[ColumnaEmpaquetada::BLOQUE];
+    for (size_t b = 0; b < calendarios.bloques(); ++b) {
+        if (calendarios.minimo(b) == calendarios.maximo(b)) {
+            conteo[calendarios.minimo(b)] += calendarios.tamanoBloque(b);
+            continue;
+        }
+        size_t cuenta = calendarios.decodificar(b, valores);
+        for (size_t k = 0; k < cuenta; ++k) {
+            ++conteo[valores[k]];
+        }
+    }
+    return conteo;
+}
+
+std::map<std::string, const ColumnaEmpaquetada*> ColeccionComprimida::columnas() const {
+    return {{"cedula (delta)", &ids},
+            {"fecha", &fechas},
+            {"ciudad", &codigosCiudad},
+            {"calendario", &calendarios},
+            {"declarante", &declarantes},
+            {"nombre", &nombres[0]},
+            {"primer apellido", &nombres[1]},
+            {"segundo apellido", &nombres[2]},
+            {"patrimonio", &dinero[static_cast<int>(CampoFinanciero::Patrimonio)]},
+            {"ingresos", &dinero[static_cast<int>(CampoFinanciero::Ingresos)]},
+            {"deudas", &dinero[static_cast<int>(CampoFinanciero::Deudas)]}};
+}
+
+size_t ColeccionComprimida::bytesTotales() const {
+    size_t bytes = 0;
+    for (const auto& [nombre, columna] : columnas()) {
+        bytes += columna->bytes();
+    }
+    for (const auto& [posicion, id] : idsExcepcionales) {
+        bytes += sizeof(posicion) + id.capacity();
+    }
+    for (const auto& ciudad : ciudades) {
+        bytes += sizeof(std::string) + ciudad.capacity();
+    }
+    return bytes;
+}
@@ -0,0 +1,119 @@
+#ifndef COLUMNAS_COMPRIMIDAS_H
+#define COLUMNAS_COMPRIMIDAS_H
+
+#include "persona.h"
+#include "arena.h"
+#include "indice_valores.h" // CampoFinanciero
+#include <vector>
+#include <string>
+#include <string_view>
+#include <map>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * Columna de enteros sin signo empaquetada en bloques de 128 valores.
+ *
+ * POR QUÉ: Casi ninguna columna de Persona necesita 64 bits por valor: códigos de
+ *          ciudad de 5 bits, fechas dentro de 50 años, cédulas consecutivas.
+ * CÓMO: Cada bloque guarda su mínimo y su máximo y empaqueta sus valores con el menor
+ *       ancho de bits que los representa:
+ *         - Referencia (frame of reference): valor - mínimo del bloque.
+ *         - Delta: diferencia con el valor anterior en zigzag (para valores casi
+ *           ordenados, como las cédulas generadas en secuencia).
+ *       El mínimo y el máximo por bloque permiten descartar bloques enteros sin
+ *       desempaquetarlos.
+ * PARA QUÉ: Escanear columnas grandes leyendo pocos bits por fila.
+ */
+class ColumnaEmpaquetada {
+public:
+    static constexpr size_t BLOQUE = 128;
+    enum class Codificacion { Referencia, Delta };
+
+    ColumnaEmpaquetada() = default;
+    ColumnaEmpaquetada(const std::vector<uint64_t>& valores, Codificacion codificacion);
+
+    size_t size() const { return n; }
+    size_t bloques() const { return cabeceras.size(); }
+    size_t tamanoBloque(size_t b) const { return std::min(BLOQUE, n - b * BLOQUE); }
+    uint64_t minimo(size_t b) const { return cabeceras[b].minimo; }
+    uint64_t maximo(size_t b) const { return cabeceras[b].maximo; }
+
+    // Desempaqueta el bloque b en salida (hasta BLOQUE valores); devuelve cuántos escribió
+    size_t decodificar(size_t b, uint64_t* salida) const;
+    uint64_t operator[](size_t i) const;
+
+    size_t bytes() const;
+    double bitsPorValor() const { return n ? bytes() * 8.0 / n : 0.0; }
+
+private:
+    struct Cabecera {
+        uint64_t minimo;
+        uint64_t maximo;
+        uint64_t primero;  // Solo Delta: valor inicial del bloque
+        uint32_t palabra;  // Primera palabra de 64 bits del bloque en `palabras`
+        uint8_t ancho;     // Bits por valor empaquetado (0 a 64)
+    };
+
+    std::vector<Cabecera> cabeceras;
+    std::vector<uint64_t> palabras;
+    size_t n = 0;
+    Codificacion codificacion = Codificacion::Referencia;
+};
+
+/**
+ * Conjunto de personas en columnas comprimidas, con escaneos sobre los datos empaquetados.
+ *
+ * POR QUÉ: Con poblaciones grandes las consultas de recorrido están limitadas por la
+ *          memoria: cada Persona ocupa 80 bytes más sus textos, y una consulta de
+ *          patrimonio solo usa 8 de ellos.
+ * CÓMO: Una columna por atributo:
+ *         - cédula: delta + empaquetado (las excepciones no numéricas van aparte);
+ *         - fecha: día ordinal desde 1900 con referencia por bloque (las fechas no
+ *           llegan en orden, así que la diferencia con la anterior no ayuda);
+ *         - ciudad: código de diccionario; calendario, declarante e índices de nombre
+ *           como enteros pequeños;
+ *         - dinero: centavos con referencia por bloque.
+ *       Los escaneos desempaquetan un bloque de una columna a la vez (128 valores que
+ *       caben en L1) y saltan los bloques que por su mínimo/máximo no pueden cambiar
+ *       el resultado; nunca se arma una Persona salvo para mostrar el resultado.
+ * PARA QUÉ: Representación opcional que ocupa una fracción de la memoria y responde
+ *           las consultas de recorrido leyendo muchos menos bytes.
+ */
+class ColeccionComprimida {
+public:
+    ColeccionComprimida() = default;
+    explicit ColeccionComprimida(const std::vector<Persona>& personas);
+
+    size_t size() const { return fechas.size(); }
+
+    // Reconstruye la persona i; sus textos se copian a la arena dada
+    Persona aPersona(size_t i, ArenaCadenas& arena) const;
+    std::string id(size_t i) const;
+    const std::string& ciudad(size_t i) const { return ciudades[codigosCiudad[i]]; }
+
+    // Escaneos sobre las columnas; devuelven la posición o size() si no hay resultado
+    size_t mayor(CampoFinanciero campo) const;  // Primera con el mayor valor (como buscarPatrimonio)
+    size_t masLongeva() const;                  // Primera con la fecha más antigua
+    size_t buscarPorID(std::string_view id) const;
+    size_t contarCiudad(std::string_view ciudad) const;
+    std::array<size_t, 3> contarPorCalendario() const; // A, B, C
+
+    // Bytes por columna (para el reporte) y total
+    std::map<std::string, const ColumnaEmpaquetada*> columnas() const;
+    size_t bytesTotales() const;
+
+private:
+    ColumnaEmpaquetada ids;
+    std::map<size_t, std::string> idsExcepcionales; // IDs no numéricos (valor 0 en la columna)
+    ColumnaEmpaquetada fechas;
+    ColumnaEmpaquetada codigosCiudad;
+    ColumnaEmpaquetada calendarios;
+    ColumnaEmpaquetada declarantes;
+    ColumnaEmpaquetada nombres[3];    // Nombre, primer y segundo apellido
+    ColumnaEmpaquetada dinero[3];     // Indexadas por CampoFinanciero
+    std::vector<std::string> ciudades; // Código -> nombre
+};
+
+#endif // COLUMNAS_COMPRIMIDAS_H
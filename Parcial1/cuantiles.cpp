@@ -0,0 +1,238 @@
+#include "cuantiles.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <atomic>
+
+namespace {
+    std::atomic<uint64_t> contadorSemillas{0};
+
+    // splitmix64 sobre un contador: cada sketch nuevo recibe una semilla distinta y no nula
+    uint64_t nuevaSemilla() {
+        uint64_t z = (contadorSemillas.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return (z ^ (z >> 31)) | 1;
+    }
+
+    // Grupo del mapa, creado con sketches propios (no copias de uno vacío, que
+    // compartirían la semilla y con ella los errores de desfase)
+    template <typename Clave>
+    SketchesGrupo& grupoDe(std::map<Clave, SketchesGrupo>& mapa, const Clave& clave, int k) {
+        auto it = mapa.find(clave);
+        if (it == mapa.end()) {
+            it = mapa.emplace(clave, SketchesGrupo{SketchKLL(k), SketchKLL(k)}).first;
+        }
+        return it->second;
+    }
+}
+
+SketchKLL::SketchKLL(int k)
+    : k(std::max(8, k)), niveles(1), semilla(nuevaSemilla()) {
+    recalcularCapacidades();
+}
+
+/**
+ * Recalcula la capacidad de cada nivel (solo cambia cuando aparece un nivel nuevo).
+ *
+ * POR QUÉ: Los niveles altos (pesos grandes) necesitan más espacio que los bajos.
+ * CÓMO: k * (2/3)^(profundidad), donde la profundidad se mide desde el nivel más alto,
+ *       con un mínimo de 2 elementos. Se guarda en un arreglo para no evaluar pow()
+ *       en cada inserción.
+ * PARA QUÉ: Mantener el espacio total en O(k).
+ */
+void SketchKLL::recalcularCapacidades() {
+    capacidades.resize(niveles.size());
+    for (size_t nivel = 0; nivel < niveles.size(); ++nivel) {
+        size_t profundidad = niveles.size() - nivel - 1;
+        double cap = std::ceil(k * std::pow(2.0 / 3.0, static_cast<double>(profundidad)));
+        capacidades[nivel] = std::max<size_t>(2, static_cast<size_t>(cap));
+    }
+}
+
+size_t SketchKLL::retenidos() const {
+    size_t total = 0;
+    for (const auto& nivel : niveles) {
+        total += nivel.size();
+    }
+    return total;
+}
+
+void SketchKLL::agregar(double valor) {
+    niveles[0].push_back(valor);
+    ++n;
+    if (niveles[0].size() >= capacidades[0]) {
+        compactar();
+    }
+}
+
+/**
+ * Implementación de compactar.
+ *
+ * POR QUÉ: Liberar espacio cuando algún nivel excede su capacidad.
+ * CÓMO: Ordena el nivel lleno y promueve al siguiente los elementos de posición par o
+ *       impar (según un bit aleatorio); cada promovido pesa el doble, así que el peso
+ *       total se conserva. Si el nivel tiene un número impar, uno queda en su lugar.
+ * PARA QUÉ: Mantener la memoria acotada con error de rango controlado.
+ */
+void SketchKLL::compactar() {
+    for (size_t h = 0; h < niveles.size(); ++h) {
+        if (niveles[h].size() < capacidades[h]) {
+            continue;
+        }
+        if (h + 1 == niveles.size()) {
+            niveles.emplace_back();
+            recalcularCapacidades();
+        }
+
+        std::vector<double>& nivel = niveles[h];
+        std::sort(nivel.begin(), nivel.end());
+
+        double sobrante = 0.0;
+        bool haySobrante = nivel.size() % 2 == 1;
+        if (haySobrante) {
+            sobrante = nivel.back();
+            nivel.pop_back();
+        }
+
+        // xorshift64: basta con un bit pseudoaleatorio por compactación
+        semilla ^= semilla << 13;
+        semilla ^= semilla >> 7;
+        semilla ^= semilla << 17;
+        size_t desfase = semilla & 1;
+
+        std::vector<double>& superior = niveles[h + 1];
+        for (size_t i = desfase; i < nivel.size(); i += 2) {
+            superior.push_back(nivel[i]);
+        }
+        nivel.clear();
+        if (haySobrante) {
+            nivel.push_back(sobrante);
+        }
+    }
+}
+
+/**
+ * Implementación de combinar.
+ *
+ * POR QUÉ: Unir los sketches parciales de varios hilos (o de varios grupos).
+ * CÓMO: Concatena nivel por nivel y vuelve a compactar lo que exceda la capacidad.
+ * PARA QUÉ: Sketches paralelos con el mismo error que uno secuencial.
+ */
+void SketchKLL::combinar(const SketchKLL& otro) {
+    while (niveles.size() < otro.niveles.size()) {
+        niveles.emplace_back();
+    }
+    recalcularCapacidades();
+    for (size_t h = 0; h < otro.niveles.size(); ++h) {
+        niveles[h].insert(niveles[h].end(), otro.niveles[h].begin(), otro.niveles[h].end());
+    }
+    n += otro.n;
+    compactar();
+}
+
+double SketchKLL::cuantil(double q) const {
+    std::vector<std::pair<double, uint64_t>> ponderados;
+    for (size_t h = 0; h < niveles.size(); ++h) {
+        for (double v : niveles[h]) {
+            ponderados.emplace_back(v, uint64_t{1} << h);
+        }
+    }
+    if (ponderados.empty()) {
+        return 0.0;
+    }
+    std::sort(ponderados.begin(), ponderados.end());
+
+    q = std::min(1.0, std::max(0.0, q));
+    double objetivo = q * static_cast<double>(n);
+    uint64_t acumulado = 0;
+    for (const auto& [valor, peso] : ponderados) {
+        acumulado += peso;
+        if (static_cast<double>(acumulado) >= objetivo) {
+            return valor;
+        }
+    }
+    return ponderados.back().first;
+}
+
+/**
+ * Implementación de calcularSketchesCuantiles.
+ *
+ * POR QUÉ: Una sola pasada para todos los grupos y ambos campos.
+ * CÓMO: Un ResumenCuantiles parcial por hilo (sin bloqueos) y combinación final
+ *       en el hilo llamador.
+ * PARA QUÉ: Escalar la construcción con el número de núcleos.
+ */
+ResumenCuantiles calcularSketchesCuantiles(const std::vector<Persona>& personas, int k) {
+    unsigned hilos = hilosParaTamano(personas.size());
+    std::vector<ResumenCuantiles> parciales(hilos);
+
+    ejecutarPorBloques(personas.size(), [&](unsigned h, size_t inicio, size_t fin) {
+        ResumenCuantiles& parcial = parciales[h];
+        for (size_t i = inicio; i < fin; ++i) {
+            const Persona& p = personas[i];
+            SketchesGrupo& ciudad = grupoDe(parcial.porCiudad, std::string(p.getCiudadNacimiento()), k);
+            SketchesGrupo& calendario = grupoDe(parcial.porCalendario, p.getCalendarioTributario(), k);
+            ciudad.ingresos.agregar(p.getIngresosAnuales());
+            ciudad.patrimonio.agregar(p.getPatrimonio());
+            calendario.ingresos.agregar(p.getIngresosAnuales());
+            calendario.patrimonio.agregar(p.getPatrimonio());
+        }
+    }, hilos);
+
+    ResumenCuantiles resultado = std::move(parciales[0]);
+    for (unsigned h = 1; h < hilos; ++h) {
+        for (const auto& [ciudad, grupo] : parciales[h].porCiudad) {
+            SketchesGrupo& destino = grupoDe(resultado.porCiudad, ciudad, k);
+            destino.ingresos.combinar(grupo.ingresos);
+            destino.patrimonio.combinar(grupo.patrimonio);
+        }
+        for (const auto& [calendario, grupo] : parciales[h].porCalendario) {
+            SketchesGrupo& destino = grupoDe(resultado.porCalendario, calendario, k);
+            destino.ingresos.combinar(grupo.ingresos);
+            destino.patrimonio.combinar(grupo.patrimonio);
+        }
+    }
+    return resultado;
+}
+
+namespace {
+    // Cuantiles exactos de un vector (lo ordena): método del rango más cercano
+    std::vector<double> cuantilesDe(std::vector<double>& valores, const std::vector<double>& cuantiles) {
+        std::sort(valores.begin(), valores.end());
+        std::vector<double> resultado;
+        for (double q : cuantiles) {
+            size_t rango = static_cast<size_t>(std::ceil(q * valores.size()));
+            resultado.push_back(valores[rango > 0 ? rango - 1 : 0]);
+        }
+        return resultado;
+    }
+}
+
+/**
+ * Implementación de calcularCuantilesExactos.
+ *
+ * POR QUÉ: Referencia para medir el error y la ventaja de tiempo de los sketches.
+ * CÓMO: Copia los valores de cada grupo a un vector y lo ordena completo.
+ * PARA QUÉ: Comparación en el menú.
+ */
+CuantilesExactos calcularCuantilesExactos(const std::vector<Persona>& personas, bool ingresos,
+                                          const std::vector<double>& cuantiles) {
+    std::map<std::string, std::vector<double>> valoresCiudad;
+    std::map<char, std::vector<double>> valoresCalendario;
+    for (const auto& p : personas) {
+        double v = ingresos ? p.getIngresosAnuales() : p.getPatrimonio();
+        valoresCiudad[std::string(p.getCiudadNacimiento())].push_back(v);
+        valoresCalendario[p.getCalendarioTributario()].push_back(v);
+    }
+
+    CuantilesExactos resultado;
+    for (auto& [ciudad, valores] : valoresCiudad) {
+        resultado.porCiudad[ciudad] = cuantilesDe(valores, cuantiles);
+    }
+    for (auto& [calendario, valores] : valoresCalendario) {
+        resultado.porCalendario[calendario] = cuantilesDe(valores, cuantiles);
+    }
+    return resultado;
+}
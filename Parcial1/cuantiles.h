@@ -0,0 +1,96 @@
+#ifndef CUANTILES_H
+#define CUANTILES_H
+
+#include "persona.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+
+/**
+ * Sketch de cuantiles KLL (Karnin-Lang-Liberty), combinable.
+ *
+ * POR QUÉ: Calcular medianas o percentiles exactos exige guardar y ordenar todos los
+ *          valores de cada grupo, lo que no escala con conjuntos muy grandes o en flujo.
+ * CÓMO: Mantiene una jerarquía de "compactadores": el nivel h guarda elementos que
+ *       representan 2^h valores originales. Cuando un nivel se llena se ordena y se
+ *       promueve al nivel siguiente uno de cada dos elementos (con desfase aleatorio).
+ *       Las capacidades decrecen geométricamente hacia los niveles bajos, por lo que el
+ *       espacio es O(k) independientemente de cuántos valores se inserten.
+ * PARA QUÉ: Percentiles aproximados en una sola pasada y con memoria acotada; dos
+ *           sketches se pueden combinar, lo que permite un sketch por hilo.
+ *
+ * El error de rango es aproximadamente 1.7 / k (con k = 200, cerca del 1%).
+ */
+class SketchKLL {
+public:
+    explicit SketchKLL(int k = 200);
+
+    // Inserta un valor (O(1) amortizado)
+    void agregar(double valor);
+
+    // Incorpora otro sketch (p. ej. el parcial de otro hilo)
+    void combinar(const SketchKLL& otro);
+
+    /**
+     * Valor aproximado en el cuantil q (0.0 - 1.0).
+     *
+     * POR QUÉ: Responder mediana, p90, p99, etc.
+     * CÓMO: Ordena los elementos retenidos con su peso 2^nivel y recorre el peso acumulado.
+     * PARA QUÉ: Consulta O(k log k) sin acceso a los datos originales.
+     */
+    double cuantil(double q) const;
+
+    uint64_t cantidad() const { return n; }
+
+    // Elementos retenidos (para reportar memoria aproximada)
+    size_t retenidos() const;
+
+private:
+    void recalcularCapacidades();
+    void compactar();
+
+    int k;
+    uint64_t n = 0;                          // Valores insertados en total
+    std::vector<std::vector<double>> niveles; // niveles[h]: elementos con peso 2^h
+    std::vector<size_t> capacidades;          // Capacidad de cada nivel
+    uint64_t semilla;                         // Estado del generador para el desfase (propio de cada sketch)
+};
+
+// Par de sketches que se mantiene por cada grupo
+struct SketchesGrupo {
+    SketchKLL ingresos;
+    SketchKLL patrimonio;
+};
+
+// Resultado de la pasada de sketches: un par por ciudad y uno por calendario
+struct ResumenCuantiles {
+    std::map<std::string, SketchesGrupo> porCiudad;
+    std::map<char, SketchesGrupo> porCalendario;
+};
+
+/**
+ * Construye los sketches por ciudad y por calendario en una sola pasada paralela.
+ *
+ * POR QUÉ: Evitar una pasada (y un ordenamiento) por cada grupo y campo.
+ * CÓMO: Cada hilo llena sus propios sketches sobre su bloque; al final se combinan.
+ * PARA QUÉ: Percentiles aproximados de ingresos y patrimonio por grupo.
+ */
+ResumenCuantiles calcularSketchesCuantiles(const std::vector<Persona>& personas, int k = 200);
+
+// Valores exactos por grupo para comparar: grupo -> {p50, p90, p99}
+struct CuantilesExactos {
+    std::map<std::string, std::vector<double>> porCiudad;
+    std::map<char, std::vector<double>> porCalendario;
+};
+
+/**
+ * Calcula los mismos percentiles de forma exacta (agrupando y ordenando).
+ *
+ * @param ingresos true para ingresosAnuales, false para patrimonio.
+ * @param cuantiles Cuantiles a calcular (0.0 - 1.0).
+ */
+CuantilesExactos calcularCuantilesExactos(const std::vector<Persona>& personas, bool ingresos,
+                                          const std::vector<double>& cuantiles);
+
+#endif // CUANTILES_H
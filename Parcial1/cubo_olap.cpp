@@ -0,0 +1,182 @@
+#include "cubo_olap.h"
+#include <mutex>
+#include <algorithm>
+
+namespace {
+    const int CALENDARIOS = 3;
+    const int DECLARANTE = 2;
+
+    void acumular(CeldaCubo& celda, const Persona& p, uint32_t posicion) {
+        const double valores[3] = {p.getPatrimonio(), p.getIngresosAnuales(), p.getDeudas()};
+        ++celda.conteo;
+        for (int c = 0; c < 3; ++c) {
+            MedidaCubo& m = celda.medidas[c];
+            double v = valores[c];
+            m.suma += v;
+            m.minimo = std::min(m.minimo, v);
+            if (v > m.maximo) {
+                m.maximo = v;
+                m.posicionMaximo = posicion;
+            }
+        }
+    }
+
+    // Combina dos celdas; en empate gana la posición menor (igual que un recorrido secuencial)
+    void combinar(CeldaCubo& destino, const CeldaCubo& otra) {
+        destino.conteo += otra.conteo;
+        for (int c = 0; c < 3; ++c) {
+            MedidaCubo& d = destino.medidas[c];
+            const MedidaCubo& o = otra.medidas[c];
+            d.suma += o.suma;
+            d.minimo = std::min(d.minimo, o.minimo);
+            if (o.maximo > d.maximo || (o.maximo == d.maximo && o.posicionMaximo < d.posicionMaximo)) {
+                d.maximo = o.maximo;
+                d.posicionMaximo = o.posicionMaximo;
+            }
+        }
+    }
+}
+
+int CuboOLAP::indiceDecada(int anio) {
+    int decada = (anio - DECADA_BASE) / 10;
+    return anio >= DECADA_BASE && decada < DECADAS ? decada : -1;
+}
+
+int CuboOLAP::indiceCalendario(char calendario) {
+    return calendario >= 'A' && calendario <= 'C' ? calendario - 'A' : -1;
+}
+
+int CuboOLAP::indiceCiudad(std::string_view ciudad) const {
+    for (size_t c = 0; c < ciudades.size(); ++c) {
+        if (ciudades[c] == ciudad) {
+            return static_cast<int>(c);
+        }
+    }
+    return -1;
+}
+
+size_t CuboOLAP::posicion(int ciudad, int calendario, int declarante, int decada) const {
+    size_t c = ciudad == TODOS ? ciudades.size() : static_cast<size_t>(ciudad);
+    size_t cal = calendario == TODOS ? CALENDARIOS : static_cast<size_t>(calendario);
+    size_t dec = declarante == TODOS ? DECLARANTE : static_cast<size_t>(declarante);
+    size_t dd = decada == TODOS ? DECADAS : static_cast<size_t>(decada);
+    return ((c * (CALENDARIOS + 1) + cal) * (DECLARANTE + 1) + dec) * (DECADAS + 1) + dd;
+}
+
+/**
+ * Implementación de construir.
+ *
+ * POR QUÉ: Ver cubo_olap.h.
+ * CÓMO: Las ciudades se numeran con un diccionario compartido protegido por mutex;
+ *       cada hilo guarda en una lista corta las vistas que ya conoce (comparando
+ *       apuntador y largo), así el mutex solo se toma la primera vez que un hilo ve
+ *       una ciudad. Las celdas base de cada hilo crecen por ciudad según aparecen.
+ * PARA QUÉ: Una sola pasada paralela sin contención por persona.
+ */
+void CuboOLAP::construir(const std::vector<Persona>& datos, unsigned hilos) {
+    invalidar();
+    const size_t BASE_POR_CIUDAD = CALENDARIOS * DECLARANTE * DECADAS;
+
+    std::mutex mutexCiudades;
+    hilos = hilosParaTamano(datos.size(), hilos);
+    std::vector<std::vector<CeldaCubo>> parciales(hilos);
+
+    ejecutarPorBloques(datos.size(), [&](unsigned h, size_t inicio, size_t fin) {
+        std::vector<std::pair<std::string_view, int>> conocidas;
+        std::vector<CeldaCubo>& base = parciales[h];
+        for (size_t i = inicio; i < fin; ++i) {
+            const Persona& p = datos[i];
+            int calendario = indiceCalendario(p.getCalendarioTributario());
+            int decada = indiceDecada(p.claveFechaNacimiento() / 10000);
+            if (calendario < 0 || decada < 0) {
+                continue; // Fuera de las dimensiones del cubo
+            }
+
+            std::string_view nombre = p.getCiudadNacimiento();
+            int ciudad = -1;
+            for (const auto& [vista, indice] : conocidas) {
+                if (vista.data() == nombre.data() && vista.size() == nombre.size()) {
+                    ciudad = indice;
+                    break;
+                }
+            }
+            if (ciudad < 0) {
+                std::lock_guard<std::mutex> bloqueo(mutexCiudades);
+                ciudad = indiceCiudad(nombre);
+                if (ciudad < 0) {
+                    ciudad = static_cast<int>(ciudades.size());
+                    ciudades.push_back(nombre);
+                }
+                conocidas.emplace_back(nombre, ciudad);
+            }
+
+            size_t minimo = (static_cast<size_t>(ciudad) + 1) * BASE_POR_CIUDAD;
+            if (base.size() < minimo) {
+                base.resize(minimo);
+            }
+            size_t pos = ((static_cast<size_t>(ciudad) * CALENDARIOS + calendario) * DECLARANTE
+                          + (p.getDeclaranteRenta() ? 1 : 0)) * DECADAS + decada;
+            acumular(base[pos], p, static_cast<uint32_t>(i));
+        }
+    }, hilos);
+
+    // Celdas base combinadas (en orden de hilo: los empates los gana el bloque anterior)
+    std::vector<CeldaCubo> base(ciudades.size() * BASE_POR_CIUDAD);
+    for (const auto& parcial : parciales) {
+        for (size_t i = 0; i < parcial.size(); ++i) {
+            combinar(base[i], parcial[i]);
+        }
+    }
+
+    // Agrupamientos: cada celda base aporta a las 16 combinaciones con comodines
+    celdas.assign((ciudades.size() + 1) * (CALENDARIOS + 1) * (DECLARANTE + 1) * (DECADAS + 1), CeldaCubo());
+    for (size_t i = 0; i < base.size(); ++i) {
+        if (base[i].conteo == 0) {
+            continue;
+        }
+        int decada = static_cast<int>(i % DECADAS);
+        int declarante = static_cast<int>(i / DECADAS % DECLARANTE);
+        int calendario = static_cast<int>(i / (DECADAS * DECLARANTE) % CALENDARIOS);
+        int ciudad = static_cast<int>(i / BASE_POR_CIUDAD);
+        for (int mascara = 0; mascara < 16; ++mascara) {
+            combinar(celdas[posicion(mascara & 1 ? TODOS : ciudad, mascara & 2 ? TODOS : calendario,
+                                     mascara & 4 ? TODOS : declarante, mascara & 8 ? TODOS : decada)],
+                     base[i]);
+        }
+    }
+
+    personas = &datos;
+}
+
+void CuboOLAP::invalidar() {
+    personas = nullptr;
+    ciudades.clear();
+    celdas.clear();
+}
+
+const CeldaCubo& CuboOLAP::celda(int ciudad, int calendario, int declarante, int decada) const {
+    return celdas[posicion(ciudad, calendario, declarante, decada)];
+}
+
+const Persona* CuboOLAP::maximo(const CeldaCubo& celda, CampoFinanciero campo) const {
+    if (celda.conteo == 0) {
+        return nullptr;
+    }
+    return &(*personas)[celda.medida(campo).posicionMaximo];
+}
+
+std::vector<std::pair<std::string_view, double>> CuboOLAP::topCiudadesPorPromedio(CampoFinanciero campo,
+                                                                                 size_t k) const {
+    std::vector<std::pair<std::string_view, double>> lista;
+    for (size_t c = 0; c < ciudades.size(); ++c) {
+        const CeldaCubo& total = celda(static_cast<int>(c), TODOS, TODOS, TODOS);
+        if (total.conteo > 0) {
+            lista.emplace_back(ciudades[c], total.promedio(campo));
+        }
+    }
+    k = std::min(k, lista.size());
+    std::partial_sort(lista.begin(), lista.begin() + k, lista.end(),
+                      [](const auto& a, const auto& b) { return a.second > b.second; });
+    lista.resize(k);
+    return lista;
+}
@@ -0,0 +1,95 @@
+#ifndef CUBO_OLAP_H
+#define CUBO_OLAP_H
+
+#include "persona.h"
+#include "indice_valores.h" // CampoFinanciero
+#include "paralelo.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Agregados de un campo financiero dentro de una celda del cubo.
+ */
+struct MedidaCubo {
+    double suma = 0;
+    double minimo = std::numeric_limits<double>::infinity();
+    double maximo = -std::numeric_limits<double>::infinity();
+    uint32_t posicionMaximo = UINT32_MAX; // Posición en la colección de quien tiene el máximo
+};
+
+struct CeldaCubo {
+    uint64_t conteo = 0;
+    MedidaCubo medidas[3]; // Indexadas por CampoFinanciero
+
+    const MedidaCubo& medida(CampoFinanciero campo) const { return medidas[static_cast<int>(campo)]; }
+    double promedio(CampoFinanciero campo) const { return conteo ? medida(campo).suma / conteo : 0.0; }
+};
+
+/**
+ * Cubo de datos precalculado: ciudad × calendario × declarante × década de nacimiento.
+ *
+ * POR QUÉ: Casi todas las preguntas de reporte del menú (top 3 ciudades, mayor
+ *          patrimonio por calendario o por ciudad...) son agrupaciones sobre unas
+ *          pocas dimensiones de baja cardinalidad, y cada una recorría el conjunto.
+ * CÓMO: Una pasada paralela acumula, por hilo, conteo/suma/mínimo/máximo/argmax de
+ *       patrimonio, ingresos y deudas en las celdas base (todas las dimensiones fijas).
+ *       Luego se combinan los parciales y se calculan los 16 agrupamientos (cada
+ *       dimensión puede valer TODOS) a partir de las celdas base, que son pocas miles.
+ *       Las ciudades se numeran al encontrarlas; las décadas van de 1900 a 2090.
+ * PARA QUÉ: Responder cualquier agrupación sobre esas dimensiones en microsegundos.
+ *
+ * Igual que los índices, guarda un apuntador al vector: reconstruir al cambiar el conjunto.
+ */
+class CuboOLAP {
+public:
+    static constexpr int TODOS = -1;         // Comodín de cualquier dimensión
+    static constexpr int DECADA_BASE = 1900;
+    static constexpr int DECADAS = 20;
+
+    void construir(const std::vector<Persona>& personas, unsigned hilos = numeroHilos());
+    void invalidar();
+    bool construido() const { return personas != nullptr; }
+
+    /**
+     * Celda para una combinación de dimensiones; cualquiera puede ser TODOS.
+     *
+     * @param ciudad Índice de indiceCiudad().
+     * @param calendario 0=A, 1=B, 2=C.
+     * @param declarante 0=no, 1=sí.
+     * @param decada Índice de indiceDecada().
+     */
+    const CeldaCubo& celda(int ciudad, int calendario, int declarante, int decada) const;
+
+    // Persona con el máximo del campo en la celda (nullptr si la celda está vacía)
+    const Persona* maximo(const CeldaCubo& celda, CampoFinanciero campo) const;
+
+    /**
+     * Las k ciudades con mayor promedio del campo (equivale a top3CiudadesPatrimonio).
+     *
+     * @return Pares (ciudad, promedio) de mayor a menor.
+     */
+    std::vector<std::pair<std::string_view, double>> topCiudadesPorPromedio(CampoFinanciero campo,
+                                                                           size_t k) const;
+
+    size_t numeroCiudades() const { return ciudades.size(); }
+    std::string_view nombreCiudad(int indice) const { return ciudades[indice]; }
+    int indiceCiudad(std::string_view ciudad) const;     // -1 si no aparece en el conjunto
+    static int indiceDecada(int anio);                   // -1 fuera de [1900, 2100)
+    static int indiceCalendario(char calendario);        // -1 si no es A, B ni C
+
+    size_t numeroCeldas() const { return celdas.size(); }
+    size_t bytes() const { return celdas.size() * sizeof(CeldaCubo); }
+
+private:
+    size_t posicion(int ciudad, int calendario, int declarante, int decada) const;
+
+    const std::vector<Persona>* personas = nullptr;
+    std::vector<std::string_view> ciudades; // Vistas al conjunto indexado
+    std::vector<CeldaCubo> celdas;          // (ciudades+1) × 4 × 3 × (DECADAS+1)
+};
+
+#endif // CUBO_OLAP_H
@@ -0,0 +1,161 @@
+#include "exportacion.h"
+#include "radix.h"
+#include "paralelo.h"
+#include <chrono>
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+EscritorBuffer::EscritorBuffer(const std::string& ruta, size_t capacidad)
+    : fd(open(ruta.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), capacidad(capacidad) {
+    buffer.reserve(capacidad);
+}
+
+EscritorBuffer::~EscritorBuffer() {
+    if (fd >= 0) {
+        vaciar();
+        close(fd);
+    }
+}
+
+void EscritorBuffer::agregar(std::string_view texto) {
+    if (buffer.size() + texto.size() > capacidad) {
+        vaciar();
+        if (texto.size() > capacidad) {
+            buffer.append(texto); // Bloque más grande que el buffer: se escribe directo
+            vaciar();
+            return;
+        }
+    }
+    buffer.append(texto);
+}
+
+bool EscritorBuffer::vaciar() {
+    const char* datos = buffer.data();
+    size_t pendientes = buffer.size();
+    while (pendientes > 0 && !fallo) {
+        ssize_t n = write(fd, datos, pendientes);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            fallo = true;
+            break;
+        }
+        datos += n;
+        pendientes -= static_cast<size_t>(n);
+        escritos += static_cast<size_t>(n);
+    }
+    buffer.clear();
+    return !fallo;
+}
+
+const char* nombreCriterio(CriterioOrden criterio) {
+    switch (criterio) {
+        case CriterioOrden::Patrimonio: return "patrimonio";
+        case CriterioOrden::Ingresos: return "ingresos";
+        case CriterioOrden::Deudas: return "deudas";
+        default: return "fecha";
+    }
+}
+
+std::vector<uint32_t> permutacionOrdenada(const std::vector<Persona>& personas,
+                                          CriterioOrden criterio, bool descendente) {
+    std::vector<uint64_t> claves(personas.size());
+    ejecutarPorBloques(personas.size(), [&](unsigned, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) {
+            const Persona& p = personas[i];
+            uint64_t clave;
+            switch (criterio) {
+                case CriterioOrden::Patrimonio: clave = claveOrdenable(p.getPatrimonio()); break;
+                case CriterioOrden::Ingresos: clave = claveOrdenable(p.getIngresosAnuales()); break;
+                case CriterioOrden::Deudas: clave = claveOrdenable(p.getDeudas()); break;
+                default: clave = static_cast<uint64_t>(p.claveFechaNacimiento());
+            }
+            claves[i] = descendente ? ~clave : clave;
+        }
+    });
+    return ordenarRadixParalelo(claves);
+}
+
+namespace {
+    const size_t FILAS_POR_HILO = 65536; // Tamaño de ventana por hilo en la exportación
+
+    void agregarDecimal(std::string& salida, double valor) {
+        char texto[64];
+        auto r = std::to_chars(texto, texto + sizeof(texto), valor, std::chars_format::fixed, 2);
+        salida.append(texto, r.ptr);
+    }
+
+    // Una fila CSV: rango,id,nombre,apellido,ciudad,fecha,ingresos,patrimonio,deudas,declarante,calendario
+    void formatearFila(std::string& salida, size_t rango, const Persona& p) {
+        char texto[24];
+        auto r = std::to_chars(texto, texto + sizeof(texto), rango);
+        salida.append(texto, r.ptr);
+        salida += ',';
+        salida.append(p.getId());
+        salida += ',';
+        salida.append(p.getNombre());
+        salida += ',';
+        salida.append(p.getApellido());
+        salida += ',';
+        salida.append(p.getCiudadNacimiento());
+        salida += ',';
+        salida.append(p.getFechaNacimiento());
+        salida += ',';
+        agregarDecimal(salida, p.getIngresosAnuales());
+        salida += ',';
+        agregarDecimal(salida, p.getPatrimonio());
+        salida += ',';
+        agregarDecimal(salida, p.getDeudas());
+        salida += p.getDeclaranteRenta() ? ",1," : ",0,";
+        salida += p.getCalendarioTributario();
+        salida += '\n';
+    }
+}
+
+bool exportarOrdenado(const std::vector<Persona>& personas, CriterioOrden criterio, bool descendente,
+                      const std::string& ruta, ResultadoExportacion& resultado) {
+    using Reloj = std::chrono::high_resolution_clock;
+    resultado = ResultadoExportacion();
+
+    EscritorBuffer escritor(ruta);
+    if (!escritor.abierto()) {
+        return false;
+    }
+
+    auto inicio = Reloj::now();
+    std::vector<uint32_t> orden = permutacionOrdenada(personas, criterio, descendente);
+    auto ordenado = Reloj::now();
+
+    escritor.agregar("rango,id,nombre,apellido,ciudad,fecha,ingresos,patrimonio,deudas,declarante,calendario\n");
+
+    size_t n = orden.size();
+    unsigned hilos = numeroHilos();
+    std::vector<std::string> textos(hilos);
+    size_t ventana = FILAS_POR_HILO * hilos;
+    for (size_t base = 0; base < n && escritor.correcto(); base += ventana) {
+        size_t filas = std::min(ventana, n - base);
+        unsigned usados = ejecutarPorBloques(filas, [&](unsigned h, size_t desde, size_t hasta) {
+            std::string& texto = textos[h];
+            texto.clear();
+            for (size_t i = desde; i < hasta; ++i) {
+                formatearFila(texto, base + i + 1, personas[orden[base + i]]);
+            }
+        }, hilos);
+        for (unsigned h = 0; h < usados; ++h) {
+            escritor.agregar(textos[h]);
+        }
+    }
+    escritor.vaciar();
+
+    std::chrono::duration<double, std::milli> msOrdenar = ordenado - inicio;
+    std::chrono::duration<double, std::milli> msEscribir = Reloj::now() - ordenado;
+    resultado.filas = n;
+    resultado.bytes = escritor.bytesEscritos();
+    resultado.tiempoOrdenar = msOrdenar.count();
+    resultado.tiempoEscribir = msEscribir.count();
+    return escritor.correcto();
+}
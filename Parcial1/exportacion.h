@@ -0,0 +1,84 @@
+#ifndef EXPORTACION_H
+#define EXPORTACION_H
+
+#include "persona.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Escritor con buffer propio sobre un descriptor de archivo.
+ *
+ * POR QUÉ: std::ofstream con operator<< formatea cada número pasando por el locale y
+ *          hace una llamada virtual por campo; con decenas de millones de filas eso
+ *          domina el tiempo de exportación.
+ * CÓMO: Acumula bytes en un buffer de 4 MB y lo vacía con write() cuando se llena;
+ *       los números se escriben con std::to_chars.
+ * PARA QUÉ: Escribir archivos grandes con pocas llamadas al sistema.
+ */
+class EscritorBuffer {
+public:
+    explicit EscritorBuffer(const std::string& ruta, size_t capacidad = size_t{4} << 20);
+    ~EscritorBuffer(); // Vacía lo pendiente y cierra el archivo
+
+    EscritorBuffer(const EscritorBuffer&) = delete;
+    EscritorBuffer& operator=(const EscritorBuffer&) = delete;
+
+    bool abierto() const { return fd >= 0; }
+    // false si alguna escritura falló (disco lleno, permiso...)
+    bool correcto() const { return fd >= 0 && !fallo; }
+    size_t bytesEscritos() const { return escritos; }
+
+    void agregar(std::string_view texto);
+    bool vaciar();
+
+private:
+    int fd;
+    std::string buffer;
+    size_t capacidad;
+    size_t escritos = 0;
+    bool fallo = false;
+};
+
+// Criterio por el que se ordena la población en la exportación por rangos
+enum class CriterioOrden { Patrimonio, Ingresos, Deudas, FechaNacimiento };
+
+struct ResultadoExportacion {
+    size_t filas = 0;
+    size_t bytes = 0;
+    double tiempoOrdenar = 0;  // ms: claves + radix
+    double tiempoEscribir = 0; // ms: formateo + escritura
+};
+
+/**
+ * Permutación de la colección ordenada por un criterio.
+ *
+ * CÓMO: Extrae en paralelo una clave de 64 bits por persona (claveOrdenable para los
+ *       valores, AAAAMMDD para la fecha) y la ordena con ordenarRadixParalelo. Para
+ *       orden descendente se invierten los bits de la clave: los empates conservan el
+ *       orden original porque el radix es estable.
+ * @return Posición original de cada persona en el orden pedido.
+ */
+std::vector<uint32_t> permutacionOrdenada(const std::vector<Persona>& personas,
+                                          CriterioOrden criterio, bool descendente);
+
+/**
+ * Exporta toda la población ordenada, con su rango, a un archivo CSV.
+ *
+ * POR QUÉ: No había forma de obtener la población completa ordenada por patrimonio,
+ *          deudas o fecha: solo consultas puntuales sobre los índices.
+ * CÓMO: Ordena con permutacionOrdenada y recorre la permutación por ventanas; cada
+ *       ventana se formatea en paralelo (un texto por hilo) y los textos se pasan en
+ *       orden a un EscritorBuffer, así la memoria extra no crece con n.
+ * PARA QUÉ: Reportes por ranking y medición de filas/s a gran escala.
+ * @return false si no se pudo escribir el archivo.
+ */
+bool exportarOrdenado(const std::vector<Persona>& personas, CriterioOrden criterio, bool descendente,
+                      const std::string& ruta, ResultadoExportacion& resultado);
+
+// Nombre del criterio para mensajes y para el Monitor ("patrimonio", "fecha"...)
+const char* nombreCriterio(CriterioOrden criterio);
+
+#endif // EXPORTACION_H
@@ -1,33 +1,25 @@
 #include "generador.h"
+#include "agregacion.h"
+#include "reglas_tributarias.h"
+#include "xoshiro.h"
+#include "paralelo.h"
 #include <cstdlib>   // rand(), srand()
 #include <ctime>     // time()
 #include <random>    // std::mt19937, std::uniform_real_distribution
 #include <vector>
 #include <algorithm> // std::find_if, std::sort
+#include <functional> // std::less, std::greater
 #include <map>
 #include <iostream>  // std::cout
 #include <iomanip>   // std::setprecision
+#include <charconv>  // std::to_chars
+#include <atomic>    // std::atomic (generación desde varios hilos)
+#include <cmath>     // std::pow, std::exp, std::log
+#include <cstdio>    // std::snprintf
 
 // Bases de datos para generación realista
 
-// Nombres femeninos comunes en Colombia
-const std::vector<std::string> nombresFemeninos = {
-    "María", "Luisa", "Carmen", "Ana", "Sofía", "Isabel", "Laura", "Andrea", "Paula", "Valentina",
-    "Camila", "Daniela", "Carolina", "Fernanda", "Gabriela", "Patricia", "Claudia", "Diana", "Lucía", "Ximena"
-};
-
-// Nombres masculinos comunes en Colombia
-const std::vector<std::string> nombresMasculinos = {
-    "Juan", "Carlos", "José", "James", "Andrés", "Miguel", "Luis", "Pedro", "Alejandro", "Ricardo",
-    "Felipe", "David", "Jorge", "Santiago", "Daniel", "Fernando", "Diego", "Rafael", "Martín", "Óscar",
-    "Edison", "Nestor", "Gertridis"
-};
-
-// Apellidos comunes en Colombia
-const std::vector<std::string> apellidos = {
-    "Gómez", "Rodríguez", "Martínez", "López", "García", "Pérez", "González", "Sánchez", "Ramírez", "Torres",
-    "Díaz", "Vargas", "Castro", "Ruiz", "Álvarez", "Romero", "Suárez", "Rojas", "Moreno", "Muñoz", "Valencia",
-};
+// Nombres y apellidos: tablas indexadas en nombres.h (cada persona guarda solo índices)
 
 // Principales ciudades colombianas
 const std::vector<std::string> ciudadesColombia = {
@@ -35,96 +27,412 @@ const std::vector<std::string> ciudadesColombia = {
     "Manizales", "Pasto", "Neiva", "Villavicencio", "Armenia", "Sincelejo", "Valledupar", "Montería", "Popayán", "Tunja"
 };
 
+namespace {
+    // Años de nacimiento que cubre la pirámide de edades (edades 16 a 100 en 2025)
+    const int ANIO_PIRAMIDE_INICIO = 1925;
+    const int ANIO_PIRAMIDE_FIN = 2009;
+
+    ConfiguracionGenerador configuracion;
+    std::atomic<long> contadorIds{1000000000}; // Siguiente cédula (inicia en 1,000,000,000)
+    std::vector<double> acumuladaCiudades; // Zipf: probabilidad acumulada por ciudad
+    std::vector<double> acumuladaAnios;    // Pirámide: probabilidad acumulada por año
+
+    // Normaliza pesos en una tabla acumulada que termina en 1
+    std::vector<double> acumular(const std::vector<double>& pesos) {
+        std::vector<double> acumulada(pesos.size());
+        double total = 0;
+        for (size_t i = 0; i < pesos.size(); ++i) {
+            total += pesos[i];
+            acumulada[i] = total;
+        }
+        for (double& a : acumulada) {
+            a /= total;
+        }
+        return acumulada;
+    }
+
+    // Índice de la tabla acumulada donde cae u en [0, 1)
+    size_t muestrear(const std::vector<double>& acumulada, double u) {
+        size_t i = std::upper_bound(acumulada.begin(), acumulada.end(), u) - acumulada.begin();
+        return std::min(i, acumulada.size() - 1);
+    }
+
+    // Generador Mersenne Twister propio de cada hilo
+    std::mt19937& generadorDelHilo() {
+        static std::atomic<unsigned> hilosCreados{0};
+        thread_local std::mt19937 generador(static_cast<unsigned>(time(nullptr)) + 7919u * hilosCreados++);
+        return generador;
+    }
+
+    // Entero uniforme en [0, n) con el generador del hilo: rand() comparte un único
+    // estado con candado, y los hilos que generan a la vez terminaban turnándose
+    int enteroAleatorio(int n) {
+        std::uniform_int_distribution<int> distribucion(0, n - 1);
+        return distribucion(generadorDelHilo());
+    }
+
+    double lognormal(double mediana, double sigma) {
+        std::lognormal_distribution<double> distribucion(std::log(mediana), sigma);
+        return distribucion(generadorDelHilo());
+    }
+
+    // Pareto por transformada inversa: minimo * U^(-1/alfa), con U en (0, 1]
+    double pareto(double minimo, double alfa) {
+        double u = 1.0 - randomDouble(0.0, 1.0);
+        return minimo * std::pow(u, -1.0 / alfa);
+    }
+}
+
+void configurarGenerador(const ConfiguracionGenerador& nueva) {
+    configuracion = nueva;
+
+    std::vector<double> pesosCiudades(ciudadesColombia.size());
+    for (size_t k = 0; k < pesosCiudades.size(); ++k) {
+        pesosCiudades[k] = 1.0 / std::pow(static_cast<double>(k + 1), nueva.exponenteZipf);
+    }
+    acumuladaCiudades = acumular(pesosCiudades);
+
+    std::vector<double> pesosAnios;
+    for (int anio = ANIO_PIRAMIDE_INICIO; anio <= ANIO_PIRAMIDE_FIN; ++anio) {
+        int edad = 2025 - anio;
+        pesosAnios.push_back(edad <= 45 ? 1.0 : std::exp(-(edad - 45) / 15.0));
+    }
+    acumuladaAnios = acumular(pesosAnios);
+}
+
+const ConfiguracionGenerador& configuracionGenerador() {
+    return configuracion;
+}
+
+std::string describirConfiguracion(const ConfiguracionGenerador& c) {
+    std::string texto = "ciudades ";
+    if (c.ciudades == DistribucionCiudades::Zipf) {
+        char exponente[16];
+        std::snprintf(exponente, sizeof(exponente), "%.2f", c.exponenteZipf);
+        texto += std::string("zipf(") + exponente + ")";
+    } else {
+        texto += "uniforme";
+    }
+    texto += ", dinero ";
+    texto += c.dinero == DistribucionDinero::LogNormal ? "log-normal"
+           : c.dinero == DistribucionDinero::Pareto ? "pareto" : "uniforme";
+    texto += ", edades ";
+    texto += c.edades == DistribucionEdades::Piramide ? "pirámide" : "uniforme";
+    return texto;
+}
+
 /**
  * Implementación de generarFechaNacimiento.
  * 
  * POR QUÉ: Simular fechas de nacimiento realistas.
- * CÓMO: Día (1-28), mes (1-12), año (1960-2009).
+ * CÓMO: Día (1-28), mes (1-12), año (1960-2009), escritos directamente en la arena
+ *       (se reservan 10 caracteres, el máximo de "dd/mm/aaaa").
  * PARA QUÉ: Atributo fechaNacimiento de Persona.
  */
-std::string generarFechaNacimiento() {
-    int dia = 1 + rand() % 28;       // Día: 1 a 28 (evita problemas con meses)
-    int mes = 1 + rand() % 12;        // Mes: 1 a 12
-    int anio = 1960 + rand() % 50;    // Año: 1960 a 2009
-    return std::to_string(dia) + "/" + std::to_string(mes) + "/" + std::to_string(anio);
+std::string_view generarFechaNacimiento(ArenaCadenas& arena) {
+    int dia = 1 + enteroAleatorio(28);  // Día: 1 a 28 (evita problemas con meses)
+    int mes = 1 + enteroAleatorio(12);  // Mes: 1 a 12
+    int anio = configuracion.edades == DistribucionEdades::Piramide
+        ? ANIO_PIRAMIDE_INICIO + static_cast<int>(muestrear(acumuladaAnios, randomDouble(0.0, 1.0)))
+        : 1960 + enteroAleatorio(50);   // Año: 1960 a 2009
+
+    char* destino = arena.reservar(10);
+    return std::string_view(destino, escribirFecha(destino, dia, mes, anio));
 }
 
 /**
  * Implementación de generarID.
  * 
  * POR QUÉ: Generar identificadores únicos y secuenciales.
- * CÓMO: Contador estático que inicia en 1000000000 y se incrementa.
+ * CÓMO: Contador estático atómico que inicia en 1000000000 y se incrementa (varios
+ *       hilos pueden generar a la vez); los dígitos se escriben en la arena sin pasar
+ *       por std::to_string.
  * PARA QUÉ: Simular números de cédula.
  */
-std::string generarID() {
-    static long contador = 1000000000; // Inicia en 1,000,000,000
-    return std::to_string(contador++); // Convierte a string e incrementa
+std::string_view generarID(ArenaCadenas& arena) {
+    char texto[24];
+    char* fin = std::to_chars(texto, texto + sizeof(texto), contadorIds.fetch_add(1)).ptr;
+    return arena.guardar(std::string_view(texto, fin - texto));
 }
 
 /**
  * Implementación de randomDouble.
  * 
  * POR QUÉ: Generar números decimales aleatorios en un rango.
- * CÓMO: Mersenne Twister (mejor que rand()) y distribución uniforme.
+ * CÓMO: Mersenne Twister (mejor que rand()) y distribución uniforme. Cada hilo tiene
+ *       su propio generador; la semilla combina la hora con un número de hilo para
+ *       que hilos que arrancan en el mismo segundo no repitan la secuencia.
  * PARA QUÉ: Valores de ingresos, patrimonio, etc.
  */
 double randomDouble(double min, double max) {
-    static std::mt19937 generator(time(nullptr)); // Semilla basada en tiempo
     std::uniform_real_distribution<double> distribution(min, max);
-    return distribution(generator);
+    return distribution(generadorDelHilo());
 }
 
 /**
  * Implementación de generarPersona.
  * 
  * POR QUÉ: Crear una persona con datos aleatorios.
- * CÓMO: Seleccionando aleatoriamente de las bases de datos y generando números.
+ * CÓMO: Seleccionando aleatoriamente de las bases de datos y generando números, todo
+ *       con el Mersenne Twister del hilo (varios hilos generan sin estorbarse).
+ *       Nombre y apellidos son índices en las tablas de nombres.h, la ciudad es una
+ *       vista a la tabla estática, y el ID y la fecha se escriben en la arena.
+ *       Ninguna cadena toca el heap.
  * PARA QUÉ: Generar datos de prueba.
  */
-Persona generarPersona() {
+Persona generarPersona(ArenaCadenas& arena) {
     // Decide si es hombre o mujer
-    bool esHombre = rand() % 2;
+    bool esHombre = enteroAleatorio(2);
     
-    // Selecciona nombre según género
-    std::string nombre = esHombre ? 
-        nombresMasculinos[rand() % nombresMasculinos.size()] :
-        nombresFemeninos[rand() % nombresFemeninos.size()];
+    // Selecciona nombre según género (los masculinos van después de los femeninos)
+    uint8_t nombre = esHombre ? 
+        static_cast<uint8_t>(NOMBRES_FEMENINOS + enteroAleatorio(NOMBRES_MASCULINOS)) :
+        static_cast<uint8_t>(enteroAleatorio(NOMBRES_FEMENINOS));
     
-    // Construye apellido compuesto (dos apellidos aleatorios)
-    std::string apellido = apellidos[rand() % apellidos.size()];
-    apellido += " ";
-    apellido += apellidos[rand() % apellidos.size()];
+    // Apellido compuesto: dos índices aleatorios, el texto se resuelve al consultarlo
+    uint8_t primerApellido = static_cast<uint8_t>(enteroAleatorio(TOTAL_APELLIDOS));
+    uint8_t segundoApellido = static_cast<uint8_t>(enteroAleatorio(TOTAL_APELLIDOS));
     
     // Genera los demás atributos
-    std::string id = generarID();
-    std::string ciudad = ciudadesColombia[rand() % ciudadesColombia.size()];
-    std::string fecha = generarFechaNacimiento();
+    std::string_view id = generarID(arena);
+    size_t indiceCiudad = configuracion.ciudades == DistribucionCiudades::Zipf
+        ? muestrear(acumuladaCiudades, randomDouble(0.0, 1.0))
+        : enteroAleatorio(static_cast<int>(ciudadesColombia.size()));
+    std::string_view ciudad = ciudadesColombia[indiceCiudad];
+    std::string_view fecha = generarFechaNacimiento(arena);
     
     // Genera datos financieros realistas
-    double ingresos = randomDouble(10000000, 500000000);   // 10M a 500M COP
-    double patrimonio = randomDouble(0, 2000000000);       // 0 a 2,000M COP
+    double ingresos, patrimonio;
+    switch (configuracion.dinero) {
+        case DistribucionDinero::LogNormal:
+            ingresos = lognormal(40000000, 0.9);
+            patrimonio = lognormal(150000000, 1.2);
+            break;
+        case DistribucionDinero::Pareto:
+            ingresos = pareto(15000000, 1.8);
+            patrimonio = pareto(50000000, 1.3);
+            break;
+        default:
+            ingresos = randomDouble(10000000, 500000000);   // 10M a 500M COP
+            patrimonio = randomDouble(0, 2000000000);       // 0 a 2,000M COP
+    }
     double deudas = randomDouble(0, patrimonio * 0.7);     // Deudas hasta el 70% del patrimonio
-    bool declarante = (ingresos > 50000000) && (rand() % 100 > 30); // Probabilidad 70% si ingresos > 50M
+    bool declarante = debeDeclarar(ingresos, patrimonio, ReglasTributarias()); // Topes UVT vigentes
     
-    return Persona(nombre, apellido, id, ciudad, fecha, ingresos, patrimonio, deudas, declarante);
+    return Persona(nombre, primerApellido, segundoApellido, id, ciudad, fecha,
+                   ingresos, patrimonio, deudas, declarante);
 }
 
 /**
  * Implementación de generarColeccion.
  * 
  * POR QUÉ: Generar un conjunto de n personas.
- * CÓMO: Reservando espacio y agregando n personas generadas.
+ * CÓMO: Reservando espacio, creando una arena propia del conjunto y agregando
+ *       n personas generadas sobre ella.
  * PARA QUÉ: Crear datasets para pruebas.
  */
-std::vector<Persona> generarColeccion(int n) {
+ColeccionPersonas generarColeccion(int n) {
+    auto arena = std::make_shared<ArenaCadenas>();
     std::vector<Persona> personas;
     personas.reserve(n); // Reserva espacio para n personas (eficiencia)
     
     for (int i = 0; i < n; ++i) {
-        personas.push_back(generarPersona());
+        personas.push_back(generarPersona(*arena));
     }
     
-    return personas;
+    return ColeccionPersonas(std::move(personas), std::move(arena));
+}
+
+namespace {
+    const size_t FILAS_POR_LOTE = 1024;
+    const size_t PALABRAS_POR_FILA = 13; // Números aleatorios que consume cada fila (uno por campo)
+    std::atomic<uint64_t> lotesGenerados{0};
+    bool semillaFija = false;   // sembrarGenerador() fija también la semilla de los lotes
+    uint64_t semillaLotes = 0;
+
+    // Semilla de los lotes sin sembrarGenerador(): del sistema, una vez por proceso
+    // (time() se repite en dos corridas dentro del mismo segundo)
+    uint64_t semillaDelProceso() {
+        static const uint64_t semilla = [] {
+            std::random_device dispositivo;
+            return static_cast<uint64_t>(dispositivo()) << 32 | dispositivo();
+        }();
+        return semilla;
+    }
+
+    // Semilla del hilo h en la llamada número `llamada`: mezclar en vez de sumar, porque
+    // con base + llamada + h la llamada k, hilo h repetía la llamada k + 1, hilo h - 1
+    uint64_t semillaHilo(uint64_t base, uint64_t llamada, unsigned h) {
+        uint64_t x = base;
+        x = XoshiroCarriles::splitmix64(x) ^ llamada;
+        x = XoshiroCarriles::splitmix64(x) ^ h;
+        return XoshiroCarriles::splitmix64(x);
+    }
+
+    // Normal estándar por Box-Muller a partir de dos uniformes en [0, 1)
+    double normal(double u1, double u2) {
+        return std::sqrt(-2.0 * std::log(1.0 - u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    // Cédula como texto que se incrementa en su lugar (sin to_chars por fila)
+    struct CedulaEnCurso {
+        char digitos[24];
+        size_t largo;
+        long valor;
+
+        explicit CedulaEnCurso(long inicial) : valor(inicial) { escribir(); }
+
+        void escribir() {
+            largo = std::to_chars(digitos, digitos + sizeof(digitos), valor).ptr - digitos;
+        }
+
+        void siguiente() {
+            ++valor;
+            size_t i = largo;
+            while (i > 0 && digitos[i - 1] == '9') {
+                digitos[--i] = '0';
+            }
+            if (i == 0) {
+                escribir(); // Cambió la cantidad de dígitos
+            } else {
+                ++digitos[i - 1];
+            }
+        }
+    };
+
+    /**
+     * Genera las personas [desde, hasta) por bloques de FILAS_POR_LOTE.
+     *
+     * CÓMO: Para cada bloque llena de una vez FILAS_POR_LOTE × PALABRAS_POR_FILA números
+     *       (palabra k de la fila r en azar[k * FILAS_POR_LOTE + r]), convierte cada
+     *       columna a su rango en un ciclo propio y recién al final arma las personas,
+     *       escribiendo cédula y fecha en la arena.
+     */
+    void generarLote(std::vector<Persona>& personas, size_t desde, size_t hasta, long primeraCedula,
+                     XoshiroCarriles& azarHilo, ArenaCadenas& arena) {
+        std::vector<uint64_t> azar(FILAS_POR_LOTE * PALABRAS_POR_FILA);
+        std::vector<double> ingresos(FILAS_POR_LOTE), patrimonio(FILAS_POR_LOTE), deudas(FILAS_POR_LOTE);
+        std::vector<uint16_t> ciudades(FILAS_POR_LOTE), anios(FILAS_POR_LOTE);
+        const uint64_t* palabra[PALABRAS_POR_FILA];
+        for (size_t k = 0; k < PALABRAS_POR_FILA; ++k) {
+            palabra[k] = azar.data() + k * FILAS_POR_LOTE;
+        }
+        const uint32_t totalCiudades = static_cast<uint32_t>(ciudadesColombia.size());
+        CedulaEnCurso cedula(primeraCedula);
+
+        for (size_t inicio = desde; inicio < hasta; inicio += FILAS_POR_LOTE) {
+            const size_t filas = std::min(FILAS_POR_LOTE, hasta - inicio);
+            azarHilo.llenar(azar.data(), azar.size());
+
+            // Ciudad y año: uniformes o por tabla acumulada
+            for (size_t r = 0; r < filas; ++r) {
+                ciudades[r] = static_cast<uint16_t>(configuracion.ciudades == DistribucionCiudades::Zipf
+                    ? muestrear(acumuladaCiudades, XoshiroCarriles::aUnidad(palabra[2][r]))
+                    : XoshiroCarriles::aRango(palabra[2][r], totalCiudades));
+                anios[r] = static_cast<uint16_t>(configuracion.edades == DistribucionEdades::Piramide
+                    ? ANIO_PIRAMIDE_INICIO + muestrear(acumuladaAnios, XoshiroCarriles::aUnidad(palabra[4][r]))
+                    : 1960 + XoshiroCarriles::aRango(palabra[4][r], 50));
+            }
+
+            // Dinero: un ciclo por distribución, sin objetos de distribución
+            switch (configuracion.dinero) {
+                case DistribucionDinero::LogNormal:
+                    for (size_t r = 0; r < filas; ++r) {
+                        ingresos[r] = 40000000 * std::exp(0.9 * normal(XoshiroCarriles::aUnidad(palabra[5][r]),
+                                                                       XoshiroCarriles::aUnidad(palabra[8][r])));
+                        patrimonio[r] = 150000000 * std::exp(1.2 * normal(XoshiroCarriles::aUnidad(palabra[6][r]),
+                                                                          XoshiroCarriles::aUnidad(palabra[9][r])));
+                    }
+                    break;
+                case DistribucionDinero::Pareto:
+                    for (size_t r = 0; r < filas; ++r) {
+                        ingresos[r] = 15000000 * std::pow(1.0 - XoshiroCarriles::aUnidad(palabra[5][r]), -1.0 / 1.8);
+                        patrimonio[r] = 50000000 * std::pow(1.0 - XoshiroCarriles::aUnidad(palabra[6][r]), -1.0 / 1.3);
+                    }
+                    break;
+                default:
+                    for (size_t r = 0; r < filas; ++r) {
+                        ingresos[r] = 10000000 + 490000000 * XoshiroCarriles::aUnidad(palabra[5][r]);
+                        patrimonio[r] = 2000000000 * XoshiroCarriles::aUnidad(palabra[6][r]);
+                    }
+            }
+            for (size_t r = 0; r < filas; ++r) {
+                deudas[r] = patrimonio[r] * 0.7 * XoshiroCarriles::aUnidad(palabra[7][r]);
+            }
+
+            // Materialización: índices, textos en la arena y la persona
+            const ReglasTributarias reglas;
+            for (size_t r = 0; r < filas; ++r) {
+                // Sexo por el bit más alto; el nombre usa otra palabra para no depender de él
+                uint8_t nombre = static_cast<uint8_t>((palabra[0][r] >> 63)
+                    ? NOMBRES_FEMENINOS + XoshiroCarriles::aRango(palabra[10][r], NOMBRES_MASCULINOS)
+                    : XoshiroCarriles::aRango(palabra[10][r], NOMBRES_FEMENINOS));
+                uint8_t primerApellido = static_cast<uint8_t>(XoshiroCarriles::aRango(palabra[1][r], TOTAL_APELLIDOS));
+                uint8_t segundoApellido = static_cast<uint8_t>(XoshiroCarriles::aRango(palabra[11][r], TOTAL_APELLIDOS));
+
+                char* id = arena.reservar(cedula.largo);
+                std::copy(cedula.digitos, cedula.digitos + cedula.largo, id);
+                std::string_view vistaId(id, cedula.largo);
+                cedula.siguiente();
+
+                char* fecha = arena.reservar(10);
+                size_t largoFecha = escribirFecha(fecha, 1 + XoshiroCarriles::aRango(palabra[3][r], 28),
+                                                  1 + XoshiroCarriles::aRango(palabra[12][r], 12), anios[r]);
+
+                personas[inicio + r] = Persona(nombre, primerApellido, segundoApellido, vistaId,
+                                               ciudadesColombia[ciudades[r]], std::string_view(fecha, largoFecha),
+                                               ingresos[r], patrimonio[r], deudas[r],
+                                               debeDeclarar(ingresos[r], patrimonio[r], reglas));
+            }
+        }
+    }
+}
+
+/**
+ * Implementación de sembrarGenerador.
+ *
+ * CÓMO: srand() para rand(), la semilla del Mersenne Twister del hilo llamador, el
+ *       contador de cédulas y la semilla base de los lotes (con su contador en 0).
+ */
+void sembrarGenerador(unsigned semilla) {
+    srand(semilla);
+    generadorDelHilo().seed(semilla);
+    contadorIds = 1000000000;
+    semillaFija = true;
+    semillaLotes = semilla;
+    lotesGenerados = 0;
+}
+
+/**
+ * Implementación de generarColeccionPorLotes.
+ *
+ * CÓMO: Reserva las n cédulas de una vez (la persona i recibe la primera + i, igual
+ *       de consecutivas que con generarColeccion) y reparte el rango entre hilos; cada
+ *       hilo tiene su arena y su XoshiroCarriles, sembrado con splitmix64 sobre
+ *       (semilla base, número de llamada, hilo).
+ */
+ColeccionPersonas generarColeccionPorLotes(int n, unsigned hilos) {
+    if (n <= 0) {
+        return ColeccionPersonas();
+    }
+    std::vector<Persona> personas(n);
+    long primeraCedula = contadorIds.fetch_add(n);
+    const uint64_t base = semillaFija ? semillaLotes : semillaDelProceso();
+    const uint64_t llamada = lotesGenerados++;
+
+    hilos = hilosParaTamano(personas.size(), hilos);
+    std::vector<std::shared_ptr<ArenaCadenas>> arenas(hilos);
+    ejecutarPorBloques(personas.size(), [&](unsigned h, size_t desde, size_t hasta) {
+        arenas[h] = std::make_shared<ArenaCadenas>();
+        XoshiroCarriles azar(semillaHilo(base, llamada, h));
+        generarLote(personas, desde, hasta, primeraCedula + static_cast<long>(desde), azar, *arenas[h]);
+    }, hilos);
+
+    ColeccionPersonas coleccion(std::move(personas), arenas[0]);
+    for (size_t h = 1; h < arenas.size(); ++h) {
+        coleccion.adjuntarArena(arenas[h]);
+    }
+    return coleccion;
 }
 
 /**
@@ -148,158 +456,29 @@ const Persona* buscarPorID(const std::vector<Persona>& personas, const std::stri
 
 const Persona* buscarLongeva (const std::vector<Persona>& personas)
 {
-    if (personas.empty()) {
-        return nullptr; // Si no hay personas, retornar nullptr
-    }
-    
-    const Persona* personaMayor = &personas[0]; // Empezar con la primera persona
-    int diaMayor, mesMayor, anioMayor;
-    personaMayor->obtenerFechaNacimiento(diaMayor, mesMayor, anioMayor);
-    
-    // Recorrer todas las personas para encontrar la más mayor
-    for (size_t i = 1; i < personas.size(); ++i) {
-        int dia, mes, anio;
-        personas[i].obtenerFechaNacimiento(dia, mes, anio);
-        
-        // Comparar fechas: la persona más mayor tiene fecha de nacimiento más antigua
-        if (anio < anioMayor || 
-            (anio == anioMayor && mes < mesMayor) ||
-            (anio == anioMayor && mes == mesMayor && dia < diaMayor)) {
-            
-            personaMayor = &personas[i];
-            diaMayor = dia;
-            mesMayor = mes;
-            anioMayor = anio;
-        }
-    }
-    
-    return personaMayor;
+    // La fecha de nacimiento más antigua (clave AAAAMMDD menor)
+    return agregacion::mejor<agregacion::FechaNacimiento, std::less<>>(personas);
 }
 
 
 std::map<std::string, const Persona*> buscarLongevaPorCiudad(const std::vector<Persona>& personas) 
 {
-    std::map<std::string, const Persona*> longevasPorCiudad;
-    
-    if (personas.empty()) {
-        return longevasPorCiudad; 
-    }
-    
-    // Recorrer todas las personas
-    for (const auto& persona : personas) {
-        std::string ciudad = persona.getCiudadNacimiento();
-        
-        // Si es la primera persona de esta ciudad, o si es más longeva que la actual
-        if (longevasPorCiudad.find(ciudad) == longevasPorCiudad.end()) {
-            // Primera persona de esta ciudad
-            longevasPorCiudad[ciudad] = &persona;
-        } else {
-            // Comparar con la persona más longeva actual de esta ciudad
-            const Persona* personaActual = longevasPorCiudad[ciudad];
-            
-            // Obtener fechas de ambas personas
-            int diaActual, mesActual, anioActual;
-            int diaNueva, mesNueva, anioNueva;
-            
-            personaActual->obtenerFechaNacimiento(diaActual, mesActual, anioActual);
-            persona.obtenerFechaNacimiento(diaNueva, mesNueva, anioNueva);
-            
-            // Si la nueva persona es más longeva (fecha más antigua)
-            if (anioNueva < anioActual || 
-                (anioNueva == anioActual && mesNueva < mesActual) ||
-                (anioNueva == anioActual && mesNueva == mesActual && diaNueva < diaActual)) {
-                
-                longevasPorCiudad[ciudad] = &persona;
-            }
-        }
-    }
-    
-    return longevasPorCiudad;
+    return agregacion::mejorPorGrupo<agregacion::PorCiudad, agregacion::FechaNacimiento, std::less<>>(personas);
 }
 
 const Persona* buscarPatrimonio (const std::vector<Persona>& personas)
 {
-    if (personas.empty()) {
-        return nullptr; // Si no hay personas, retornar nullptr
-    }
-
-    const Persona* masRico = &personas[0];
-    double patrimonioMayor = masRico->getPatrimonio();
-    
-    for (size_t i = 1; i < personas.size(); ++i)
-    {
-        double patrimonioActual = personas[i].getPatrimonio();
-        if (patrimonioActual > patrimonioMayor)
-        {
-            masRico = &personas[i];
-            patrimonioMayor = patrimonioActual;
-        }
-    }
-    return masRico;
+    return agregacion::mejor<agregacion::Patrimonio, std::greater<>>(personas);
 }
 
 std::map<std::string, const Persona*> buscarPatrimonioPorCiudad(const std::vector<Persona>& personas) 
 {
-    std::map<std::string, const Persona*> patrimonioPorCiudad;
-    
-    if (personas.empty()) {
-        return patrimonioPorCiudad;
-    }
-
-    for (const auto& persona : personas) {
-        std::string ciudad = persona.getCiudadNacimiento();
-        
-        // Si es la primera persona de esta ciudad, o si es más rica que la actual
-        if (patrimonioPorCiudad.find(ciudad) == patrimonioPorCiudad.end()) {
-            // Primera persona de esta ciudad
-            patrimonioPorCiudad[ciudad] = &persona;
-        } else {
-            // Comparar con la persona más rica actual de esta ciudad
-            const Persona* personaActual = patrimonioPorCiudad[ciudad];
-            
-            double patrimonioActual = personaActual->getPatrimonio();
-            double patrimonioNuevo = persona.getPatrimonio();
-
-            // Si la nueva persona es más rica
-            if (patrimonioNuevo > patrimonioActual) {
-                patrimonioPorCiudad[ciudad] = &persona;
-            }
-        }
-    }
-
-    return patrimonioPorCiudad;
+    return agregacion::mejorPorGrupo<agregacion::PorCiudad, agregacion::Patrimonio, std::greater<>>(personas);
 }
 
 std::map<char, const Persona*> buscarPatrimonioPorCalendario(const std::vector<Persona>& personas) 
 {
-    std::map<char, const Persona*> patrimonioPorCalendario;
-    
-    if (personas.empty()) {
-        return patrimonioPorCalendario;
-    }
-
-    for (const auto& persona : personas) {
-        char calendario = persona.getCalendarioTributario();
-        
-        // Si es la primera persona de este calendario, o si es más rica que la actual
-        if (patrimonioPorCalendario.find(calendario) == patrimonioPorCalendario.end()) {
-            // Primera persona de este calendario
-            patrimonioPorCalendario[calendario] = &persona;
-        } else {
-            // Comparar con la persona más rica actual de este calendario
-            const Persona* personaActual = patrimonioPorCalendario[calendario];
-            
-            double patrimonioActual = personaActual->getPatrimonio();
-            double patrimonioNuevo = persona.getPatrimonio();
-
-            // Si la nueva persona es más rica
-            if (patrimonioNuevo > patrimonioActual) {
-                patrimonioPorCalendario[calendario] = &persona;
-            }
-        }
-    }
-
-    return patrimonioPorCalendario;
+    return agregacion::mejorPorGrupo<agregacion::PorCalendario, agregacion::Patrimonio, std::greater<>>(personas);
 }
 
 void listarPersonasCalendario(const std::vector<Persona>& personas)
@@ -383,6 +562,43 @@ void listarPersonasCalendario(const std::vector<Persona>& personas)
 // PREGUNTAS OPCIONALES
 
 
+namespace {
+    /**
+     * Ordena las ciudades por patrimonio promedio y muestra las tres primeras.
+     *
+     * POR QUÉ: La versión por apuntador y la por valor solo difieren en cómo reciben el
+     *          conjunto; la presentación es la misma.
+     * CÓMO: Copia los promedios a un vector y lo ordena de mayor a menor.
+     * PARA QUÉ: Un solo lugar para el formato del reporte.
+     */
+    void mostrarTop3Ciudades(const std::map<std::string, agregacion::Suma>& sumas) {
+        std::vector<std::pair<std::string, agregacion::Suma>> listaCiudades(sumas.begin(), sumas.end());
+        std::sort(listaCiudades.begin(), listaCiudades.end(),
+            [](const auto& a, const auto& b) { return a.second.promedio() > b.second.promedio(); });
+
+        std::cout << "\nTOP 3 CIUDADES CON MAYOR PATRIMONIO PROMEDIO\n";
+        std::cout << "=" << std::string(65, '=') << "\n\n";
+
+        // Determinar cuántas ciudades mostrar (máximo 3, o menos si hay pocas ciudades)
+        int limite = std::min(3, static_cast<int>(listaCiudades.size()));
+        for (int i = 0; i < limite; i++) {
+            const auto& [nombre, suma] = listaCiudades[i];
+            std::cout << " #" << (i + 1) << " - " << nombre << "\n";
+            std::cout << "    Patrimonio Promedio: $" << std::fixed << std::setprecision(2)
+                      << suma.promedio() << " COP\n";
+            std::cout << "    Personas en la ciudad: " << suma.conteo << "\n";
+            std::cout << "    Patrimonio Total: $" << std::fixed << std::setprecision(2)
+                      << suma.total << " COP\n";
+
+            // Separador visual entre ciudades (excepto para la última)
+            if (i < limite - 1) {
+                std::cout << "   " << std::string(50, '-') << "\n";
+            }
+            std::cout << "\n";
+        }
+    }
+}
+
 // Tres ciudades con mayor patrimonio promedio
 void top3CiudadesPatrimonio(const std::vector<Persona>& personas)
 {
@@ -390,134 +606,22 @@ void top3CiudadesPatrimonio(const std::vector<Persona>& personas)
         std::cout << "\nNo hay personas para analizar.\n";
         return;
     }
-
-    // Estructura para organizar información estadística por ciudad
-    struct DatosCiudad {
-        std::string nombre;           // Nombre de la ciudad
-        double patrimonioTotal;       // Suma de todos los patrimonios en la ciudad
-        int numeroPersonas;           // Contador de personas en la ciudad  
-        double patrimonioPromedio;    // Valor calculado: patrimonioTotal / numeroPersonas
-    };
-
-    // Contenedor asociativo para agrupar automáticamente por ciudad
-    // La clave es el nombre de la ciudad, el valor es la estructura de datos
-    std::map<std::string, DatosCiudad> ciudades;
-
-    // FASE 1: Recorrido único de los datos para acumular estadísticas por ciudad
-    for (const auto& persona : personas) {
-        std::string ciudad = persona.getCiudadNacimiento();
-        double patrimonio = persona.getPatrimonio();
-        
-        // Verificar si es la primera persona de esta ciudad
-        if (ciudades.find(ciudad) == ciudades.end()) {
-            // Inicializar entrada nueva: primera persona de esta ciudad
-            ciudades[ciudad] = {ciudad, patrimonio, 1, 0.0};
-        } else {
-            // Acumular datos: agregar patrimonio y incrementar contador
-            ciudades[ciudad].patrimonioTotal += patrimonio;
-            ciudades[ciudad].numeroPersonas++;
-        }
-    }
-
-    // FASE 2: Calcular promedios y preparar para ordenamiento
-    // Transferir del mapa a vector para permitir ordenamiento eficiente
-    std::vector<DatosCiudad> listaCiudades;
-    listaCiudades.reserve(ciudades.size()); // Reservar memoria para eficiencia
-    
-    for (auto& [nombreCiudad, datos] : ciudades) {
-        // Calcular promedio: total acumulado / número de personas
-        datos.patrimonioPromedio = datos.patrimonioTotal / datos.numeroPersonas;
-        listaCiudades.push_back(datos);
-    }
-
-    // FASE 3: Ordenamiento descendente por patrimonio promedio
-    // Utiliza algoritmo de ordenamiento optimizado (puede ser QuickSort o IntroSort)
-    std::sort(listaCiudades.begin(), listaCiudades.end(),
-        [](const DatosCiudad& a, const DatosCiudad& b) {
-            // Función lambda para comparación: ordenar de mayor a menor promedio
-            return a.patrimonioPromedio > b.patrimonioPromedio;
-        });
-
-    // FASE 4: Presentación de resultados con formato profesional
-    std::cout << "\nTOP 3 CIUDADES CON MAYOR PATRIMONIO PROMEDIO\n";
-    std::cout << "=" << std::string(65, '=') << "\n\n";
-
-    // Determinar cuántas ciudades mostrar (máximo 3, o menos si hay pocas ciudades)
-    int limite = std::min(3, static_cast<int>(listaCiudades.size()));
-    
-    // Iterar sobre las ciudades con mayor patrimonio promedio
-    for (int i = 0; i < limite; i++) {
-        const auto& ciudad = listaCiudades[i];
-        
-        // Mostrar información detallada de cada ciudad
-        std::cout << " #" << (i + 1) << " - " << ciudad.nombre << "\n";
-        std::cout << "    Patrimonio Promedio: $" << std::fixed << std::setprecision(2) 
-                  << ciudad.patrimonioPromedio << " COP\n";
-        std::cout << "    Personas en la ciudad: " << ciudad.numeroPersonas << "\n";
-        std::cout << "    Patrimonio Total: $" << std::fixed << std::setprecision(2) 
-                  << ciudad.patrimonioTotal << " COP\n";
-        
-        // Separador visual entre ciudades (excepto para la última)
-        if (i < limite - 1) {
-            std::cout << "   " << std::string(50, '-') << "\n";
-        }
-        std::cout << "\n";
-    }
+    mostrarTop3Ciudades(agregacion::sumarPorGrupo<agregacion::PorCiudad, agregacion::Patrimonio>(personas));
 }
 
 
 // Persona con más deudas
 const Persona* buscarDeudas (const std::vector<Persona>& personas)
 {
-    if (personas.empty()) 
-    {
-        return nullptr; // Si no hay personas, retornar nullptr
-    }
-
-    const Persona* personaEndeudada = &personas[0];
-    double deuda = personaEndeudada->getDeudas();
-
-    for (size_t i = 1; i < personas.size(); i++)
-    {
-        double deudaActual = personas[i].getDeudas();
-        if (deudaActual > deuda)
-        {
-            personaEndeudada = &personas[i];
-            deuda = deudaActual;
-        }
-    }
-
-    return personaEndeudada;
+    return agregacion::mejor<agregacion::Deudas, std::greater<>>(personas);
 }
 
 
 // Persona con el nombre y apellido más largo de todos
 const Persona* buscarNombreMasLargo (const std::vector<Persona>& personas)
 {
-    if (personas.empty()) 
-    {
-        return nullptr; // Si no hay personas, retornar nullptr
-    }
-
-    const Persona* personaNombreLargo = &personas[0];
-    int lonNombre = personaNombreLargo->getNombre().size();
-    int lonApellido = personaNombreLargo->getApellido().size();
-    int tamano = lonNombre + lonApellido;
-
-    for (size_t i = 1; i < personas.size(); i++)
-    {
-        int lonNombreActual = personas[i].getNombre().size();
-        int lonApellidoActual = personas[i].getApellido().size();
-        int tamanoActual = lonNombreActual + lonApellidoActual;
-
-        if (tamanoActual > tamano)
-        {
-            personaNombreLargo = &personas[i];
-            tamano = tamanoActual;
-        }
-    }
-
-    return personaNombreLargo;
+    // Las longitudes salen de tablas precalculadas por índice: no se resuelve ningún texto
+    return agregacion::mejor<agregacion::LargoNombre, std::greater<>>(personas);
 }
 
 // ============= FUNCIONES CON PASO POR VALOR =============
@@ -529,7 +633,7 @@ const Persona* buscarNombreMasLargo (const std::vector<Persona>& personas)
  * CÓMO: Usando un algoritmo de búsqueda secuencial (lineal).
  * PARA QUÉ: Para operaciones de búsqueda en la aplicación con paso por valor.
  */
-Persona buscarPorIDValor(std::vector<Persona> personas, std::string id) {
+Persona buscarPorIDValor(ColeccionPersonas personas, std::string id) {
     // Usa find_if con una lambda para buscar por ID
     auto it = std::find_if(personas.begin(), personas.end(),
         [&id](const Persona& p) { return p.getId() == id; });
@@ -548,33 +652,8 @@ Persona buscarPorIDValor(std::vector<Persona> personas, std::string id) {
  * CÓMO: Comparando fechas de nacimiento de todas las personas.
  * PARA QUÉ: Para análisis demográfico con paso por valor.
  */
-Persona buscarLongevaValor(std::vector<Persona> personas) {
-    if (personas.empty()) {
-        return Persona(); // Si no hay personas, retornar persona vacía
-    }
-    
-    Persona personaMayor = personas[0]; // Empezar con la primera persona
-    int diaMayor, mesMayor, anioMayor;
-    personaMayor.obtenerFechaNacimiento(diaMayor, mesMayor, anioMayor);
-    
-    // Recorrer todas las personas para encontrar la más mayor
-    for (size_t i = 1; i < personas.size(); ++i) {
-        int dia, mes, anio;
-        personas[i].obtenerFechaNacimiento(dia, mes, anio);
-        
-        // Comparar fechas: la persona más mayor tiene fecha de nacimiento más antigua
-        if (anio < anioMayor || 
-            (anio == anioMayor && mes < mesMayor) ||
-            (anio == anioMayor && mes == mesMayor && dia < diaMayor)) {
-            
-            personaMayor = personas[i];
-            diaMayor = dia;
-            mesMayor = mes;
-            anioMayor = anio;
-        }
-    }
-    
-    return personaMayor;
+Persona buscarLongevaValor(ColeccionPersonas personas) {
+    return agregacion::copiar(agregacion::mejor<agregacion::FechaNacimiento, std::less<>>(personas.datos()));
 }
 
 /**
@@ -584,43 +663,9 @@ Persona buscarLongevaValor(std::vector<Persona> personas) {
  * CÓMO: Agrupando por ciudad y comparando fechas de nacimiento.
  * PARA QUÉ: Para análisis demográfico por ciudad con paso por valor.
  */
-std::map<std::string, Persona> buscarLongevaPorCiudadValor(std::vector<Persona> personas) {
-    std::map<std::string, Persona> longevasPorCiudad;
-    
-    if (personas.empty()) {
-        return longevasPorCiudad; 
-    }
-    
-    // Recorrer todas las personas
-    for (const auto& persona : personas) {
-        std::string ciudad = persona.getCiudadNacimiento();
-        
-        // Si es la primera persona de esta ciudad, o si es más longeva que la actual
-        if (longevasPorCiudad.find(ciudad) == longevasPorCiudad.end()) {
-            // Primera persona de esta ciudad
-            longevasPorCiudad[ciudad] = persona;
-        } else {
-            // Comparar con la persona más longeva actual de esta ciudad
-            Persona personaActual = longevasPorCiudad[ciudad];
-            
-            // Obtener fechas de ambas personas
-            int diaActual, mesActual, anioActual;
-            int diaNueva, mesNueva, anioNueva;
-            
-            personaActual.obtenerFechaNacimiento(diaActual, mesActual, anioActual);
-            persona.obtenerFechaNacimiento(diaNueva, mesNueva, anioNueva);
-            
-            // Si la nueva persona es más longeva (fecha más antigua)
-            if (anioNueva < anioActual || 
-                (anioNueva == anioActual && mesNueva < mesActual) ||
-                (anioNueva == anioActual && mesNueva == mesActual && diaNueva < diaActual)) {
-                
-                longevasPorCiudad[ciudad] = persona;
-            }
-        }
-    }
-    
-    return longevasPorCiudad;
+std::map<std::string, Persona> buscarLongevaPorCiudadValor(ColeccionPersonas personas) {
+    return agregacion::copiar(agregacion::mejorPorGrupo<agregacion::PorCiudad, agregacion::FechaNacimiento,
+                                                        std::less<>>(personas.datos()));
 }
 
 /**
@@ -630,22 +675,8 @@ std::map<std::string, Persona> buscarLongevaPorCiudadValor(std::vector<Persona>
  * CÓMO: Comparando patrimonio de todas las personas.
  * PARA QUÉ: Para análisis financiero con paso por valor.
  */
-Persona buscarPatrimonioValor(std::vector<Persona> personas) {
-    if (personas.empty()) {
-        return Persona(); // Si no hay personas, retornar persona vacía
-    }
-
-    Persona masRico = personas[0];
-    double patrimonioMayor = masRico.getPatrimonio();
-    
-    for (size_t i = 1; i < personas.size(); ++i) {
-        double patrimonioActual = personas[i].getPatrimonio();
-        if (patrimonioActual > patrimonioMayor) {
-            masRico = personas[i];
-            patrimonioMayor = patrimonioActual;
-        }
-    }
-    return masRico;
+Persona buscarPatrimonioValor(ColeccionPersonas personas) {
+    return agregacion::copiar(agregacion::mejor<agregacion::Patrimonio, std::greater<>>(personas.datos()));
 }
 
 /**
@@ -655,35 +686,9 @@ Persona buscarPatrimonioValor(std::vector<Persona> personas) {
  * CÓMO: Agrupando por ciudad y comparando patrimonio.
  * PARA QUÉ: Para análisis financiero por ciudad con paso por valor.
  */
-std::map<std::string, Persona> buscarPatrimonioPorCiudadValor(std::vector<Persona> personas) {
-    std::map<std::string, Persona> patrimonioPorCiudad;
-    
-    if (personas.empty()) {
-        return patrimonioPorCiudad;
-    }
-
-    for (const auto& persona : personas) {
-        std::string ciudad = persona.getCiudadNacimiento();
-        
-        // Si es la primera persona de esta ciudad, o si es más rica que la actual
-        if (patrimonioPorCiudad.find(ciudad) == patrimonioPorCiudad.end()) {
-            // Primera persona de esta ciudad
-            patrimonioPorCiudad[ciudad] = persona;
-        } else {
-            // Comparar con la persona más rica actual de esta ciudad
-            Persona personaActual = patrimonioPorCiudad[ciudad];
-            
-            double patrimonioActual = personaActual.getPatrimonio();
-            double patrimonioNuevo = persona.getPatrimonio();
-
-            // Si la nueva persona es más rica
-            if (patrimonioNuevo > patrimonioActual) {
-                patrimonioPorCiudad[ciudad] = persona;
-            }
-        }
-    }
-
-    return patrimonioPorCiudad;
+std::map<std::string, Persona> buscarPatrimonioPorCiudadValor(ColeccionPersonas personas) {
+    return agregacion::copiar(agregacion::mejorPorGrupo<agregacion::PorCiudad, agregacion::Patrimonio,
+                                                        std::greater<>>(personas.datos()));
 }
 
 /**
@@ -693,35 +698,9 @@ std::map<std::string, Persona> buscarPatrimonioPorCiudadValor(std::vector<Person
  * CÓMO: Agrupando por calendario tributario y comparando patrimonio.
  * PARA QUÉ: Para análisis financiero por calendario con paso por valor.
  */
-std::map<char, Persona> buscarPatrimonioPorCalendarioValor(std::vector<Persona> personas) {
-    std::map<char, Persona> patrimonioPorCalendario;
-    
-    if (personas.empty()) {
-        return patrimonioPorCalendario;
-    }
-
-    for (const auto& persona : personas) {
-        char calendario = persona.getCalendarioTributario();
-        
-        // Si es la primera persona de este calendario, o si es más rica que la actual
-        if (patrimonioPorCalendario.find(calendario) == patrimonioPorCalendario.end()) {
-            // Primera persona de este calendario
-            patrimonioPorCalendario[calendario] = persona;
-        } else {
-            // Comparar con la persona más rica actual de este calendario
-            Persona personaActual = patrimonioPorCalendario[calendario];
-            
-            double patrimonioActual = personaActual.getPatrimonio();
-            double patrimonioNuevo = persona.getPatrimonio();
-
-            // Si la nueva persona es más rica
-            if (patrimonioNuevo > patrimonioActual) {
-                patrimonioPorCalendario[calendario] = persona;
-            }
-        }
-    }
-
-    return patrimonioPorCalendario;
+std::map<char, Persona> buscarPatrimonioPorCalendarioValor(ColeccionPersonas personas) {
+    return agregacion::copiar(agregacion::mejorPorGrupo<agregacion::PorCalendario, agregacion::Patrimonio,
+                                                        std::greater<>>(personas.datos()));
 }
 
 /**
@@ -731,7 +710,7 @@ std::map<char, Persona> buscarPatrimonioPorCalendarioValor(std::vector<Persona>
  * CÓMO: Agrupando personas por calendario y mostrando solo declarantes.
  * PARA QUÉ: Para análisis tributario con paso por valor.
  */
-void listarPersonasCalendarioValor(std::vector<Persona> personas) {
+void listarPersonasCalendarioValor(ColeccionPersonas personas) {
     if (personas.empty()) {
         std::cout << "\nNo hay personas para mostrar.\n";
         return;
@@ -810,84 +789,12 @@ void listarPersonasCalendarioValor(std::vector<Persona> personas) {
  * CÓMO: Agrupando por ciudad, calculando promedios y ordenando.
  * PARA QUÉ: Para análisis financiero por ciudad con paso por valor.
  */
-void top3CiudadesPatrimonioValor(std::vector<Persona> personas) {
+void top3CiudadesPatrimonioValor(ColeccionPersonas personas) {
     if (personas.empty()) {
         std::cout << "\nNo hay personas para analizar.\n";
         return;
     }
-
-    // Estructura para organizar información estadística por ciudad
-    struct DatosCiudad {
-        std::string nombre;           // Nombre de la ciudad
-        double patrimonioTotal;       // Suma de todos los patrimonios en la ciudad
-        int numeroPersonas;           // Contador de personas en la ciudad  
-        double patrimonioPromedio;    // Valor calculado: patrimonioTotal / numeroPersonas
-    };
-
-    // Contenedor asociativo para agrupar automáticamente por ciudad
-    // La clave es el nombre de la ciudad, el valor es la estructura de datos
-    std::map<std::string, DatosCiudad> ciudades;
-
-    // FASE 1: Recorrido único de los datos para acumular estadísticas por ciudad
-    for (const auto& persona : personas) {
-        std::string ciudad = persona.getCiudadNacimiento();
-        double patrimonio = persona.getPatrimonio();
-        
-        // Verificar si es la primera persona de esta ciudad
-        if (ciudades.find(ciudad) == ciudades.end()) {
-            // Inicializar entrada nueva: primera persona de esta ciudad
-            ciudades[ciudad] = {ciudad, patrimonio, 1, 0.0};
-        } else {
-            // Acumular datos: agregar patrimonio y incrementar contador
-            ciudades[ciudad].patrimonioTotal += patrimonio;
-            ciudades[ciudad].numeroPersonas++;
-        }
-    }
-
-    // FASE 2: Calcular promedios y preparar para ordenamiento
-    // Transferir del mapa a vector para permitir ordenamiento eficiente
-    std::vector<DatosCiudad> listaCiudades;
-    listaCiudades.reserve(ciudades.size()); // Reservar memoria para eficiencia
-    
-    for (auto& [nombreCiudad, datos] : ciudades) {
-        // Calcular promedio: total acumulado / número de personas
-        datos.patrimonioPromedio = datos.patrimonioTotal / datos.numeroPersonas;
-        listaCiudades.push_back(datos);
-    }
-
-    // FASE 3: Ordenamiento descendente por patrimonio promedio
-    // Utiliza algoritmo de ordenamiento optimizado (puede ser QuickSort o IntroSort)
-    std::sort(listaCiudades.begin(), listaCiudades.end(),
-        [](const DatosCiudad& a, const DatosCiudad& b) {
-            // Función lambda para comparación: ordenar de mayor a menor promedio
-            return a.patrimonioPromedio > b.patrimonioPromedio;
-        });
-
-    // FASE 4: Presentación de resultados con formato profesional
-    std::cout << "\nTOP 3 CIUDADES CON MAYOR PATRIMONIO PROMEDIO\n";
-    std::cout << "=" << std::string(65, '=') << "\n\n";
-
-    // Determinar cuántas ciudades mostrar (máximo 3, o menos si hay pocas ciudades)
-    int limite = std::min(3, static_cast<int>(listaCiudades.size()));
-    
-    // Iterar sobre las ciudades con mayor patrimonio promedio
-    for (int i = 0; i < limite; i++) {
-        const auto& ciudad = listaCiudades[i];
-        
-        // Mostrar información detallada de cada ciudad
-        std::cout << " #" << (i + 1) << " - " << ciudad.nombre << "\n";
-        std::cout << "    Patrimonio Promedio: $" << std::fixed << std::setprecision(2) 
-                  << ciudad.patrimonioPromedio << " COP\n";
-        std::cout << "    Personas en la ciudad: " << ciudad.numeroPersonas << "\n";
-        std::cout << "    Patrimonio Total: $" << std::fixed << std::setprecision(2) 
-                  << ciudad.patrimonioTotal << " COP\n";
-        
-        // Separador visual entre ciudades (excepto para la última)
-        if (i < limite - 1) {
-            std::cout << "   " << std::string(50, '-') << "\n";
-        }
-        std::cout << "\n";
-    }
+    mostrarTop3Ciudades(agregacion::sumarPorGrupo<agregacion::PorCiudad, agregacion::Patrimonio>(personas.datos()));
 }
 
 /**
@@ -897,23 +804,8 @@ void top3CiudadesPatrimonioValor(std::vector<Persona> personas) {
  * CÓMO: Comparando deudas de todas las personas.
  * PARA QUÉ: Para análisis financiero con paso por valor.
  */
-Persona buscarDeudasValor(std::vector<Persona> personas) {
-    if (personas.empty()) {
-        return Persona(); // Si no hay personas, retornar persona vacía
-    }
-
-    Persona personaEndeudada = personas[0];
-    double deuda = personaEndeudada.getDeudas();
-
-    for (size_t i = 1; i < personas.size(); i++) {
-        double deudaActual = personas[i].getDeudas();
-        if (deudaActual > deuda) {
-            personaEndeudada = personas[i];
-            deuda = deudaActual;
-        }
-    }
-
-    return personaEndeudada;
+Persona buscarDeudasValor(ColeccionPersonas personas) {
+    return agregacion::copiar(agregacion::mejor<agregacion::Deudas, std::greater<>>(personas.datos()));
 }
 
 /**
@@ -923,26 +815,6 @@ Persona buscarDeudasValor(std::vector<Persona> personas) {
  * CÓMO: Comparando longitud de nombres y apellidos de todas las personas.
  * PARA QUÉ: Para análisis de datos con paso por valor.
  */
-Persona buscarNombreMasLargoValor(std::vector<Persona> personas) {
-    if (personas.empty()) {
-        return Persona(); // Si no hay personas, retornar persona vacía
-    }
-
-    Persona personaNombreLargo = personas[0];
-    int lonNombre = personaNombreLargo.getNombre().size();
-    int lonApellido = personaNombreLargo.getApellido().size();
-    int tamano = lonNombre + lonApellido;
-
-    for (size_t i = 1; i < personas.size(); i++) {
-        int lonNombreActual = personas[i].getNombre().size();
-        int lonApellidoActual = personas[i].getApellido().size();
-        int tamanoActual = lonNombreActual + lonApellidoActual;
-
-        if (tamanoActual > tamano) {
-            personaNombreLargo = personas[i];
-            tamano = tamanoActual;
-        }
-    }
-
-    return personaNombreLargo;
+Persona buscarNombreMasLargoValor(ColeccionPersonas personas) {
+    return agregacion::copiar(agregacion::mejor<agregacion::LargoNombre, std::greater<>>(personas.datos()));
 }
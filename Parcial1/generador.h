@@ -2,19 +2,72 @@
 #define GENERADOR_H
 
 #include "persona.h"
+#include "coleccion.h"
+#include "arena.h"
+#include "paralelo.h"
 #include <vector>
+#include <string_view>
 #include <map>
+#include <string>
 
 // Funciones para generación de datos aleatorios
 
+// Distribuciones seleccionables del generador (ver configurarGenerador)
+enum class DistribucionCiudades { Uniforme, Zipf };
+enum class DistribucionDinero { Uniforme, LogNormal, Pareto };
+enum class DistribucionEdades { Uniforme, Piramide };
+
+struct ConfiguracionGenerador {
+    DistribucionCiudades ciudades = DistribucionCiudades::Uniforme;
+    double exponenteZipf = 1.0;  // s: la ciudad de rango k recibe peso 1/k^s
+    DistribucionDinero dinero = DistribucionDinero::Uniforme;
+    DistribucionEdades edades = DistribucionEdades::Uniforme;
+};
+
+/**
+ * Elige las distribuciones con que se generan ciudades, dinero y edades.
+ *
+ * POR QUÉ: Con ciudades uniformes y dinero uniforme en rangos fijos no aparecen los
+ *          problemas de los datos reales: una ciudad enorme, riqueza de cola pesada,
+ *          claves calientes en las agrupaciones y particiones desbalanceadas.
+ * CÓMO: Guarda la configuración y precalcula las tablas acumuladas (Zipf sobre las
+ *       ciudades en el orden de la tabla, pirámide de edades por año de nacimiento)
+ *       que generarPersona muestrea con una búsqueda binaria. Dinero:
+ *       - LogNormal: mediana de 40M (ingresos) y 150M (patrimonio) COP.
+ *       - Pareto: mínimo 15M / 50M COP con alfa 1.8 / 1.3 (el 1 % más rico concentra
+ *         buena parte del total).
+ *       Pirámide: nacidos 1925-2009 con peso constante hasta los 45 años y
+ *       decreciente (exponencial) después.
+ * PARA QUÉ: Medir agregaciones por ciudad y particionado paralelo bajo sesgo.
+ *
+ * No debe llamarse mientras otro hilo está generando personas.
+ */
+void configurarGenerador(const ConfiguracionGenerador& configuracion);
+const ConfiguracionGenerador& configuracionGenerador();
+
+// Descripción legible, p. ej. "ciudades zipf(1.2), dinero pareto, edades pirámide"
+std::string describirConfiguracion(const ConfiguracionGenerador& configuracion);
+
 /**
- * Genera una fecha de nacimiento aleatoria entre 1960 y 2010.
+ * Fija la semilla de todos los generadores aleatorios y reinicia las cédulas.
+ *
+ * POR QUÉ: Las mediciones comparables entre corridas (puerta de regresión) necesitan
+ *          el mismo conjunto cada vez, y el generador se siembra con la hora.
+ * PARA QUÉ: Después de sembrarGenerador(s), generarColeccion(n) en el mismo hilo y
+ *           generarColeccionPorLotes(n, h) con los mismos h producen el mismo conjunto.
+ */
+void sembrarGenerador(unsigned semilla);
+
+/**
+ * Genera una fecha de nacimiento aleatoria entre 1960 y 2010 (1925-2009 con la
+ * pirámide de edades).
  * 
  * POR QUÉ: Simular fechas realistas para personas.
  * CÓMO: Combinando números aleatorios para día, mes y año.
  * PARA QUÉ: Inicializar el atributo fechaNacimiento de Persona.
+ * @return Vista sobre el texto "d/m/aaaa" guardado en la arena.
  */
-std::string generarFechaNacimiento();
+std::string_view generarFechaNacimiento(ArenaCadenas& arena);
 
 /**
  * Genera un ID único secuencial.
@@ -23,7 +76,7 @@ std::string generarFechaNacimiento();
  * CÓMO: Usando un contador estático que incrementa en cada llamada.
  * PARA QUÉ: Garantizar unicidad en los IDs.
  */
-std::string generarID();
+std::string_view generarID(ArenaCadenas& arena);
 
 /**
  * Genera un número decimal aleatorio en un rango [min, max].
@@ -40,17 +93,35 @@ double randomDouble(double min, double max);
  * POR QUÉ: Automatizar la creación de registros de personas.
  * CÓMO: Combinando las funciones generadoras y bases de datos de nombres, apellidos, etc.
  * PARA QUÉ: Poblar el sistema con datos de prueba.
+ * @param arena Arena donde se escriben las cadenas que no vienen de las tablas
+ *              (apellido compuesto, ID y fecha). Debe vivir tanto como la Persona.
  */
-Persona generarPersona();
+Persona generarPersona(ArenaCadenas& arena);
 
 /**
- * Genera una colección (vector) de n personas.
+ * Genera una colección de n personas.
  * 
  * POR QUÉ: Crear conjuntos de datos de diferentes tamaños.
- * CÓMO: Llamando a generarPersona() n veces.
+ * CÓMO: Llamando a generarPersona() n veces sobre una arena nueva, que queda
+ *       en manos de la colección junto con las personas.
  * PARA QUÉ: Pruebas de rendimiento y funcionalidad con volúmenes variables.
+ *           Liberar el conjunto libera la arena completa de una vez.
+ */
+ColeccionPersonas generarColeccion(int n);
+
+/**
+ * Genera n personas por lotes con un generador xoshiro256+ de varios carriles.
+ *
+ * POR QUÉ: generarPersona arma una distribución nueva y saca un número del Mersenne
+ *          Twister por campo, y decide cada campo fila por fila.
+ * CÓMO: Llena bloques de 1024 filas × 10 números aleatorios de una vez (ver xoshiro.h),
+ *       convierte cada columna a su rango con multiplicaciones en ciclos sin saltos y
+ *       escribe cédulas y fechas en la arena sin asignar nada por fila: la cédula es un
+ *       texto que se incrementa en su lugar. Respeta la configuración de distribuciones.
+ * PARA QUÉ: Generar conjuntos grandes varias veces más rápido que generarColeccion,
+ *           también en paralelo (un generador y una arena por hilo).
  */
-std::vector<Persona> generarColeccion(int n);
+ColeccionPersonas generarColeccionPorLotes(int n, unsigned hilos = numeroHilos());
 
 /**
  * Busca una persona por ID en un vector de personas.
@@ -99,45 +170,49 @@ const Persona* buscarDeudas (const std::vector<Persona>& personas);
 const Persona* buscarNombreMasLargo (const std::vector<Persona>& personas);
 
 // ============= FUNCIONES CON PASO POR VALOR =============
+//
+// Reciben un ColeccionPersonas por valor: la copia del parámetro solo incrementa
+// el contador de referencias del buffer compartido (copy-on-write), de modo que
+// conservan la semántica de valor sin copiar las personas en cada llamada.
 
 /**
  * Busca una persona por ID usando PASO POR VALOR
  */
-Persona buscarPorIDValor(std::vector<Persona> personas, std::string id);
+Persona buscarPorIDValor(ColeccionPersonas personas, std::string id);
 
 /**
  * Busca la persona más longeva usando PASO POR VALOR
  */
-Persona buscarLongevaValor(std::vector<Persona> personas);
+Persona buscarLongevaValor(ColeccionPersonas personas);
 
 /**
  * Busca longevas por ciudad usando PASO POR VALOR
  */
-std::map<std::string, Persona> buscarLongevaPorCiudadValor(std::vector<Persona> personas);
+std::map<std::string, Persona> buscarLongevaPorCiudadValor(ColeccionPersonas personas);
 
 /**
  * Busca mayor patrimonio usando PASO POR VALOR
  */
-Persona buscarPatrimonioValor(std::vector<Persona> personas);
+Persona buscarPatrimonioValor(ColeccionPersonas personas);
 
 /**
  * Busca patrimonio por ciudad usando PASO POR VALOR
  */
-std::map<std::string, Persona> buscarPatrimonioPorCiudadValor(std::vector<Persona> personas);
+std::map<std::string, Persona> buscarPatrimonioPorCiudadValor(ColeccionPersonas personas);
 
 /**
  * Busca patrimonio por calendario usando PASO POR VALOR
  */
-std::map<char, Persona> buscarPatrimonioPorCalendarioValor(std::vector<Persona> personas);
+std::map<char, Persona> buscarPatrimonioPorCalendarioValor(ColeccionPersonas personas);
 
 /**
  * Lista personas por calendario usando PASO POR VALOR
  */
-void listarPersonasCalendarioValor(std::vector<Persona> personas);
+void listarPersonasCalendarioValor(ColeccionPersonas personas);
 
 // Preguntas opcionales con PASO POR VALOR
-void top3CiudadesPatrimonioValor(std::vector<Persona> personas);
-Persona buscarDeudasValor(std::vector<Persona> personas);
-Persona buscarNombreMasLargoValor(std::vector<Persona> personas);
+void top3CiudadesPatrimonioValor(ColeccionPersonas personas);
+Persona buscarDeudasValor(ColeccionPersonas personas);
+Persona buscarNombreMasLargoValor(ColeccionPersonas personas);
 
 #endif // GENERADOR_H
\ No newline at end of file
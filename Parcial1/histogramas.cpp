@@ -0,0 +1,185 @@
+#include "histogramas.h"
+#include "agrupamiento.h" // DiccionarioCiudades
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+namespace {
+    const size_t CONTADORES_POR_CIUDAD = 2 * (CUBETAS_EDAD + CUBETAS_PATRIMONIO);
+    const int ANCHO_BARRA = 30;
+
+    // Año de "d/m/aaaa": los cuatro últimos caracteres, sin recorrer día y mes
+    int anioNacimiento(std::string_view fecha) {
+        if (fecha.size() < 4) {
+            return 0;
+        }
+        const char* a = fecha.data() + fecha.size() - 4;
+        return (a[0] - '0') * 1000 + (a[1] - '0') * 100 + (a[2] - '0') * 10 + (a[3] - '0');
+    }
+
+    std::string rangoEdad(size_t cubeta) {
+        int desde = static_cast<int>(cubeta) * ANCHO_EDAD;
+        return cubeta + 1 == CUBETAS_EDAD ? std::to_string(desde) + "+"
+                                          : std::to_string(desde) + "-" + std::to_string(desde + ANCHO_EDAD - 1);
+    }
+
+    std::string barra(uint64_t valor, uint64_t maximo) {
+        return std::string(maximo ? static_cast<size_t>(valor * ANCHO_BARRA / maximo) : 0, '#');
+    }
+}
+
+uint64_t HistogramaGrupo::total() const {
+    uint64_t suma = 0;
+    for (const auto& sexo : edades) {
+        for (uint64_t conteo : sexo) {
+            suma += conteo;
+        }
+    }
+    return suma;
+}
+
+void HistogramaGrupo::combinar(const HistogramaGrupo& otro) {
+    for (int s = 0; s < 2; ++s) {
+        for (size_t c = 0; c < CUBETAS_EDAD; ++c) {
+            edades[s][c] += otro.edades[s][c];
+        }
+        for (size_t c = 0; c < CUBETAS_PATRIMONIO; ++c) {
+            patrimonio[s][c] += otro.patrimonio[s][c];
+        }
+    }
+}
+
+/**
+ * Implementación de construirHistogramas.
+ *
+ * CÓMO: Los contadores de una ciudad son CONTADORES_POR_CIUDAD enteros seguidos
+ *       (edades de mujeres, de hombres, patrimonio de mujeres, de hombres); el arreglo
+ *       del hilo crece cuando aparece un código de ciudad nuevo.
+ */
+Histogramas construirHistogramas(const std::vector<Persona>& personas, double anchoPatrimonio,
+                                 int anioReferencia, unsigned hilos) {
+    Histogramas resultado;
+    resultado.anioReferencia = anioReferencia;
+    resultado.anchoPatrimonio = anchoPatrimonio > 0 ? anchoPatrimonio : 1e8;
+    resultado.pais.grupo = "Colombia";
+    hilos = hilosParaTamano(personas.size(), hilos);
+    resultado.hilos = hilos;
+
+    const double inversoAncho = 1.0 / resultado.anchoPatrimonio;
+    DiccionarioCiudades diccionario;
+    std::vector<std::vector<uint64_t>> parciales(hilos);
+    ejecutarPorBloques(personas.size(), [&](unsigned h, size_t inicio, size_t fin) {
+        DiccionarioCiudades::Conocidas conocidas;
+        std::vector<uint64_t>& contadores = parciales[h];
+        for (size_t i = inicio; i < fin; ++i) {
+            const Persona& p = personas[i];
+            size_t ciudad = diccionario.codigo(p.getCiudadNacimiento(), conocidas);
+            if ((ciudad + 1) * CONTADORES_POR_CIUDAD > contadores.size()) {
+                contadores.resize((ciudad + 1) * CONTADORES_POR_CIUDAD, 0);
+            }
+            uint64_t* base = contadores.data() + ciudad * CONTADORES_POR_CIUDAD;
+            size_t sexo = p.getIndiceNombre() >= NOMBRES_FEMENINOS ? 1 : 0;
+
+            int edad = std::max(0, anioReferencia - anioNacimiento(p.getFechaNacimiento()));
+            size_t cubetaEdad = std::min(static_cast<size_t>(edad / ANCHO_EDAD), CUBETAS_EDAD - 1);
+            double cubeta = p.getPatrimonio() * inversoAncho;
+            size_t cubetaPatrimonio = cubeta <= 0 ? 0
+                : cubeta >= CUBETAS_PATRIMONIO - 1 ? CUBETAS_PATRIMONIO - 1 : static_cast<size_t>(cubeta);
+
+            ++base[sexo * CUBETAS_EDAD + cubetaEdad];
+            ++base[2 * CUBETAS_EDAD + sexo * CUBETAS_PATRIMONIO + cubetaPatrimonio];
+        }
+    }, hilos);
+
+    // Suma de los arreglos de los hilos, por ciudad
+    resultado.ciudades.resize(diccionario.size());
+    for (size_t ciudad = 0; ciudad < diccionario.size(); ++ciudad) {
+        HistogramaGrupo& grupo = resultado.ciudades[ciudad];
+        grupo.grupo = std::string(diccionario.nombre(static_cast<uint16_t>(ciudad)));
+        for (const auto& contadores : parciales) {
+            if ((ciudad + 1) * CONTADORES_POR_CIUDAD > contadores.size()) {
+                continue; // Este hilo no vio la ciudad
+            }
+            const uint64_t* base = contadores.data() + ciudad * CONTADORES_POR_CIUDAD;
+            for (int s = 0; s < 2; ++s) {
+                for (size_t c = 0; c < CUBETAS_EDAD; ++c) {
+                    grupo.edades[s][c] += base[s * CUBETAS_EDAD + c];
+                }
+                for (size_t c = 0; c < CUBETAS_PATRIMONIO; ++c) {
+                    grupo.patrimonio[s][c] += base[2 * CUBETAS_EDAD + s * CUBETAS_PATRIMONIO + c];
+                }
+            }
+        }
+        resultado.pais.combinar(grupo);
+    }
+    std::sort(resultado.ciudades.begin(), resultado.ciudades.end(),
+              [](const HistogramaGrupo& a, const HistogramaGrupo& b) { return a.grupo < b.grupo; });
+    return resultado;
+}
+
+void mostrarPiramide(const HistogramaGrupo& histograma) {
+    uint64_t maximo = 0;
+    for (const auto& sexo : histograma.edades) {
+        maximo = std::max(maximo, *std::max_element(sexo.begin(), sexo.end()));
+    }
+    std::cout << "\n=== PIRÁMIDE POBLACIONAL: " << histograma.grupo << " (" << histograma.total() << " personas) ===\n";
+    std::cout << std::setw(ANCHO_BARRA + 10) << "Hombres" << "   Edad   " << "Mujeres\n";
+    for (size_t c = CUBETAS_EDAD; c-- > 0;) {
+        uint64_t hombres = histograma.edades[1][c];
+        uint64_t mujeres = histograma.edades[0][c];
+        std::cout << std::setw(9) << hombres << " " << std::setw(ANCHO_BARRA) << barra(hombres, maximo)
+                  << " " << std::setw(7) << rangoEdad(c) << " " << std::left << std::setw(ANCHO_BARRA)
+                  << barra(mujeres, maximo) << std::right << " " << mujeres << "\n";
+    }
+}
+
+void mostrarHistogramaPatrimonio(const HistogramaGrupo& histograma, double anchoPatrimonio) {
+    std::array<uint64_t, CUBETAS_PATRIMONIO> totales{};
+    uint64_t maximo = 0;
+    for (size_t c = 0; c < CUBETAS_PATRIMONIO; ++c) {
+        totales[c] = histograma.patrimonio[0][c] + histograma.patrimonio[1][c];
+        maximo = std::max(maximo, totales[c]);
+    }
+    std::cout << "\n=== PATRIMONIO: " << histograma.grupo << " (cubetas de "
+              << std::fixed << std::setprecision(0) << anchoPatrimonio / 1e6 << "M) ===\n";
+    for (size_t c = 0; c < CUBETAS_PATRIMONIO; ++c) {
+        std::string rango = std::to_string(static_cast<long long>(c * anchoPatrimonio / 1e6)) + "M" +
+            (c + 1 == CUBETAS_PATRIMONIO ? "+" : "-" + std::to_string(static_cast<long long>((c + 1) * anchoPatrimonio / 1e6)) + "M");
+        std::cout << std::setw(14) << rango << " " << std::left << std::setw(ANCHO_BARRA)
+                  << barra(totales[c], maximo) << std::right << " " << totales[c] << "\n";
+    }
+}
+
+bool exportarHistogramasCSV(const Histogramas& histogramas, const std::string& ruta) {
+    std::ofstream archivo(ruta);
+    if (!archivo) {
+        std::cerr << "Error al abrir archivo: " << ruta << std::endl;
+        return false;
+    }
+    archivo << std::fixed << std::setprecision(0);
+    archivo << "Grupo,Histograma,Desde,Hasta,Mujeres,Hombres,Total\n";
+    auto escribir = [&](const HistogramaGrupo& grupo) {
+        for (size_t c = 0; c < CUBETAS_EDAD; ++c) {
+            archivo << grupo.grupo << ",edad," << c * ANCHO_EDAD << ",";
+            if (c + 1 < CUBETAS_EDAD) {
+                archivo << (c + 1) * ANCHO_EDAD - 1;
+            }
+            archivo << "," << grupo.edades[0][c] << "," << grupo.edades[1][c] << ","
+                    << grupo.edades[0][c] + grupo.edades[1][c] << "\n";
+        }
+        for (size_t c = 0; c < CUBETAS_PATRIMONIO; ++c) {
+            archivo << grupo.grupo << ",patrimonio," << c * histogramas.anchoPatrimonio << ",";
+            if (c + 1 < CUBETAS_PATRIMONIO) {
+                archivo << (c + 1) * histogramas.anchoPatrimonio;
+            }
+            archivo << "," << grupo.patrimonio[0][c] << "," << grupo.patrimonio[1][c] << ","
+                    << grupo.patrimonio[0][c] + grupo.patrimonio[1][c] << "\n";
+        }
+    };
+    escribir(histogramas.pais);
+    for (const auto& ciudad : histogramas.ciudades) {
+        escribir(ciudad);
+    }
+    return static_cast<bool>(archivo);
+}
@@ -0,0 +1,163 @@
+#include "hyperloglog.h"
+#include "paralelo.h"
+#include <unordered_set>
+#include <algorithm>
+#include <cmath>
+
+HyperLogLog::HyperLogLog(int precision)
+    : p(std::min(18, std::max(4, precision))), registros(size_t{1} << p, 0) {}
+
+/**
+ * Implementación de agregarHash.
+ *
+ * POR QUÉ: Actualizar el registro correspondiente al hash.
+ * CÓMO: Los p bits altos eligen el registro; en los 64 - p bits restantes se cuenta la
+ *       posición del primer 1 (ceros a la izquierda + 1) con __builtin_clzll.
+ * PARA QUÉ: Actualización O(1) sin ramas costosas.
+ */
+void HyperLogLog::agregarHash(uint64_t hash) {
+    size_t indice = hash >> (64 - p);
+    uint64_t resto = (hash << p) | (uint64_t{1} << (p - 1)); // Centinela: acota el conteo
+    uint8_t rango = static_cast<uint8_t>(__builtin_clzll(resto) + 1);
+    if (rango > registros[indice]) {
+        registros[indice] = rango;
+    }
+}
+
+void HyperLogLog::combinar(const HyperLogLog& otro) {
+    if (otro.p != p) {
+        return; // Precisiones distintas no son combinables
+    }
+    for (size_t i = 0; i < registros.size(); ++i) {
+        registros[i] = std::max(registros[i], otro.registros[i]);
+    }
+}
+
+/**
+ * Implementación de estimar.
+ *
+ * POR QUÉ: Convertir los registros en una cardinalidad.
+ * CÓMO: E = alfa_m * m^2 / suma(2^-registro). Si E es pequeño y quedan registros en
+ *       cero, se usa conteo lineal m * ln(m / ceros), que es más preciso en ese rango.
+ * PARA QUÉ: Estimación válida desde decenas hasta miles de millones de distintos.
+ */
+double HyperLogLog::estimar() const {
+    double m = static_cast<double>(registros.size());
+    double suma = 0.0;
+    size_t ceros = 0;
+    for (uint8_t r : registros) {
+        suma += std::ldexp(1.0, -static_cast<int>(r));
+        if (r == 0) {
+            ++ceros;
+        }
+    }
+    double alfa = 0.7213 / (1.0 + 1.079 / m);
+    double estimado = alfa * m * m / suma;
+
+    if (estimado <= 2.5 * m && ceros > 0) {
+        estimado = m * std::log(m / static_cast<double>(ceros));
+    }
+    return estimado;
+}
+
+double HyperLogLog::errorEstandar() const {
+    return 1.04 / std::sqrt(static_cast<double>(registros.size()));
+}
+
+/**
+ * Implementación de estimarApellidosDistintos.
+ *
+ * POR QUÉ: Contar apellidos distintos sin guardar las cadenas.
+ * CÓMO: Un HyperLogLog por hilo sobre su bloque y combinación final por máximo.
+ * PARA QUÉ: Memoria constante (m bytes por hilo) sin importar el tamaño del conjunto.
+ */
+HyperLogLog estimarApellidosDistintos(const std::vector<Persona>& personas, int precision) {
+    unsigned hilos = hilosParaTamano(personas.size());
+    std::vector<HyperLogLog> parciales(hilos, HyperLogLog(precision));
+
+    ejecutarPorBloques(personas.size(), [&](unsigned h, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) {
+            parciales[h].agregar(personas[i].getApellido());
+        }
+    }, hilos);
+
+    for (unsigned h = 1; h < hilos; ++h) {
+        parciales[0].combinar(parciales[h]);
+    }
+    return parciales[0];
+}
+
+std::map<std::string, HyperLogLog> estimarNombresDistintosPorCiudad(const std::vector<Persona>& personas,
+                                                                   int precision) {
+    unsigned hilos = hilosParaTamano(personas.size());
+    std::vector<std::map<std::string, HyperLogLog>> parciales(hilos);
+    HyperLogLog vacio(precision);
+
+    ejecutarPorBloques(personas.size(), [&](unsigned h, size_t inicio, size_t fin) {
+        auto& porCiudad = parciales[h];
+        for (size_t i = inicio; i < fin; ++i) {
+            const Persona& p = personas[i];
+            // Hash de "nombre apellido" encadenado, sin construir la cadena completa
+            uint64_t estado = hashFNV(p.getNombre());
+            estado = hashFNV(" ", estado);
+            estado = hashFNV(p.getApellido(), estado);
+            porCiudad.try_emplace(std::string(p.getCiudadNacimiento()), vacio).first->second.agregarHash(mezclarHash(estado));
+        }
+    }, hilos);
+
+    for (unsigned h = 1; h < hilos; ++h) {
+        for (const auto& [ciudad, hll] : parciales[h]) {
+            parciales[0].try_emplace(ciudad, vacio).first->second.combinar(hll);
+        }
+    }
+    return parciales[0];
+}
+
+namespace {
+    // Memoria aproximada de un unordered_set<string>: nodo + cadena + cubetas
+    size_t bytesConjunto(const std::unordered_set<std::string>& conjunto) {
+        size_t bytes = conjunto.bucket_count() * sizeof(void*);
+        for (const auto& s : conjunto) {
+            bytes += sizeof(std::string) + sizeof(void*) + sizeof(size_t);
+            if (s.capacity() > 15) {
+                bytes += s.capacity() + 1; // Fuera del buffer SSO de libstdc++
+            }
+        }
+        return bytes;
+    }
+}
+
+/**
+ * Implementación de contarApellidosDistintosExacto.
+ *
+ * POR QUÉ: Línea base exacta para medir error, tiempo y memoria del estimador.
+ * CÓMO: Inserta cada apellido en un std::unordered_set<std::string>.
+ * PARA QUÉ: Comparación en el menú.
+ */
+size_t contarApellidosDistintosExacto(const std::vector<Persona>& personas, size_t& bytesAprox) {
+    std::unordered_set<std::string> distintos;
+    for (const auto& p : personas) {
+        distintos.emplace(p.getApellido());
+    }
+    bytesAprox = bytesConjunto(distintos);
+    return distintos.size();
+}
+
+std::map<std::string, size_t> contarNombresDistintosPorCiudadExacto(const std::vector<Persona>& personas,
+                                                                    size_t& bytesAprox) {
+    std::map<std::string, std::unordered_set<std::string>> porCiudad;
+    for (const auto& p : personas) {
+        std::string completo(p.getNombre());
+        completo += ' ';
+        completo += p.getApellido();
+        porCiudad[std::string(p.getCiudadNacimiento())].insert(std::move(completo));
+    }
+
+    std::map<std::string, size_t> resultado;
+    bytesAprox = 0;
+    for (const auto& [ciudad, distintos] : porCiudad) {
+        resultado[ciudad] = distintos.size();
+        bytesAprox += bytesConjunto(distintos);
+    }
+    return resultado;
+}
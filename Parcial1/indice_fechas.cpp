@@ -0,0 +1,173 @@
+#include "indice_fechas.h"
+#include "paralelo.h"
+#include <algorithm>
+
+/**
+ * Implementación de construir.
+ *
+ * POR QUÉ: Ordenar una vez para poder responder muchas consultas sin recorrer todo.
+ * CÓMO: 1) Calcula en paralelo la clave AAAAMMDD de cada persona y la empaqueta con
+ *       su posición en un entero de 64 bits (clave en la parte alta); 2) ordena esos
+ *       enteros con ordenarParalelo, lo que ordena por fecha y desempata por posición;
+ *       3) separa claves y posiciones y, si se pide, reparte por ciudad en ese mismo
+ *       orden, de modo que cada partición queda ordenada sin volver a ordenar.
+ * PARA QUÉ: Dejar listo el índice para búsquedas binarias.
+ */
+void IndiceFechas::construir(const std::vector<Persona>& datos, bool particionarPorCiudad) {
+    invalidar();
+
+    size_t n = datos.size();
+    std::vector<uint64_t> pares(n);
+
+    ejecutarPorBloques(n, [&](unsigned, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) {
+            uint64_t clave = static_cast<uint32_t>(datos[i].claveFechaNacimiento());
+            pares[i] = (clave << 32) | static_cast<uint32_t>(i);
+        }
+    });
+
+    ordenarParalelo(pares, [](uint64_t a, uint64_t b) { return a < b; });
+
+    global.claves.resize(n);
+    global.posiciones.resize(n);
+    ejecutarPorBloques(n, [&](unsigned, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) {
+            global.claves[i] = static_cast<uint32_t>(pares[i] >> 32);
+            global.posiciones[i] = static_cast<uint32_t>(pares[i]);
+        }
+    });
+
+    if (particionarPorCiudad) {
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t pos = global.posiciones[i];
+            Particion& p = porCiudad[std::string(datos[pos].getCiudadNacimiento())];
+            p.claves.push_back(global.claves[i]);
+            p.posiciones.push_back(pos);
+        }
+    }
+
+    personas = &datos;
+}
+
+void IndiceFechas::invalidar() {
+    personas = nullptr;
+    global = Particion();
+    porCiudad.clear();
+}
+
+/**
+ * Selecciona la partición a consultar.
+ *
+ * @return La partición de la ciudad, la global si ciudad está vacía, o nullptr si
+ *         la ciudad no existe (o no se construyeron particiones por ciudad).
+ */
+const IndiceFechas::Particion* IndiceFechas::buscarParticion(const std::string& ciudad) const {
+    if (!personas) {
+        return nullptr;
+    }
+    if (ciudad.empty()) {
+        return &global;
+    }
+    auto it = porCiudad.find(ciudad);
+    return it != porCiudad.end() ? &it->second : nullptr;
+}
+
+/**
+ * Implementación de rango.
+ *
+ * POR QUÉ: Obtener todas las personas nacidas entre dos fechas.
+ * CÓMO: lower_bound/upper_bound sobre las claves ordenadas delimitan el tramo.
+ * PARA QUÉ: Consultas por rango de edad sin recorrer la colección.
+ */
+std::vector<const Persona*> IndiceFechas::rango(int desde, int hasta, const std::string& ciudad) const {
+    std::vector<const Persona*> resultado;
+    const Particion* p = buscarParticion(ciudad);
+    if (!p || desde > hasta) {
+        return resultado;
+    }
+
+    auto ini = std::lower_bound(p->claves.begin(), p->claves.end(), static_cast<uint32_t>(desde));
+    auto fin = std::upper_bound(ini, p->claves.end(), static_cast<uint32_t>(hasta));
+    size_t a = ini - p->claves.begin();
+    size_t b = fin - p->claves.begin();
+
+    resultado.reserve(b - a);
+    for (size_t i = a; i < b; ++i) {
+        resultado.push_back(&(*personas)[p->posiciones[i]]);
+    }
+    return resultado;
+}
+
+size_t IndiceFechas::contarRango(int desde, int hasta, const std::string& ciudad) const {
+    const Particion* p = buscarParticion(ciudad);
+    if (!p || desde > hasta) {
+        return 0;
+    }
+    auto ini = std::lower_bound(p->claves.begin(), p->claves.end(), static_cast<uint32_t>(desde));
+    auto fin = std::upper_bound(ini, p->claves.end(), static_cast<uint32_t>(hasta));
+    return fin - ini;
+}
+
+/**
+ * Implementación de masLongevas.
+ *
+ * POR QUÉ: Las k personas más longevas son los k primeros elementos del índice.
+ * CÓMO: Recorriendo el inicio de la permutación ordenada.
+ * PARA QUÉ: Top-k por edad en O(k).
+ */
+std::vector<const Persona*> IndiceFechas::masLongevas(size_t k, const std::string& ciudad) const {
+    std::vector<const Persona*> resultado;
+    const Particion* p = buscarParticion(ciudad);
+    if (!p) {
+        return resultado;
+    }
+    k = std::min(k, p->posiciones.size());
+    for (size_t i = 0; i < k; ++i) {
+        resultado.push_back(&(*personas)[p->posiciones[i]]);
+    }
+    return resultado;
+}
+
+// Igual que masLongevas pero recorriendo el índice desde el final
+std::vector<const Persona*> IndiceFechas::masJovenes(size_t k, const std::string& ciudad) const {
+    std::vector<const Persona*> resultado;
+    const Particion* p = buscarParticion(ciudad);
+    if (!p) {
+        return resultado;
+    }
+    k = std::min(k, p->posiciones.size());
+    for (size_t i = 0; i < k; ++i) {
+        resultado.push_back(&(*personas)[p->posiciones[p->posiciones.size() - 1 - i]]);
+    }
+    return resultado;
+}
+
+/**
+ * Implementación de conteoCohortes.
+ *
+ * POR QUÉ: Contar nacimientos por quinquenio, década, etc.
+ * CÓMO: Para cada cohorte se hacen dos búsquedas binarias sobre las claves, así que
+ *       el costo depende del número de cohortes y no del número de personas.
+ * PARA QUÉ: Distribuciones demográficas instantáneas.
+ */
+std::map<int, size_t> IndiceFechas::conteoCohortes(int anchoAnios, const std::string& ciudad) const {
+    std::map<int, size_t> conteo;
+    const Particion* p = buscarParticion(ciudad);
+    if (!p || p->claves.empty() || anchoAnios <= 0) {
+        return conteo;
+    }
+
+    int primerAnio = p->claves.front() / 10000;
+    int ultimoAnio = p->claves.back() / 10000;
+    primerAnio -= primerAnio % anchoAnios;
+
+    for (int anio = primerAnio; anio <= ultimoAnio; anio += anchoAnios) {
+        int desde = anio * 10000;                               // 1 de enero (00/00 como mínimo)
+        int hasta = (anio + anchoAnios - 1) * 10000 + 1231;    // 31 de diciembre
+        size_t cantidad = contarRango(desde, hasta, ciudad);
+        if (cantidad > 0) {
+            conteo[anio] = cantidad;
+        }
+    }
+    return conteo;
+}
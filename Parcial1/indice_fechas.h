@@ -0,0 +1,74 @@
+#ifndef INDICE_FECHAS_H
+#define INDICE_FECHAS_H
+
+#include "persona.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+
+/**
+ * Índice ordenado por fecha de nacimiento (permutación de posiciones).
+ *
+ * POR QUÉ: Preguntas como "nacidos entre 1965 y 1970" o "mayores de 60 en Bogotá"
+ *          obligaban a recorrer toda la colección parseando fechas en texto.
+ * CÓMO: Guarda las posiciones de las personas ordenadas por su clave AAAAMMDD
+ *       (ordenamiento paralelo), junto con las claves en un arreglo aparte para
+ *       hacer búsqueda binaria. Opcionalmente mantiene una partición por ciudad
+ *       que conserva el mismo orden.
+ * PARA QUÉ: Responder rangos, k más longevas/jóvenes y cohortes en O(log n + k).
+ *
+ * El índice guarda un apuntador al vector indexado: debe invalidarse (o
+ * reconstruirse) cada vez que cambia el conjunto de datos.
+ */
+class IndiceFechas {
+public:
+    /**
+     * Construye el índice sobre un vector de personas.
+     *
+     * @param personas Vector a indexar (debe seguir vivo mientras se use el índice).
+     * @param particionarPorCiudad Si es true, construye también los índices por ciudad.
+     */
+    void construir(const std::vector<Persona>& personas, bool particionarPorCiudad = true);
+
+    // Descarta el índice (p. ej. cuando se genera un conjunto nuevo)
+    void invalidar();
+
+    bool construido() const { return personas != nullptr; }
+
+    /**
+     * Personas nacidas en [desde, hasta], ambas claves en formato AAAAMMDD.
+     * Con ciudad vacía se consulta el índice global.
+     */
+    std::vector<const Persona*> rango(int desde, int hasta, const std::string& ciudad = "") const;
+
+    // Cuenta las personas del rango sin materializarlas (dos búsquedas binarias)
+    size_t contarRango(int desde, int hasta, const std::string& ciudad = "") const;
+
+    // Las k personas con fecha de nacimiento más antigua / más reciente
+    std::vector<const Persona*> masLongevas(size_t k, const std::string& ciudad = "") const;
+    std::vector<const Persona*> masJovenes(size_t k, const std::string& ciudad = "") const;
+
+    /**
+     * Cuenta personas por cohortes de nacimiento de anchoAnios años.
+     *
+     * @return Mapa año inicial de la cohorte -> número de personas nacidas en ella.
+     */
+    std::map<int, size_t> conteoCohortes(int anchoAnios, const std::string& ciudad = "") const;
+
+private:
+    // Permutación ordenada en formato estructura-de-arreglos: las claves contiguas
+    // hacen que la búsqueda binaria toque pocas líneas de caché.
+    struct Particion {
+        std::vector<uint32_t> claves;     // AAAAMMDD de cada entrada, ascendente
+        std::vector<uint32_t> posiciones; // Posición de la persona en el vector indexado
+    };
+
+    const Particion* buscarParticion(const std::string& ciudad) const;
+
+    const std::vector<Persona>* personas = nullptr;
+    Particion global;
+    std::map<std::string, Particion> porCiudad;
+};
+
+#endif // INDICE_FECHAS_H
@@ -0,0 +1,177 @@
+#include "indice_valores.h"
+#include "radix.h"
+#include "paralelo.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    double valorDe(const Persona& p, CampoFinanciero campo) {
+        switch (campo) {
+            case CampoFinanciero::Patrimonio: return p.getPatrimonio();
+            case CampoFinanciero::Ingresos:   return p.getIngresosAnuales();
+            case CampoFinanciero::Deudas:     return p.getDeudas();
+        }
+        return 0.0;
+    }
+
+    // Compara IDs numéricos guardados como texto: primero por longitud, luego por dígitos
+    bool idMenor(std::string_view a, std::string_view b) {
+        return a.size() != b.size() ? a.size() < b.size() : a < b;
+    }
+}
+
+/**
+ * Implementación de construir.
+ *
+ * POR QUÉ: Preparar las tres permutaciones ordenadas de una sola vez.
+ * CÓMO: Por cada campo, extrae en paralelo las claves ordenables, las ordena con
+ *       radix paralelo y llena en paralelo los valores ordenados y los rangos inversos.
+ * PARA QUÉ: Que todas las consultas posteriores sean búsquedas binarias o accesos directos.
+ */
+void IndiceValores::construir(const std::vector<Persona>& datos) {
+    invalidar();
+    size_t n = datos.size();
+    std::vector<uint64_t> claves(n);
+
+    for (int c = 0; c < 3; ++c) {
+        CampoFinanciero campo = static_cast<CampoFinanciero>(c);
+        Orden& orden = ordenes[c];
+
+        ejecutarPorBloques(n, [&](unsigned, size_t inicio, size_t fin) {
+            for (size_t i = inicio; i < fin; ++i) {
+                claves[i] = claveOrdenable(valorDe(datos[i], campo));
+            }
+        });
+
+        orden.posiciones = ordenarRadixParalelo(claves);
+        orden.valores.resize(n);
+        orden.rangos.resize(n);
+
+        ejecutarPorBloques(n, [&](unsigned, size_t inicio, size_t fin) {
+            for (size_t r = inicio; r < fin; ++r) {
+                uint32_t pos = orden.posiciones[r];
+                orden.valores[r] = valorDe(datos[pos], campo);
+                orden.rangos[pos] = static_cast<uint32_t>(r);
+            }
+        });
+    }
+
+    // generarID() produce IDs crecientes; si se conservan en orden, la búsqueda es binaria
+    idsOrdenados = true;
+    for (size_t i = 1; i < n && idsOrdenados; ++i) {
+        idsOrdenados = !idMenor(datos[i].getId(), datos[i - 1].getId());
+    }
+
+    personas = &datos;
+}
+
+void IndiceValores::invalidar() {
+    personas = nullptr;
+    for (auto& orden : ordenes) {
+        orden = Orden();
+    }
+    idsOrdenados = false;
+}
+
+long IndiceValores::posicionDeID(const std::string& id) const {
+    if (idsOrdenados) {
+        auto it = std::lower_bound(personas->begin(), personas->end(), id,
+            [](const Persona& p, std::string_view buscado) { return idMenor(p.getId(), buscado); });
+        if (it != personas->end() && it->getId() == id) {
+            return it - personas->begin();
+        }
+        return -1;
+    }
+    // Respaldo: búsqueda lineal si los IDs no están ordenados
+    for (size_t i = 0; i < personas->size(); ++i) {
+        if ((*personas)[i].getId() == id) {
+            return static_cast<long>(i);
+        }
+    }
+    return -1;
+}
+
+std::vector<const Persona*> IndiceValores::tramo(const Orden& orden, size_t desde, size_t hasta) const {
+    std::vector<const Persona*> resultado;
+    if (desde >= hasta) {
+        return resultado;
+    }
+    resultado.reserve(hasta - desde);
+    for (size_t r = desde; r < hasta; ++r) {
+        resultado.push_back(&(*personas)[orden.posiciones[r]]);
+    }
+    return resultado;
+}
+
+/**
+ * Implementación de valorEnPercentil.
+ *
+ * POR QUÉ: El percentil p es el valor que deja el p% de la población por debajo.
+ * CÓMO: Rango más cercano: índice ceil(p/100 * n) - 1 en el arreglo ordenado.
+ * PARA QUÉ: Acceso O(1) a medianas, deciles y percentiles.
+ */
+double IndiceValores::valorEnPercentil(CampoFinanciero campo, double p) const {
+    const Orden& orden = ordenes[static_cast<int>(campo)];
+    if (!personas || orden.valores.empty()) {
+        return 0.0;
+    }
+    p = std::min(100.0, std::max(0.0, p));
+    size_t n = orden.valores.size();
+    size_t rango = static_cast<size_t>(std::ceil(p / 100.0 * n));
+    return orden.valores[rango > 0 ? rango - 1 : 0];
+}
+
+/**
+ * Implementación de rangoDeID.
+ *
+ * POR QUÉ: Saber qué fracción de la población tiene un valor menor o igual.
+ * CÓMO: Localiza la posición del ID y lee su rango en la permutación inversa.
+ * PARA QUÉ: Responder "¿en qué percentil está esta persona?".
+ */
+bool IndiceValores::rangoDeID(CampoFinanciero campo, const std::string& id,
+                              size_t& rango, double& percentil, const Persona*& persona) const {
+    if (!personas) {
+        return false;
+    }
+    long pos = posicionDeID(id);
+    if (pos < 0) {
+        return false;
+    }
+    const Orden& orden = ordenes[static_cast<int>(campo)];
+    rango = orden.rangos[pos];
+    percentil = 100.0 * (rango + 1) / orden.rangos.size();
+    persona = &(*personas)[pos];
+    return true;
+}
+
+std::vector<const Persona*> IndiceValores::entrePercentiles(CampoFinanciero campo,
+                                                            double pDesde, double pHasta) const {
+    if (!personas) {
+        return {};
+    }
+    const Orden& orden = ordenes[static_cast<int>(campo)];
+    size_t n = orden.valores.size();
+    pDesde = std::min(100.0, std::max(0.0, pDesde));
+    pHasta = std::min(100.0, std::max(0.0, pHasta));
+    size_t desde = static_cast<size_t>(std::floor(pDesde / 100.0 * n));
+    size_t hasta = static_cast<size_t>(std::ceil(pHasta / 100.0 * n));
+    return tramo(orden, desde, std::min(hasta, n));
+}
+
+/**
+ * Implementación de entreValores.
+ *
+ * POR QUÉ: Filtrar por un intervalo de montos.
+ * CÓMO: lower_bound/upper_bound sobre los valores ordenados.
+ * PARA QUÉ: Consultas de rango en O(log n + k).
+ */
+std::vector<const Persona*> IndiceValores::entreValores(CampoFinanciero campo,
+                                                        double minimo, double maximo) const {
+    if (!personas || minimo > maximo) {
+        return {};
+    }
+    const Orden& orden = ordenes[static_cast<int>(campo)];
+    auto ini = std::lower_bound(orden.valores.begin(), orden.valores.end(), minimo);
+    auto fin = std::upper_bound(ini, orden.valores.end(), maximo);
+    return tramo(orden, ini - orden.valores.begin(), fin - orden.valores.begin());
+}
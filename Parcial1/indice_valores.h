@@ -0,0 +1,68 @@
+#ifndef INDICE_VALORES_H
+#define INDICE_VALORES_H
+
+#include "persona.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Campos financieros que admite el índice de valores
+enum class CampoFinanciero { Patrimonio = 0, Ingresos = 1, Deudas = 2 };
+
+/**
+ * Índice secundario ordenado sobre patrimonio, ingresos anuales y deudas.
+ *
+ * POR QUÉ: Preguntas de percentil o de rango ("¿en qué percentil está el patrimonio
+ *          de este ID?", "personas entre el percentil 90 y 99 de ingresos") exigían
+ *          ordenar toda la colección en cada consulta.
+ * CÓMO: Para cada campo guarda los valores ordenados, la permutación de posiciones
+ *       (obtenida con ordenarRadixParalelo) y la permutación inversa (rango de cada
+ *       posición). Si los IDs están en orden (como los produce generarID) también se
+ *       localiza una persona por ID con búsqueda binaria.
+ * PARA QUÉ: Responder percentiles, rango de un ID y rangos de valores en O(log n).
+ */
+class IndiceValores {
+public:
+    // Construye los tres índices; el vector debe seguir vivo mientras se use el índice
+    void construir(const std::vector<Persona>& personas);
+    void invalidar();
+    bool construido() const { return personas != nullptr; }
+
+    /**
+     * Valor del campo en el percentil p (0-100), por el método del rango más cercano.
+     */
+    double valorEnPercentil(CampoFinanciero campo, double p) const;
+
+    /**
+     * Rango (0 = menor valor) y percentil del campo para la persona con ese ID.
+     *
+     * @return false si el ID no existe.
+     */
+    bool rangoDeID(CampoFinanciero campo, const std::string& id,
+                   size_t& rango, double& percentil, const Persona*& persona) const;
+
+    // Personas cuyo valor está entre los percentiles [pDesde, pHasta]
+    std::vector<const Persona*> entrePercentiles(CampoFinanciero campo, double pDesde, double pHasta) const;
+
+    // Personas cuyo valor está en [minimo, maximo]
+    std::vector<const Persona*> entreValores(CampoFinanciero campo, double minimo, double maximo) const;
+
+    size_t size() const { return personas ? personas->size() : 0; }
+
+private:
+    struct Orden {
+        std::vector<double> valores;      // Valores del campo en orden ascendente
+        std::vector<uint32_t> posiciones; // Posición original de cada valor ordenado
+        std::vector<uint32_t> rangos;     // rangos[posición] = índice en el orden
+    };
+
+    // Posición de la persona con ese ID, o -1 si no existe
+    long posicionDeID(const std::string& id) const;
+    std::vector<const Persona*> tramo(const Orden& orden, size_t desde, size_t hasta) const;
+
+    const std::vector<Persona>* personas = nullptr;
+    Orden ordenes[3];
+    bool idsOrdenados = false;
+};
+
+#endif // INDICE_VALORES_H
@@ -0,0 +1,236 @@
+#include "instantaneas.h"
+#include "generador.h"
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+PublicadorPersonas::PublicadorPersonas()
+    : liberadas(std::make_shared<std::atomic<size_t>>(0)) {
+    std::atomic_store(&actual, crear(ColeccionPersonas(), 0));
+}
+
+PublicadorPersonas::~PublicadorPersonas() {
+    esperar();
+}
+
+/**
+ * Envuelve un conjunto en una instantánea con un borrador que cuenta su liberación.
+ *
+ * POR QUÉ: Observar que las versiones viejas realmente se reclaman.
+ * CÓMO: El borrador captura el contador (por shared_ptr, así sobrevive al publicador).
+ * PARA QUÉ: Reportar instantáneas liberadas en las estadísticas.
+ */
+std::shared_ptr<const Instantanea> PublicadorPersonas::crear(ColeccionPersonas personas, uint64_t version) {
+    auto contador = liberadas;
+    return std::shared_ptr<const Instantanea>(new Instantanea{std::move(personas), version},
+        [contador](const Instantanea* instantanea) {
+            delete instantanea;
+            contador->fetch_add(1);
+        });
+}
+
+std::shared_ptr<const Instantanea> PublicadorPersonas::leer() const {
+    return std::atomic_load(&actual);
+}
+
+/**
+ * Implementación de publicar.
+ *
+ * POR QUÉ: Los lectores nunca deben ver un conjunto a medio construir.
+ * CÓMO: La instantánea se arma completa antes del intercambio; atomic_exchange la
+ *       hace visible de una vez. La anterior se suelta fuera de la medición: si este
+ *       era su último dueño, liberarla (personas y arenas) no cuenta como intercambio.
+ * PARA QUÉ: Medir solo lo que bloquea a los lectores, que es el intercambio.
+ */
+double PublicadorPersonas::publicar(ColeccionPersonas nueva) {
+    auto instantanea = crear(std::move(nueva), siguienteVersion.fetch_add(1));
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<const Instantanea> anterior = std::atomic_exchange(&actual, std::move(instantanea));
+    std::chrono::duration<double, std::micro> latencia = std::chrono::high_resolution_clock::now() - inicio;
+
+    {
+        std::lock_guard<std::mutex> bloqueo(mutexEstadisticas);
+        latencias.push_back(latencia.count());
+    }
+    anterior.reset();
+    return latencia.count();
+}
+
+bool PublicadorPersonas::generarEnSegundoPlano(int n, bool agregar) {
+    bool esperado = false;
+    if (!trabajando.compare_exchange_strong(esperado, true)) {
+        return false;
+    }
+    if (trabajador.joinable()) {
+        trabajador.join(); // Trabajo anterior ya terminado (trabajando era false)
+    }
+
+    trabajador = std::thread([this, n, agregar]() {
+        auto inicio = std::chrono::high_resolution_clock::now();
+
+        ColeccionPersonas nueva;
+        if (agregar) {
+            // Copia del manejador: O(1); modificar() clona el vector porque la
+            // instantánea publicada lo sigue compartiendo. Las arenas se comparten.
+            nueva = leer()->personas;
+            auto arena = std::make_shared<ArenaCadenas>();
+            std::vector<Persona>& datos = nueva.modificar();
+            datos.reserve(datos.size() + n);
+            for (int i = 0; i < n; ++i) {
+                datos.push_back(generarPersona(*arena));
+            }
+            nueva.adjuntarArena(std::move(arena));
+        } else {
+            nueva = generarColeccion(n);
+        }
+
+        std::chrono::duration<double, std::milli> duracion = std::chrono::high_resolution_clock::now() - inicio;
+        {
+            std::lock_guard<std::mutex> bloqueo(mutexEstadisticas);
+            ultimaGeneracion = duracion.count();
+        }
+        publicar(std::move(nueva));
+        trabajando.store(false);
+    });
+    return true;
+}
+
+void PublicadorPersonas::esperar() {
+    if (trabajador.joinable()) {
+        trabajador.join();
+    }
+}
+
+PublicadorPersonas::Estadisticas PublicadorPersonas::estadisticas() const {
+    std::lock_guard<std::mutex> bloqueo(mutexEstadisticas);
+    Estadisticas e;
+    e.publicaciones = latencias.size();
+    e.ultimaGeneracion = ultimaGeneracion;
+    e.liberadas = liberadas->load();
+    if (!latencias.empty()) {
+        auto [minimo, maximo] = std::minmax_element(latencias.begin(), latencias.end());
+        e.latenciaMinima = *minimo;
+        e.latenciaMaxima = *maximo;
+        e.latenciaPromedio = std::accumulate(latencias.begin(), latencias.end(), 0.0) / latencias.size();
+    }
+    return e;
+}
+
+namespace {
+    // Agrega un número al buffer con std::to_chars (sin pasar por locale ni flujos)
+    template <typename Numero>
+    void agregarNumero(std::string& salida, Numero valor) {
+        char texto[32];
+        auto resultado = std::to_chars(texto, texto + sizeof(texto), valor);
+        salida.append(texto, resultado.ptr);
+    }
+
+    // Siguiente campo hasta '|' o fin de línea; avanza el cursor después del separador
+    std::string_view siguienteCampo(const char*& cursor, const char* finLinea) {
+        const char* inicio = cursor;
+        while (cursor < finLinea && *cursor != '|') {
+            ++cursor;
+        }
+        std::string_view campo(inicio, cursor - inicio);
+        if (cursor < finLinea) {
+            ++cursor;
+        }
+        return campo;
+    }
+
+    template <typename Numero>
+    bool leerNumero(std::string_view campo, Numero& valor) {
+        auto resultado = std::from_chars(campo.data(), campo.data() + campo.size(), valor);
+        return resultado.ec == std::errc() && resultado.ptr == campo.data() + campo.size();
+    }
+}
+
+bool guardarInstantanea(const ColeccionPersonas& personas, const std::string& ruta) {
+    std::ofstream archivo(ruta, std::ios::binary);
+    if (!archivo) {
+        return false;
+    }
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    for (const Persona& p : personas) {
+        agregarNumero(buffer, static_cast<int>(p.getIndiceNombre()));
+        buffer += '|';
+        agregarNumero(buffer, static_cast<int>(p.getIndicePrimerApellido()));
+        buffer += '|';
+        agregarNumero(buffer, static_cast<int>(p.getIndiceSegundoApellido()));
+        buffer += '|';
+        buffer.append(p.getId());
+        buffer += '|';
+        buffer.append(p.getCiudadNacimiento());
+        buffer += '|';
+        buffer.append(p.getFechaNacimiento());
+        buffer += '|';
+        agregarNumero(buffer, p.getIngresosAnuales());
+        buffer += '|';
+        agregarNumero(buffer, p.getPatrimonio());
+        buffer += '|';
+        agregarNumero(buffer, p.getDeudas());
+        buffer += p.getDeclaranteRenta() ? "|1\n" : "|0\n";
+        if (buffer.size() >= (1 << 20) - 256) {
+            archivo.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    archivo.write(buffer.data(), buffer.size());
+    return static_cast<bool>(archivo);
+}
+
+bool cargarInstantanea(const std::string& ruta, ColeccionPersonas& destino) {
+    std::ifstream archivo(ruta, std::ios::binary);
+    if (!archivo) {
+        return false;
+    }
+    std::string contenido((std::istreambuf_iterator<char>(archivo)), std::istreambuf_iterator<char>());
+
+    auto arena = std::make_shared<ArenaCadenas>();
+    std::map<std::string, std::string_view, std::less<>> ciudades;
+    std::vector<Persona> personas;
+    personas.reserve(std::count(contenido.begin(), contenido.end(), '\n'));
+
+    const char* cursor = contenido.data();
+    const char* fin = cursor + contenido.size();
+    while (cursor < fin) {
+        const char* finLinea = std::find(cursor, fin, '\n');
+        int nombre, apellido1, apellido2, declara;
+        double ingresos, patrimonio, deudas;
+        bool valida = leerNumero(siguienteCampo(cursor, finLinea), nombre) &&
+                      leerNumero(siguienteCampo(cursor, finLinea), apellido1) &&
+                      leerNumero(siguienteCampo(cursor, finLinea), apellido2);
+        std::string_view id = siguienteCampo(cursor, finLinea);
+        std::string_view ciudad = siguienteCampo(cursor, finLinea);
+        std::string_view fecha = siguienteCampo(cursor, finLinea);
+        valida = valida && !id.empty() &&
+                 leerNumero(siguienteCampo(cursor, finLinea), ingresos) &&
+                 leerNumero(siguienteCampo(cursor, finLinea), patrimonio) &&
+                 leerNumero(siguienteCampo(cursor, finLinea), deudas) &&
+                 leerNumero(siguienteCampo(cursor, finLinea), declara) &&
+                 nombre >= 0 && nombre <= 0xFF && apellido1 >= 0 && apellido1 <= 0xFF &&
+                 apellido2 >= 0 && apellido2 <= 0xFF;
+        if (!valida) {
+            return false;
+        }
+
+        auto ciudadGuardada = ciudades.find(ciudad);
+        if (ciudadGuardada == ciudades.end()) {
+            ciudadGuardada = ciudades.emplace(std::string(ciudad), arena->guardar(ciudad)).first;
+        }
+        personas.emplace_back(static_cast<uint8_t>(nombre), static_cast<uint8_t>(apellido1),
+                              static_cast<uint8_t>(apellido2), arena->guardar(id),
+                              ciudadGuardada->second, arena->guardar(fecha),
+                              ingresos, patrimonio, deudas, declara != 0);
+        cursor = finLinea < fin ? finLinea + 1 : fin;
+    }
+
+    destino = ColeccionPersonas(std::move(personas), std::move(arena));
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef INSTANTANEAS_H
+#define INSTANTANEAS_H
+
+#include "coleccion.h"
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <string>
+
+/**
+ * Versión inmutable del conjunto publicada para los lectores.
+ */
+struct Instantanea {
+    ColeccionPersonas personas;
+    uint64_t version = 0;
+};
+
+/**
+ * Publicación del conjunto al estilo RCU (read-copy-update) con instantáneas.
+ *
+ * POR QUÉ: Regenerar o ampliar un conjunto grande toma segundos y, si se hace en el
+ *          mismo hilo del menú (o reemplazando el conjunto en sitio), nadie puede
+ *          consultar mientras tanto.
+ * CÓMO: La instantánea vigente es un std::shared_ptr<const Instantanea> que se lee con
+ *       std::atomic_load y se reemplaza con std::atomic_exchange. Cada lector toma su
+ *       propia referencia y sigue usando esa versión aunque se publique otra; la
+ *       instantánea anterior se libera sola cuando su último lector la suelta (el
+ *       contador de referencias hace de período de gracia). Un hilo trabajador genera
+ *       o amplía el conjunto en segundo plano y publica al terminar.
+ * PARA QUÉ: Lecturas sin bloqueo durante la regeneración y medición del costo del
+ *           intercambio de versiones.
+ */
+class PublicadorPersonas {
+public:
+    PublicadorPersonas();
+    ~PublicadorPersonas();
+
+    PublicadorPersonas(const PublicadorPersonas&) = delete;
+    PublicadorPersonas& operator=(const PublicadorPersonas&) = delete;
+
+    // Instantánea vigente; nunca nula (al inicio es un conjunto vacío, versión 0)
+    std::shared_ptr<const Instantanea> leer() const;
+    uint64_t version() const { return leer()->version; }
+
+    /**
+     * Publica un conjunto nuevo reemplazando al vigente.
+     *
+     * @return Latencia del intercambio atómico en microsegundos.
+     */
+    double publicar(ColeccionPersonas nueva);
+
+    /**
+     * Genera n personas en un hilo trabajador y las publica al terminar.
+     *
+     * @param agregar true: copia la instantánea vigente (copia-en-escritura) y le
+     *                agrega las n personas; false: reemplaza el conjunto completo.
+     * @return false si ya hay un trabajo en segundo plano en curso.
+     */
+    bool generarEnSegundoPlano(int n, bool agregar);
+
+    // true mientras el hilo trabajador no ha publicado
+    bool ocupado() const { return trabajando.load(); }
+
+    // Espera a que termine el trabajo en segundo plano (si hay uno)
+    void esperar();
+
+    // Estadísticas de intercambio (microsegundos) y de instantáneas liberadas
+    struct Estadisticas {
+        size_t publicaciones = 0;
+        double latenciaMinima = 0;
+        double latenciaPromedio = 0;
+        double latenciaMaxima = 0;
+        double ultimaGeneracion = 0; // ms del último trabajo en segundo plano
+        size_t liberadas = 0;        // Instantáneas reclamadas (último lector terminó)
+    };
+    Estadisticas estadisticas() const;
+
+private:
+    std::shared_ptr<const Instantanea> crear(ColeccionPersonas personas, uint64_t version);
+
+    std::shared_ptr<const Instantanea> actual; // Solo se accede con atomic_load/atomic_exchange
+    std::atomic<uint64_t> siguienteVersion{1};
+    std::atomic<bool> trabajando{false};
+    std::thread trabajador;
+
+    mutable std::mutex mutexEstadisticas;
+    std::vector<double> latencias;
+    double ultimaGeneracion = 0;
+    std::shared_ptr<std::atomic<size_t>> liberadas; // Compartido con los borradores
+};
+
+/**
+ * Guarda una instantánea del conjunto en disco, una persona por línea.
+ *
+ * POR QUÉ: Las mediciones repetidas (modo script) deben correr sobre los mismos datos,
+ *          y regenerar da un conjunto distinto cada vez.
+ * CÓMO: Texto separado por '|': los tres índices de nombre, cédula, ciudad, fecha,
+ *       ingresos, patrimonio, deudas y declarante. Los números se escriben con
+ *       std::to_chars (representación más corta que se relee exacta).
+ * PARA QUÉ: Reproducir una corrida cargando el mismo archivo con cargarInstantanea.
+ * @return false si no se pudo escribir el archivo.
+ */
+bool guardarInstantanea(const ColeccionPersonas& personas, const std::string& ruta);
+
+/**
+ * Carga un archivo escrito por guardarInstantanea.
+ *
+ * CÓMO: Lee el archivo completo de una vez y lo recorre con std::from_chars; las
+ *       cédulas y fechas se copian a una arena nueva y cada ciudad se guarda una sola
+ *       vez aunque se repita en millones de líneas.
+ * @param destino Recibe el conjunto; no se modifica si el archivo es inválido.
+ * @return false si el archivo no existe o tiene una línea mal formada.
+ */
+bool cargarInstantanea(const std::string& ruta, ColeccionPersonas& destino);
+
+#endif // INSTANTANEAS_H
@@ -5,14 +5,49 @@
 #include "persona.h"
 #include "generador.h"
 #include "monitor.h"
+#include "coleccion.h"
+#include "indice_fechas.h"
+#include "indice_valores.h"
+#include "cuantiles.h"
+#include "hyperloglog.h"
+#include "persona_compacta.h"
+#include "coleccion_particionada.h"
+#include "instantaneas.h"
+#include "servidor.h"
+#include "script.h"
+#include "barrido.h"
+#include "exportacion.h"
+#include "cubo_olap.h"
+#include "agregacion.h"
+#include "cache_consultas.h"
+#include "memoria_compartida.h"
+#include "columnas_comprimidas.h"
+#include "agrupamiento.h"
+#include "reglas_tributarias.h"
+#include "histogramas.h"
+#include "regresion.h"
+#include "protocolo.h"
+#include "paralelo.h"
+#include <thread>
+#include <atomic>
+#include <ctime>
+#include <cstdlib>
+#include <cctype>
 #include <map>
+#include <fstream>
+#include <sstream>
 
 /**
  * Función auxiliar para mostrar comparación de rendimiento
+ *
+ * @param metodoValor, metodoApuntador Nombres de los dos métodos en la tabla (hasta 15
+ *        caracteres); por omisión, paso por valor contra apuntadores.
  */
 void mostrarComparacion(const std::string& operacion, 
                        double tiempoValor, long memoriaValor,
-                       double tiempoApuntador, long memoriaApuntador);
+                       double tiempoApuntador, long memoriaApuntador,
+                       const std::string& metodoValor = "Por Valor",
+                       const std::string& metodoApuntador = "Por Apuntador");
 
 /**
  * Muestra el menú principal de la aplicación.
@@ -39,6 +74,23 @@ void mostrarMenu() {
     std::cout << "\n13. Top 3 ciudades con mayor patrimonio promedio";
     std::cout << "\n14. Consultar persona con más deudas del país";
     std::cout << "\n15. Consultar persona con el nombre más largo";
+    std::cout << "\n16. Comparar copia profunda vs copia compartida (COW) del conjunto";
+    std::cout << "\n17. Consultas por fecha de nacimiento (rangos, edades, cohortes)";
+    std::cout << "\n18. Percentiles y rangos de patrimonio, ingresos y deudas";
+    std::cout << "\n19. Percentiles aproximados por ciudad y calendario (sketch KLL vs exacto)";
+    std::cout << "\n20. Conteo de valores distintos (HyperLogLog vs exacto)";
+    std::cout << "\n21. Convertir a registros compactos de 32 bytes y comparar memoria";
+    std::cout << "\n22. Conjunto particionado por nodo NUMA (generación y resumen por ciudad)";
+    std::cout << "\n23. Regenerar o ampliar en segundo plano (instantáneas RCU)";
+    std::cout << "\n24. Exportar la población ordenada (patrimonio, ingresos, deudas o fecha)";
+    std::cout << "\n25. Cubo OLAP: ciudad x calendario x declarante x década (agregados precalculados)";
+    std::cout << "\n26. Configurar distribuciones del generador (Zipf, log-normal, Pareto, pirámide)";
+    std::cout << "\n27. Memoria compartida: publicar el conjunto o consultar el de otro proceso";
+    std::cout << "\n28. Comprimir columnas (delta, diccionario, referencia) y escanear sin descomprimir";
+    std::cout << "\n29. Agrupar por dimensiones libres (ej. apellido y ciudad) con tablas hash por hilo";
+    std::cout << "\n30. Evaluar quién debe declarar renta (topes en UVT) y sus vencimientos";
+    std::cout << "\n31. Generador por lotes (xoshiro256+ por carriles) vs generarColeccion";
+    std::cout << "\n32. Histogramas de edad y patrimonio por ciudad (pirámide poblacional, CSV)";
     std::cout << "\n\nSeleccione una opción: ";
 }
 
@@ -47,13 +99,14 @@ void mostrarMenu() {
  */
 void mostrarComparacion(const std::string& operacion, 
                        double tiempoValor, long memoriaValor,
-                       double tiempoApuntador, long memoriaApuntador) {
+                       double tiempoApuntador, long memoriaApuntador,
+                       const std::string& metodoValor, const std::string& metodoApuntador) {
     std::cout << "\n=== COMPARACION DE RENDIMIENTO: " << operacion << " ===\n";
     std::cout << "Metodo          | Tiempo (ms)    | Memoria (KB)   | Eficiencia\n";
     std::cout << "----------------|----------------|----------------|------------\n";
     
     // Mostrar resultados de PASO POR VALOR
-    std::cout << "Por Valor       | " << std::right << std::setw(12) << std::fixed << std::setprecision(2) 
+    std::cout << std::left << std::setw(15) << metodoValor << " | " << std::right << std::setw(12) << std::fixed << std::setprecision(2) 
               << tiempoValor << " ms | " << std::setw(12) << memoriaValor << " KB | ";
     
     if (tiempoValor > tiempoApuntador * 1.5) {
@@ -64,7 +117,7 @@ void mostrarComparacion(const std::string& operacion,
     std::cout << "\n";
     
     // Mostrar resultados de APUNTADORES
-    std::cout << "Por Apuntador   | " << std::right << std::setw(12) << std::fixed << std::setprecision(2) 
+    std::cout << std::left << std::setw(15) << metodoApuntador << " | " << std::right << std::setw(12) << std::fixed << std::setprecision(2) 
               << tiempoApuntador << " ms | " << std::setw(12) << memoriaApuntador << " KB | ";
     
     if (tiempoApuntador < tiempoValor * 0.7) {
@@ -95,9 +148,9 @@ void mostrarComparacion(const std::string& operacion,
               << std::abs(diferenciaT) << "% ";
     
     if (diferenciaT > 0) {
-        std::cout << "(Apuntadores " << std::abs(diferenciaT) << "% mas rapido)\n";
+        std::cout << "(" << metodoApuntador << " " << std::abs(diferenciaT) << "% mas rapido)\n";
     } else if (diferenciaT < 0) {
-        std::cout << "(Valor " << std::abs(diferenciaT) << "% mas rapido)\n";
+        std::cout << "(" << metodoValor << " " << std::abs(diferenciaT) << "% mas rapido)\n";
     } else {
         std::cout << "(Mismo rendimiento)\n";
     }
@@ -106,9 +159,9 @@ void mostrarComparacion(const std::string& operacion,
               << std::abs(diferenciaM) << "% ";
     
     if (diferenciaM > 0) {
-        std::cout << "(Apuntadores usa " << std::abs(diferenciaM) << "% menos memoria)\n";
+        std::cout << "(" << metodoApuntador << " usa " << std::abs(diferenciaM) << "% menos memoria)\n";
     } else if (diferenciaM < 0) {
-        std::cout << "(Valor usa " << std::abs(diferenciaM) << "% menos memoria)\n";
+        std::cout << "(" << metodoValor << " usa " << std::abs(diferenciaM) << "% menos memoria)\n";
     } else {
         std::cout << "(Mismo uso de memoria)\n";
     }
@@ -116,27 +169,226 @@ void mostrarComparacion(const std::string& operacion,
     std::cout << "========================================\n";
 }
 
+/**
+ * Construye el índice de fechas si no está vigente y registra su costo.
+ * 
+ * POR QUÉ: El índice se invalida cada vez que se genera un conjunto nuevo.
+ * CÓMO: Reconstruyéndolo de forma perezosa en la primera consulta que lo necesita.
+ * PARA QUÉ: Que el tiempo de construcción quede separado del tiempo de las consultas.
+ */
+void asegurarIndiceFechas(IndiceFechas& indice, const ColeccionPersonas& personas, Monitor& monitor) {
+    if (indice.construido()) {
+        return;
+    }
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    indice.construir(personas.datos());
+    double tiempo = monitor.detener_tiempo();
+    long memoria = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "\nÍndice de fechas construido en " << tiempo << " ms, Memoria: " << memoria << " KB\n";
+    monitor.registrar("Construir indice fechas", tiempo, memoria);
+}
+
+/**
+ * Construye el índice de valores financieros si no está vigente y registra su costo.
+ */
+void asegurarIndiceValores(IndiceValores& indice, const ColeccionPersonas& personas, Monitor& monitor) {
+    if (indice.construido()) {
+        return;
+    }
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    indice.construir(personas.datos());
+    double tiempo = monitor.detener_tiempo();
+    long memoria = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "\nÍndice de valores construido en " << tiempo << " ms, Memoria: " << memoria << " KB\n";
+    monitor.registrar("Construir indice valores", tiempo, memoria);
+}
+
+/**
+ * Construye el cubo OLAP si no está vigente y registra su costo.
+ */
+void asegurarCubo(CuboOLAP& cubo, const ColeccionPersonas& personas, Monitor& monitor) {
+    if (cubo.construido()) {
+        return;
+    }
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    cubo.construir(personas.datos());
+    double tiempo = monitor.detener_tiempo();
+    long memoria = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "\nCubo OLAP construido en " << tiempo << " ms (" << cubo.numeroCeldas()
+              << " celdas, " << cubo.bytes() / 1024 << " KB)\n";
+    monitor.registrar("Construir cubo OLAP", tiempo, memoria);
+    monitor.registrar_memoria("Cubo OLAP", cubo.bytes(), cubo.numeroCeldas());
+}
+
+/**
+ * Lee el nombre de una ciudad (puede tener espacios); "*" significa todas.
+ */
+std::string leerCiudad() {
+    std::string ciudad;
+    std::cout << "Ciudad (* para todas): ";
+    std::cin >> std::ws;
+    std::getline(std::cin, ciudad);
+    return ciudad == "*" ? "" : ciudad;
+}
+
+/**
+ * Muestra el total de un resultado y las primeras personas en formato resumen.
+ */
+void mostrarPrimeras(const std::vector<const Persona*>& resultado, size_t limite = 10) {
+    std::cout << "\nTotal encontradas: " << resultado.size() << "\n";
+    for (size_t i = 0; i < resultado.size() && i < limite; ++i) {
+        std::cout << i + 1 << ". ";
+        resultado[i]->mostrarResumen();
+        std::cout << " | " << resultado[i]->getFechaNacimiento() << "\n";
+    }
+    if (resultado.size() > limite) {
+        std::cout << "... (" << resultado.size() - limite << " más)\n";
+    }
+}
+
+/**
+ * Imprime una fila de la comparación sketch vs exacto (p50, p90, p99).
+ */
+void mostrarFilaCuantiles(const std::string& grupo, const SketchKLL& sketch,
+                          const std::vector<double>& cuantiles, const std::vector<double>& exactos) {
+    std::cout << std::left << std::setw(15) << grupo << std::right;
+    for (size_t i = 0; i < cuantiles.size(); ++i) {
+        double aprox = sketch.cuantil(cuantiles[i]);
+        double error = exactos[i] != 0.0 ? 100.0 * (aprox - exactos[i]) / exactos[i] : 0.0;
+        std::cout << " | " << std::setw(12) << std::fixed << std::setprecision(0) << aprox / 1e6
+                  << "M " << std::setw(12) << exactos[i] / 1e6 << "M "
+                  << std::setw(6) << std::setprecision(2) << error << "%";
+    }
+    std::cout << "\n";
+}
+
+/**
+ * Adopta la instantánea publicada más reciente si cambió desde la última vista.
+ * 
+ * POR QUÉ: Un hilo en segundo plano puede publicar un conjunto nuevo en cualquier
+ *          momento; el menú debe seguir con su versión hasta terminar la opción actual.
+ * CÓMO: Compara versiones y, si hay una nueva, copia el manejador (O(1)) e invalida
+ *       los índices, que apuntaban a la versión anterior.
+ * PARA QUÉ: Que cada opción del menú trabaje sobre una sola versión consistente.
+ * @return true si se adoptó una versión nueva.
+ */
+bool tomarInstantanea(const PublicadorPersonas& publicador, ColeccionPersonas& personas,
+                      uint64_t& versionVista, IndiceFechas& indiceFechas, IndiceValores& indiceValores,
+                      CuboOLAP& cubo) {
+    std::shared_ptr<const Instantanea> vista = publicador.leer();
+    if (vista->version == versionVista) {
+        return false;
+    }
+    personas = vista->personas;
+    versionVista = vista->version;
+    indiceFechas.invalidar();
+    indiceValores.invalidar();
+    cubo.invalidar();
+    return true;
+}
+
 /**
  * Punto de entrada principal del programa.
  * 
  * POR QUÉ: Iniciar la aplicación y manejar el flujo principal.
  * CÓMO: Mediante un bucle que muestra el menú y procesa la opción seleccionada.
  * PARA QUÉ: Ejecutar las funcionalidades del sistema.
+ *           Con `--servidor [ruta] [personas] [hilos]` no muestra el menú y atiende
+ *           consultas por socket Unix (ver servidor.h); con `--script [archivo|-]`
+ *           ejecuta un script de órdenes (ver script.h); con
+ *           `--barrido [nMaximo] [limiteMB] [archivo.csv]` mide el escalado (ver barrido.h);
+ *           con `--regresion [guardar|comparar] [archivo.json] [umbral%] [personas]
+ *           [repeticiones]` guarda o verifica la línea base de rendimiento (ver regresion.h).
  */
-int main() {
+int main(int argc, char* argv[]) {
     srand(time(nullptr)); // Semilla para generación aleatoria
+
+    if (argc > 1 && std::string(argv[1]) == "--servidor") {
+        std::string ruta = argc > 2 ? argv[2] : RUTA_SOCKET_PREDETERMINADA;
+        int n = argc > 3 ? std::atoi(argv[3]) : 1000000;
+        unsigned hilos = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : numeroHilos();
+        if (n <= 0) {
+            std::cerr << "Error: el número de personas debe ser positivo\n";
+            return 1;
+        }
+        return ejecutarServidor(ruta, n, hilos);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--script") {
+        std::string ruta = argc > 2 ? argv[2] : "-";
+        if (ruta == "-") {
+            return ejecutarScript(std::cin, "<entrada estándar>");
+        }
+        std::ifstream archivo(ruta);
+        if (!archivo) {
+            std::cerr << "Error: no se pudo abrir el script " << ruta << "\n";
+            return 1;
+        }
+        return ejecutarScript(archivo, ruta);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--barrido") {
+        long nMaximo = argc > 2 ? std::atol(argv[2]) : 10000000;
+        long limiteMB = argc > 3 ? std::atol(argv[3]) : 0;
+        std::string archivo = argc > 4 ? argv[4] : "barrido.csv";
+        // Los generadores reciben int: un n mayor se volvería negativo al convertirlo
+        if (nMaximo < 1000 || nMaximo > std::numeric_limits<int>::max() || limiteMB < 0) {
+            std::cerr << "Uso: " << argv[0] << " --barrido [1000 <= nMaximo <= "
+                      << std::numeric_limits<int>::max() << "] [limiteMB] [archivo.csv]\n";
+            return 1;
+        }
+        return ejecutarBarrido(static_cast<size_t>(nMaximo), static_cast<size_t>(limiteMB), archivo);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--regresion") {
+        std::string modo = argc > 2 ? argv[2] : "comparar";
+        std::string archivo = argc > 3 ? argv[3] : "linea_base.json";
+        double umbral = argc > 4 ? std::atof(argv[4]) : 10.0;
+        long n = argc > 5 ? std::atol(argv[5]) : 200000;
+        int repeticiones = argc > 6 ? std::atoi(argv[6]) : 10;
+        if ((modo != "guardar" && modo != "comparar") || umbral <= 0 || n < 1000 ||
+            n > std::numeric_limits<int>::max() || repeticiones < 2) {
+            std::cerr << "Uso: " << argv[0] << " --regresion [guardar|comparar] [archivo.json] [umbral% > 0]"
+                      << " [1000 <= personas <= " << std::numeric_limits<int>::max() << "] [repeticiones >= 2]\n";
+            return 2;
+        }
+        return ejecutarRegresion(modo == "comparar", archivo, umbral, static_cast<size_t>(n), repeticiones);
+    }
     
-    // Puntero inteligente para gestionar la colección de personas
-    // POR QUÉ: Evitar fugas de memoria y garantizar liberación automática.
-    std::unique_ptr<std::vector<Persona>> personas = nullptr;
+    // Colección compartida con copia-en-escritura
+    // POR QUÉ: Evitar fugas de memoria y que las funciones por valor copien todo el conjunto.
+    ColeccionPersonas personas;
     
     Monitor monitor; // Monitor para medir rendimiento
+    IndiceFechas indiceFechas; // Índice por fecha de nacimiento (se construye a demanda)
+    IndiceValores indiceValores; // Índice por patrimonio/ingresos/deudas (a demanda)
+    CuboOLAP cubo; // Agregados por ciudad/calendario/declarante/década (a demanda, opción 25)
+    CacheConsultas cache; // Resultados de las opciones 8 y 10 para la versión vista
+    ImagenCompartida imagen; // Conjunto publicado en memoria compartida (opción 27)
+    ColeccionParticionada particionado; // Conjunto repartido por nodo NUMA (opción 22)
+    PublicadorPersonas publicador; // Versión publicada del conjunto (RCU, opción 23)
+    uint64_t versionVista = 0;     // Versión que está usando el menú
+    ReglasTributarias reglas;      // Topes UVT de la opción 30
+    std::unique_ptr<EvaluadorTributario> evaluador; // Columnas de la opción 30 para versionEvaluador
+    uint64_t versionEvaluador = 0;
+    const std::ios::fmtflags formatoConsola = std::cout.flags();     // Formato inicial de la consola
+    const std::streamsize precisionConsola = std::cout.precision();
     
     int opcion;
     do {
         mostrarMenu();
         std::cin >> opcion;
         
+        // Si se publicó una versión nueva en segundo plano, usarla desde esta opción
+        if (tomarInstantanea(publicador, personas, versionVista, indiceFechas, indiceValores, cubo)) {
+            std::cout << "\n[Conjunto actualizado a la versión " << versionVista
+                      << ": " << personas.size() << " personas]\n";
+            cache.descartarAnteriores(versionVista);
+        }
+        
         // Variables locales para uso en los casos
         size_t tam = 0;
         int indice;
@@ -161,12 +413,20 @@ int main() {
                     break;
                 }
                 
+                if (publicador.ocupado()) {
+                    std::cout << "Esperando la generación en segundo plano en curso...\n";
+                }
+                publicador.esperar();
+                
                 // Generar el nuevo conjunto de personas
                 auto nuevasPersonas = generarColeccion(n);
                 tam = nuevasPersonas.size();
                 
-                // Mover el conjunto al puntero inteligente (propiedad única)
-                personas = std::make_unique<std::vector<Persona>>(std::move(nuevasPersonas));
+                // Publicar la versión nueva: la anterior (personas y arena de cadenas) se
+                // libera cuando ninguna copia del manejador la siga usando
+                publicador.publicar(std::move(nuevasPersonas));
+                tomarInstantanea(publicador, personas, versionVista, indiceFechas, indiceValores, cubo);
+                cache.descartarAnteriores(versionVista);
                 
                 // Medir tiempo y memoria usada
                 double tiempo_gen = monitor.detener_tiempo();
@@ -181,16 +441,16 @@ int main() {
             }
                 
             case 2: { // Mostrar resumen de todas las personas
-                if (!personas || personas->empty()) {
+                if (personas.empty()) {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
                 }
                 
-                tam = personas->size();
+                tam = personas.size();
                 std::cout << "\n=== RESUMEN DE PERSONAS (" << tam << ") ===\n";
                 for(size_t i = 0; i < tam; ++i) {
                     std::cout << i << ". ";
-                    (*personas)[i].mostrarResumen();
+                    personas[i].mostrarResumen();
                     std::cout << "\n";
                 }
                 
@@ -201,16 +461,16 @@ int main() {
             }
                 
             case 3: { // Mostrar detalle por índice
-                if (!personas || personas->empty()) {
+                if (personas.empty()) {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
                 }
                 
-                tam = personas->size();
+                tam = personas.size();
                 std::cout << "\nIngrese el índice (0-" << tam-1 << "): ";
                 if(std::cin >> indice) {
                     if(indice >= 0 && static_cast<size_t>(indice) < tam) {
-                        (*personas)[indice].mostrar();
+                        personas[indice].mostrar();
                     } else {
                         std::cout << "Índice fuera de rango!\n";
                     }
@@ -227,7 +487,7 @@ int main() {
             }
                 
             case 4: { // Buscar por ID
-                if (!personas || personas->empty()) {
+                if (personas.empty()) {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
                 }
@@ -238,14 +498,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                const Persona* encontrada_ap = buscarPorID(*personas, idBusqueda);
+                const Persona* encontrada_ap = buscarPorID(personas.datos(), idBusqueda);
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                Persona encontrada_val = buscarPorIDValor(*personas, idBusqueda);
+                [[maybe_unused]] Persona encontrada_val = buscarPorIDValor(personas, idBusqueda);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
                 
@@ -276,7 +536,7 @@ int main() {
 
             case 7: 
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
@@ -285,14 +545,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                const Persona* mayor_ap = buscarLongeva(*personas);
+                const Persona* mayor_ap = buscarLongeva(personas.datos());
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                Persona mayor_val = buscarLongevaValor(*personas);
+                [[maybe_unused]] Persona mayor_val = buscarLongevaValor(personas);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
                 
@@ -311,25 +571,33 @@ int main() {
 
             case 8:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout<<"\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
                 }
 
-                // Ejecutar con apuntadores
+                // Ejecutar con apuntadores (memorizado para la versión vista del conjunto)
+                bool acierto;
+                double ahorro;
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                auto longevasPorCiudad_ap = buscarLongevaPorCiudad(*personas);
+                const auto& longevasPorCiudad_ap = cache.obtener("longeva_por_ciudad", "", versionVista,
+                    [&]() { return buscarLongevaPorCiudad(personas.datos()); }, acierto, ahorro);
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
+                monitor.registrar_cache("Longeva por ciudad", acierto, ahorro);
                 
-                // Ejecutar con paso por valor
-                monitor.iniciar_tiempo();
-                long memoria_inicio_val = monitor.obtener_memoria();
-                auto longevasPorCiudad_val = buscarLongevaPorCiudadValor(*personas);
-                double tiempo_val = monitor.detener_tiempo();
-                long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
+                // Ejecutar con paso por valor (solo si hubo que recorrer el conjunto)
+                double tiempo_val = 0;
+                long memoria_val = 0;
+                if (!acierto) {
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_val = monitor.obtener_memoria();
+                    [[maybe_unused]] auto longevasPorCiudad_val = buscarLongevaPorCiudadValor(personas);
+                    tiempo_val = monitor.detener_tiempo();
+                    memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
+                }
 
                 std::cout << "\n=== PERSONA MÁS LONGEVA POR CIUDAD ===\n";
                 std::cout << "Total de ciudades: " << longevasPorCiudad_ap.size() << "\n\n";
@@ -344,7 +612,12 @@ int main() {
                 }
 
                 // Mostrar comparación de rendimiento
-                mostrarComparacion("Longeva por ciudad", tiempo_val, memoria_val, tiempo_ap, memoria_ap);
+                if (acierto) {
+                    std::cout << "Resultado desde la caché en " << tiempo_ap << " ms (calcularlo tomó "
+                              << ahorro << " ms)\n";
+                } else {
+                    mostrarComparacion("Longeva por ciudad", tiempo_val, memoria_val, tiempo_ap, memoria_ap);
+                }
 
                 double tiempo_longeva = monitor.detener_tiempo();
                 long memoria_longeva = monitor.obtener_memoria() - memoria_inicio;
@@ -354,7 +627,7 @@ int main() {
 
             case 9:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
@@ -363,14 +636,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                const Persona* masRico_ap = buscarPatrimonio(*personas);
+                const Persona* masRico_ap = buscarPatrimonio(personas.datos());
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                Persona masRico_val = buscarPatrimonioValor(*personas);
+                [[maybe_unused]] Persona masRico_val = buscarPatrimonioValor(personas);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
                 
@@ -388,25 +661,33 @@ int main() {
 
             case 10:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
                 }
 
-                // Ejecutar con apuntadores
+                // Ejecutar con apuntadores (memorizado para la versión vista del conjunto)
+                bool acierto;
+                double ahorro;
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                auto patrimonioPorCiudad_ap = buscarPatrimonioPorCiudad(*personas);
+                const auto& patrimonioPorCiudad_ap = cache.obtener("patrimonio_por_ciudad", "", versionVista,
+                    [&]() { return buscarPatrimonioPorCiudad(personas.datos()); }, acierto, ahorro);
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
+                monitor.registrar_cache("Mayor patrimonio por ciudad", acierto, ahorro);
                 
-                // Ejecutar con paso por valor
-                monitor.iniciar_tiempo();
-                long memoria_inicio_val = monitor.obtener_memoria();
-                auto patrimonioPorCiudad_val = buscarPatrimonioPorCiudadValor(*personas);
-                double tiempo_val = monitor.detener_tiempo();
-                long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
+                // Ejecutar con paso por valor (solo si hubo que recorrer el conjunto)
+                double tiempo_val = 0;
+                long memoria_val = 0;
+                if (!acierto) {
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_val = monitor.obtener_memoria();
+                    [[maybe_unused]] auto patrimonioPorCiudad_val = buscarPatrimonioPorCiudadValor(personas);
+                    tiempo_val = monitor.detener_tiempo();
+                    memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
+                }
 
                 std::cout << "\n=== PERSONA MÁS RICA POR CIUDAD ===\n";
                 std::cout << "Total de ciudades: " << patrimonioPorCiudad_ap.size() << "\n\n";
@@ -420,7 +701,12 @@ int main() {
                 }
 
                 // Mostrar comparación de rendimiento
-                mostrarComparacion("Mayor patrimonio por ciudad", tiempo_val, memoria_val, tiempo_ap, memoria_ap);
+                if (acierto) {
+                    std::cout << "Resultado desde la caché en " << tiempo_ap << " ms (calcularlo tomó "
+                              << ahorro << " ms)\n";
+                } else {
+                    mostrarComparacion("Mayor patrimonio por ciudad", tiempo_val, memoria_val, tiempo_ap, memoria_ap);
+                }
 
                 double tiempo_patrimonio = monitor.detener_tiempo();
                 long memoria_patrimonio = monitor.obtener_memoria() - memoria_inicio;
@@ -430,7 +716,7 @@ int main() {
 
             case 11:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
@@ -439,14 +725,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                auto patrimonioPorCalendario_ap = buscarPatrimonioPorCalendario(*personas);
+                auto patrimonioPorCalendario_ap = buscarPatrimonioPorCalendario(personas.datos());
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                auto patrimonioPorCalendario_val = buscarPatrimonioPorCalendarioValor(*personas);
+                auto patrimonioPorCalendario_val = buscarPatrimonioPorCalendarioValor(personas);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
                 
@@ -473,7 +759,7 @@ int main() {
 
             case 12:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
@@ -482,14 +768,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                listarPersonasCalendario(*personas);
+                listarPersonasCalendario(personas.datos());
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                listarPersonasCalendarioValor(*personas);
+                listarPersonasCalendarioValor(personas);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
 
@@ -504,7 +790,7 @@ int main() {
 
             case 13:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
@@ -513,14 +799,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                top3CiudadesPatrimonio(*personas);
+                top3CiudadesPatrimonio(personas.datos());
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                top3CiudadesPatrimonioValor(*personas);
+                top3CiudadesPatrimonioValor(personas);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
 
@@ -535,7 +821,7 @@ int main() {
 
             case 14:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
@@ -544,14 +830,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                const Persona* masEndeudado_ap = buscarDeudas(*personas);
+                const Persona* masEndeudado_ap = buscarDeudas(personas.datos());
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                Persona masEndeudado_val = buscarDeudasValor(*personas);
+                [[maybe_unused]] Persona masEndeudado_val = buscarDeudasValor(personas);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
                 
@@ -570,7 +856,7 @@ int main() {
 
             case 15:
             {
-                if (!personas || personas->empty())
+                if (personas.empty())
                 {
                     std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
                     break;
@@ -579,14 +865,14 @@ int main() {
                 // Ejecutar con apuntadores
                 monitor.iniciar_tiempo();
                 long memoria_inicio_ap = monitor.obtener_memoria();
-                const Persona* nombreMasLargo_ap = buscarNombreMasLargo(*personas);
+                const Persona* nombreMasLargo_ap = buscarNombreMasLargo(personas.datos());
                 double tiempo_ap = monitor.detener_tiempo();
                 long memoria_ap = monitor.obtener_memoria() - memoria_inicio_ap;
                 
                 // Ejecutar con paso por valor
                 monitor.iniciar_tiempo();
                 long memoria_inicio_val = monitor.obtener_memoria();
-                Persona nombreMasLargo_val = buscarNombreMasLargoValor(*personas);
+                [[maybe_unused]] Persona nombreMasLargo_val = buscarNombreMasLargoValor(personas);
                 double tiempo_val = monitor.detener_tiempo();
                 long memoria_val = monitor.obtener_memoria() - memoria_inicio_val;
                 
@@ -605,10 +891,1423 @@ int main() {
                 monitor.registrar("Nombre más largo", tiempo_patrimonio, memoria_patrimonio);
                 break;
             }
+            case 16:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                // Copia profunda: lo que costaba antes cada llamada *Valor
+                monitor.iniciar_tiempo();
+                long memoria_inicio_prof = monitor.obtener_memoria();
+                std::vector<Persona> copiaProfunda = personas.datos();
+                double tiempo_prof = monitor.detener_tiempo();
+                long memoria_prof = monitor.obtener_memoria() - memoria_inicio_prof;
+
+                // Copia del manejador: solo incrementa el contador de referencias
+                monitor.iniciar_tiempo();
+                long memoria_inicio_cow = monitor.obtener_memoria();
+                ColeccionPersonas copiaCompartida = personas;
+                double tiempo_cow = monitor.detener_tiempo();
+                long memoria_cow = monitor.obtener_memoria() - memoria_inicio_cow;
+
+                std::cout << "\nPersonas copiadas: " << copiaProfunda.size() << "\n";
+                std::cout << "Manejadores que comparten el buffer: " << copiaCompartida.referencias() << "\n";
+                mostrarComparacion("Copia del conjunto", tiempo_prof, memoria_prof, tiempo_cow, memoria_cow,
+                                   "Copia profunda", "Copia COW");
+
+                double tiempo_copia = monitor.detener_tiempo();
+                long memoria_copia = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Copia profunda vs COW", tiempo_copia, memoria_copia);
+                break;
+            }
+            case 17:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                asegurarIndiceFechas(indiceFechas, personas, monitor);
+
+                std::cout << "\n=== CONSULTAS POR FECHA DE NACIMIENTO ===";
+                std::cout << "\n1. Personas nacidas entre dos años";
+                std::cout << "\n2. Personas con al menos X años de edad";
+                std::cout << "\n3. K personas más longevas";
+                std::cout << "\n4. K personas más jóvenes";
+                std::cout << "\n5. Conteo por cohortes de nacimiento";
+                std::cout << "\nSeleccione: ";
+                int sub;
+                std::cin >> sub;
+
+                monitor.iniciar_tiempo();
+                long memoria_inicio_idx = monitor.obtener_memoria();
+
+                switch (sub) {
+                    case 1: {
+                        int desde, hasta;
+                        std::cout << "Año inicial: ";
+                        std::cin >> desde;
+                        std::cout << "Año final: ";
+                        std::cin >> hasta;
+                        std::string ciudad = leerCiudad();
+                        monitor.iniciar_tiempo();
+                        auto resultado = indiceFechas.rango(desde * 10000, hasta * 10000 + 1231, ciudad);
+                        mostrarPrimeras(resultado);
+                        break;
+                    }
+                    case 2: {
+                        int edad;
+                        std::cout << "Edad mínima: ";
+                        std::cin >> edad;
+                        std::string ciudad = leerCiudad();
+                        std::time_t ahora = std::time(nullptr);
+                        std::tm* hoy = std::localtime(&ahora);
+                        // Tiene al menos 'edad' años quien nació en o antes de hoy hace 'edad' años
+                        int corte = (hoy->tm_year + 1900 - edad) * 10000 + (hoy->tm_mon + 1) * 100 + hoy->tm_mday;
+                        monitor.iniciar_tiempo();
+                        auto resultado = indiceFechas.rango(0, corte, ciudad);
+                        mostrarPrimeras(resultado);
+                        break;
+                    }
+                    case 3:
+                    case 4: {
+                        size_t k;
+                        std::cout << "K: ";
+                        std::cin >> k;
+                        std::string ciudad = leerCiudad();
+                        monitor.iniciar_tiempo();
+                        auto resultado = (sub == 3) ? indiceFechas.masLongevas(k, ciudad)
+                                                    : indiceFechas.masJovenes(k, ciudad);
+                        mostrarPrimeras(resultado, k);
+                        break;
+                    }
+                    case 5: {
+                        int ancho;
+                        std::cout << "Ancho de la cohorte en años (ej. 5 o 10): ";
+                        std::cin >> ancho;
+                        std::string ciudad = leerCiudad();
+                        monitor.iniciar_tiempo();
+                        auto cohortes = indiceFechas.conteoCohortes(ancho, ciudad);
+                        std::cout << "\nCohorte        | Personas\n";
+                        for (const auto& [anio, cantidad] : cohortes) {
+                            std::cout << anio << "-" << anio + ancho - 1 << "      | " << cantidad << "\n";
+                        }
+                        break;
+                    }
+                    default:
+                        std::cout << "Opción inválida!\n";
+                }
+
+                double tiempo_consulta = monitor.detener_tiempo();
+                long memoria_consulta = monitor.obtener_memoria() - memoria_inicio_idx;
+                monitor.registrar("Consulta indice fechas", tiempo_consulta, memoria_consulta);
+                break;
+            }
+            case 18:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                asegurarIndiceValores(indiceValores, personas, monitor);
+
+                int numCampo;
+                std::cout << "\nCampo (1=Patrimonio, 2=Ingresos anuales, 3=Deudas): ";
+                std::cin >> numCampo;
+                if (numCampo < 1 || numCampo > 3) {
+                    std::cout << "Campo inválido!\n";
+                    break;
+                }
+                CampoFinanciero campo = static_cast<CampoFinanciero>(numCampo - 1);
+
+                std::cout << "\n=== PERCENTILES Y RANGOS ===";
+                std::cout << "\n1. Percentil de una persona (por ID)";
+                std::cout << "\n2. Valor en un percentil";
+                std::cout << "\n3. Personas entre dos percentiles";
+                std::cout << "\n4. Personas entre dos valores";
+                std::cout << "\nSeleccione: ";
+                int sub;
+                std::cin >> sub;
+
+                long memoria_inicio_idx = monitor.obtener_memoria();
+                double tiempo_consulta = 0.0;
+
+                switch (sub) {
+                    case 1: {
+                        std::cout << "ID: ";
+                        std::cin >> idBusqueda;
+                        size_t rango;
+                        double percentil;
+                        const Persona* persona = nullptr;
+                        monitor.iniciar_tiempo();
+                        bool encontrada = indiceValores.rangoDeID(campo, idBusqueda, rango, percentil, persona);
+                        tiempo_consulta = monitor.detener_tiempo();
+                        if (encontrada) {
+                            persona->mostrar();
+                            std::cout << "\nPosición " << rango + 1 << " de " << indiceValores.size()
+                                      << " (percentil " << std::setprecision(2) << percentil << ")\n";
+                        } else {
+                            std::cout << "No se encontró persona con ID " << idBusqueda << "\n";
+                        }
+                        break;
+                    }
+                    case 2: {
+                        double p;
+                        std::cout << "Percentil (0-100): ";
+                        std::cin >> p;
+                        monitor.iniciar_tiempo();
+                        double valor = indiceValores.valorEnPercentil(campo, p);
+                        tiempo_consulta = monitor.detener_tiempo();
+                        std::cout << "\nValor en el percentil " << p << ": $" << std::fixed
+                                  << std::setprecision(2) << valor << " COP\n";
+                        break;
+                    }
+                    case 3:
+                    case 4: {
+                        double desde, hasta;
+                        std::cout << (sub == 3 ? "Percentil inicial: " : "Valor mínimo: ");
+                        std::cin >> desde;
+                        std::cout << (sub == 3 ? "Percentil final: " : "Valor máximo: ");
+                        std::cin >> hasta;
+                        monitor.iniciar_tiempo();
+                        auto resultado = (sub == 3) ? indiceValores.entrePercentiles(campo, desde, hasta)
+                                                    : indiceValores.entreValores(campo, desde, hasta);
+                        tiempo_consulta = monitor.detener_tiempo();
+                        mostrarPrimeras(resultado);
+                        break;
+                    }
+                    default:
+                        std::cout << "Opción inválida!\n";
+                }
+
+                long memoria_consulta = monitor.obtener_memoria() - memoria_inicio_idx;
+                monitor.registrar("Consulta indice valores", tiempo_consulta, memoria_consulta);
+                break;
+            }
+            case 19:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                int numCampo;
+                std::cout << "\nCampo (1=Ingresos anuales, 2=Patrimonio): ";
+                std::cin >> numCampo;
+                bool ingresos = (numCampo == 1);
+                const std::vector<double> cuantiles = {0.5, 0.9, 0.99};
+
+                // Sketches KLL: una pasada paralela, memoria acotada por grupo
+                monitor.iniciar_tiempo();
+                long memoria_inicio_sk = monitor.obtener_memoria();
+                ResumenCuantiles sketches = calcularSketchesCuantiles(personas.datos());
+                double tiempo_sk = monitor.detener_tiempo();
+                long memoria_sk = monitor.obtener_memoria() - memoria_inicio_sk;
+
+                // Referencia exacta: agrupar y ordenar todos los valores. Se calculan los dos
+                // campos, igual que la pasada de sketches, para comparar el mismo trabajo.
+                monitor.iniciar_tiempo();
+                long memoria_inicio_ex = monitor.obtener_memoria();
+                CuantilesExactos exactosIngresos = calcularCuantilesExactos(personas.datos(), true, cuantiles);
+                CuantilesExactos exactosPatrimonio = calcularCuantilesExactos(personas.datos(), false, cuantiles);
+                double tiempo_ex = monitor.detener_tiempo();
+                long memoria_ex = monitor.obtener_memoria() - memoria_inicio_ex;
+                CuantilesExactos& exactos = ingresos ? exactosIngresos : exactosPatrimonio;
+
+                std::cout << "\n=== " << (ingresos ? "INGRESOS ANUALES" : "PATRIMONIO")
+                          << ": SKETCH vs EXACTO (millones COP, error relativo) ===\n";
+                std::cout << "Grupo           |            p50 (sketch/exacto)  "
+                          << "|            p90 (sketch/exacto)  |            p99 (sketch/exacto)\n";
+                for (const auto& [ciudad, grupo] : sketches.porCiudad) {
+                    mostrarFilaCuantiles(ciudad, ingresos ? grupo.ingresos : grupo.patrimonio,
+                                         cuantiles, exactos.porCiudad[ciudad]);
+                }
+                for (const auto& [calendario, grupo] : sketches.porCalendario) {
+                    mostrarFilaCuantiles(std::string("Calendario ") + calendario,
+                                         ingresos ? grupo.ingresos : grupo.patrimonio,
+                                         cuantiles, exactos.porCalendario[calendario]);
+                }
+
+                mostrarComparacion("Percentiles por grupo", tiempo_ex, memoria_ex, tiempo_sk, memoria_sk,
+                                   "Exacto (ordena)", "Sketch KLL");
+
+                double tiempo_cuantiles = monitor.detener_tiempo();
+                long memoria_cuantiles = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Percentiles sketch vs exacto", tiempo_cuantiles, memoria_cuantiles);
+                break;
+            }
+            case 20:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                std::cout << "\n1. Apellidos distintos en todo el país";
+                std::cout << "\n2. Combinaciones nombre + apellido distintas por ciudad";
+                std::cout << "\nSeleccione: ";
+                int sub;
+                std::cin >> sub;
+                if (sub != 1 && sub != 2) {
+                    std::cout << "Opción inválida!\n";
+                    break;
+                }
+
+                std::map<std::string, double> estimados;
+                std::map<std::string, size_t> exactos;
+                size_t bytesHLL = 0, bytesExacto = 0;
+                double errorTeorico = 0.0;
+
+                // Estimación con HyperLogLog (pasada paralela, registros por hilo)
+                monitor.iniciar_tiempo();
+                long memoria_inicio_hll = monitor.obtener_memoria();
+                if (sub == 1) {
+                    HyperLogLog hll = estimarApellidosDistintos(personas.datos());
+                    estimados["Todo el país"] = hll.estimar();
+                    bytesHLL = hll.bytes();
+                    errorTeorico = hll.errorEstandar();
+                } else {
+                    for (const auto& [ciudad, hll] : estimarNombresDistintosPorCiudad(personas.datos())) {
+                        estimados[ciudad] = hll.estimar();
+                        bytesHLL += hll.bytes();
+                        errorTeorico = hll.errorEstandar();
+                    }
+                }
+                double tiempo_hll = monitor.detener_tiempo();
+                long memoria_hll = monitor.obtener_memoria() - memoria_inicio_hll;
+                monitor.registrar("Distintos HyperLogLog", tiempo_hll, memoria_hll);
+
+                // Línea base exacta con unordered_set<std::string>
+                monitor.iniciar_tiempo();
+                long memoria_inicio_ex = monitor.obtener_memoria();
+                if (sub == 1) {
+                    exactos["Todo el país"] = contarApellidosDistintosExacto(personas.datos(), bytesExacto);
+                } else {
+                    exactos = contarNombresDistintosPorCiudadExacto(personas.datos(), bytesExacto);
+                }
+                double tiempo_ex = monitor.detener_tiempo();
+                long memoria_ex = monitor.obtener_memoria() - memoria_inicio_ex;
+                monitor.registrar("Distintos exacto (hash set)", tiempo_ex, memoria_ex);
+
+                std::cout << "\nGrupo           |     Estimado |       Exacto |   Error real\n";
+                for (const auto& [grupo, estimado] : estimados) {
+                    double exacto = static_cast<double>(exactos[grupo]);
+                    double error = exacto > 0 ? 100.0 * (estimado - exacto) / exacto : 0.0;
+                    std::cout << std::left << std::setw(15) << grupo << std::right << " | "
+                              << std::setw(12) << std::fixed << std::setprecision(0) << estimado << " | "
+                              << std::setw(12) << exacto << " | "
+                              << std::setw(10) << std::setprecision(2) << error << " %\n";
+                }
+                std::cout << "\nCota de error (1 desviación estándar): +/- " << std::setprecision(2)
+                          << errorTeorico * 100 << " %, (3 desviaciones: +/- " << errorTeorico * 300 << " %)\n";
+                std::cout << "Memoria de la estructura: HyperLogLog " << bytesHLL / 1024
+                          << " KB vs conjunto exacto ~" << bytesExacto / 1024 << " KB\n";
+
+                mostrarComparacion("Conteo de distintos", tiempo_ex, memoria_ex, tiempo_hll, memoria_hll,
+                                   "Conjunto exacto", "HyperLogLog");
+
+                double tiempo_distintos = monitor.detener_tiempo();
+                long memoria_distintos = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Conteo de distintos", tiempo_distintos, memoria_distintos);
+                break;
+            }
+            case 21:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                // Persona -> compacto
+                monitor.iniciar_tiempo();
+                long memoria_inicio_comp = monitor.obtener_memoria();
+                ColeccionCompacta compacta(personas.datos());
+                double tiempo_comp = monitor.detener_tiempo();
+                long memoria_comp = monitor.obtener_memoria() - memoria_inicio_comp;
+                monitor.registrar("Convertir a compacto", tiempo_comp, memoria_comp);
+
+                // Compacto -> Persona (verificación de ida y vuelta)
+                monitor.iniciar_tiempo();
+                long memoria_inicio_rec = monitor.obtener_memoria();
+                ColeccionPersonas reconstruidas = compacta.aPersonas();
+                double tiempo_rec = monitor.detener_tiempo();
+                long memoria_rec = monitor.obtener_memoria() - memoria_inicio_rec;
+                monitor.registrar("Compacto a Persona", tiempo_rec, memoria_rec);
+
+                size_t diferentes = 0;
+                for (size_t i = 0; i < reconstruidas.size(); ++i) {
+                    const Persona& a = personas[i];
+                    const Persona& b = reconstruidas[i];
+                    if (a.getId() != b.getId() || a.getNombre() != b.getNombre() ||
+                        a.getApellido() != b.getApellido() || a.getCiudadNacimiento() != b.getCiudadNacimiento() ||
+                        a.claveFechaNacimiento() != b.claveFechaNacimiento() ||
+                        a.getDeclaranteRenta() != b.getDeclaranteRenta() ||
+                        a.getCalendarioTributario() != b.getCalendarioTributario() ||
+                        std::abs(a.getIngresosAnuales() - b.getIngresosAnuales()) >= 0.01 || // Menos de un centavo
+                        std::abs(a.getPatrimonio() - b.getPatrimonio()) >= 0.01 ||
+                        std::abs(a.getDeudas() - b.getDeudas()) >= 0.01) {
+                        ++diferentes;
+                    }
+                }
+
+                size_t bytesPersona = personas.bytesTotales();
+                size_t bytesCompacta = compacta.bytesTotales();
+                monitor.registrar_memoria("ColeccionPersonas (con arena)", bytesPersona, personas.size());
+                monitor.registrar_memoria("ColeccionCompacta", bytesCompacta, compacta.size());
+
+                double porPersona = static_cast<double>(bytesPersona) / personas.size();
+                double porCompacta = static_cast<double>(bytesCompacta) / compacta.size();
+                std::cout << "\n=== REGISTROS COMPACTOS ===\n";
+                std::cout << "sizeof(Persona): " << sizeof(Persona) << " bytes, sizeof(PersonaCompacta): "
+                          << sizeof(PersonaCompacta) << " bytes\n";
+                std::cout << std::fixed << std::setprecision(1);
+                std::cout << "Persona:  " << bytesPersona / 1024 << " KB (" << porPersona << " bytes/persona)\n";
+                std::cout << "Compacta: " << bytesCompacta / 1024 << " KB (" << porCompacta << " bytes/persona)\n";
+                std::cout << "Proyección para 100 millones: Persona " << porPersona * 1e8 / (1 << 30)
+                          << " GB, compacta " << porCompacta * 1e8 / (1 << 30) << " GB\n";
+                std::cout << "Ciudades en el diccionario: " << compacta.diccionarioCiudades().size() << "\n";
+                std::cout << "Verificación ida y vuelta: " << (diferentes == 0 ? "OK" : "FALLÓ")
+                          << " (" << diferentes << " diferencias)\n";
+                std::cout << "Conversión: " << tiempo_comp << " ms a compacto, " << tiempo_rec << " ms de regreso\n";
+
+                double tiempo_compacta = monitor.detener_tiempo();
+                long memoria_compacta = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Registros compactos", tiempo_compacta, memoria_compacta);
+                break;
+            }
+            case 22:
+            {
+                std::cout << "\n=== CONJUNTO PARTICIONADO POR NODO NUMA ===";
+                std::cout << "\nNodos: " << numeroNodosNUMA()
+                          << (numaDisponible() ? " (libnuma)" : " (sin libnuma: un solo nodo lógico)");
+                std::cout << "\n1. Generar conjunto particionado";
+                std::cout << "\n2. Resumen por ciudad (agregación local por nodo)";
+                std::cout << "\nSeleccione: ";
+                int sub;
+                std::cin >> sub;
+
+                if (sub == 1) {
+                    std::cout << "Número de personas: ";
+                    long n;
+                    std::cin >> n;
+                    if (n <= 0) {
+                        std::cout << "Error: Debe generar al menos 1 persona\n";
+                        break;
+                    }
+
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_part = monitor.obtener_memoria();
+                    particionado = ColeccionParticionada(); // Liberar el anterior antes de generar
+                    particionado = generarColeccionParticionada(static_cast<size_t>(n));
+                    double tiempo_part = monitor.detener_tiempo();
+                    long memoria_part = monitor.obtener_memoria() - memoria_inicio_part;
+                    monitor.registrar("Generar particionado", tiempo_part, memoria_part);
+
+                    std::vector<int> nodos;
+                    std::vector<double> tiempos;
+                    std::cout << "\nPartición | Nodo | Fijada | Hilos | Personas     | Generación (ms)\n";
+                    for (size_t p = 0; p < particionado.particiones().size(); ++p) {
+                        const ParticionNodo& parte = particionado.particiones()[p];
+                        std::cout << std::setw(9) << p << " | " << std::setw(4) << parte.nodo << " | "
+                                  << std::setw(6) << (parte.fijada ? "sí" : "no") << " | "
+                                  << std::setw(5) << parte.hilos << " | " << std::setw(12) << parte.personas.size()
+                                  << " | " << std::fixed << std::setprecision(2) << parte.tiempoGeneracion << "\n";
+                        nodos.push_back(parte.nodo);
+                        tiempos.push_back(parte.tiempoGeneracion);
+                    }
+                    monitor.registrar_particiones("Generar particionado", nodos, tiempos);
+                    std::cout << "Total: " << particionado.size() << " personas en " << tiempo_part << " ms\n";
+                } else if (sub == 2) {
+                    if (particionado.empty()) {
+                        std::cout << "\nNo hay conjunto particionado. Use la subopción 1 primero.\n";
+                        break;
+                    }
+
+                    // Referencia: un solo hilo recorre todas las particiones
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_sec = monitor.obtener_memoria();
+                    ResumenCiudades secuencial = resumirPorCiudadSecuencial(particionado);
+                    double tiempo_sec = monitor.detener_tiempo();
+                    long memoria_sec = monitor.obtener_memoria() - memoria_inicio_sec;
+
+                    // Parciales locales por nodo + combinación final
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_loc = monitor.obtener_memoria();
+                    std::vector<double> tiempos;
+                    ResumenCiudades local = resumirPorCiudad(particionado, tiempos);
+                    double tiempo_loc = monitor.detener_tiempo();
+                    long memoria_loc = monitor.obtener_memoria() - memoria_inicio_loc;
+
+                    std::vector<int> nodos;
+                    for (const auto& parte : particionado.particiones()) {
+                        nodos.push_back(parte.nodo);
+                    }
+                    monitor.registrar("Resumen ciudad secuencial", tiempo_sec, memoria_sec);
+                    monitor.registrar("Resumen ciudad por nodo", tiempo_loc, memoria_loc);
+                    monitor.registrar_particiones("Resumen ciudad por nodo", nodos, tiempos);
+
+                    std::cout << "\nCiudad          |   Personas | Declarantes | Patrimonio prom. | Más rica      | Más longeva\n";
+                    size_t diferencias = 0;
+                    for (const auto& [ciudad, agregado] : local) {
+                        const AgregadoCiudad& ref = secuencial[ciudad];
+                        if (ref.personas != agregado.personas || ref.declarantes != agregado.declarantes ||
+                            ref.patrimonioMaximo != agregado.patrimonioMaximo ||
+                            ref.fechaMasAntigua != agregado.fechaMasAntigua) {
+                            ++diferencias;
+                        }
+                        std::cout << std::left << std::setw(15) << ciudad << std::right << " | "
+                                  << std::setw(10) << agregado.personas << " | "
+                                  << std::setw(11) << agregado.declarantes << " | "
+                                  << std::setw(14) << std::fixed << std::setprecision(0)
+                                  << agregado.patrimonioTotal / agregado.personas / 1e6 << "M | "
+                                  << std::setw(13) << agregado.masRica->getId() << " | "
+                                  << agregado.masLongeva->getFechaNacimiento() << "\n";
+                    }
+                    if (local.size() != secuencial.size()) {
+                        ++diferencias;
+                    }
+                    std::cout << "Verificación contra el recorrido secuencial: "
+                              << (diferencias == 0 ? "OK" : "FALLÓ") << "\n";
+                    std::cout << std::setprecision(2);
+                    for (size_t p = 0; p < tiempos.size(); ++p) {
+                        std::cout << "Partición " << p << " (nodo " << nodos[p] << "): " << tiempos[p] << " ms\n";
+                    }
+                    mostrarComparacion("Resumen por ciudad", tiempo_sec, memoria_sec, tiempo_loc, memoria_loc,
+                                       "Un hilo", "Local por nodo");
+                } else {
+                    std::cout << "Subopción inválida\n";
+                    break;
+                }
+
+                double tiempo_numa = monitor.detener_tiempo();
+                long memoria_numa = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Particionado NUMA", tiempo_numa, memoria_numa);
+                break;
+            }
+            case 23:
+            {
+                std::cout << "\n=== INSTANTÁNEAS RCU ===";
+                std::cout << "\nVersión publicada: " << publicador.version() << " ("
+                          << publicador.leer()->personas.size() << " personas)"
+                          << (publicador.ocupado() ? ", generación en curso" : "");
+                std::cout << "\n1. Regenerar el conjunto en segundo plano";
+                std::cout << "\n2. Agregar personas al conjunto en segundo plano";
+                std::cout << "\n3. Estadísticas de publicación";
+                std::cout << "\n4. Consultar mientras se regenera (lectores concurrentes)";
+                std::cout << "\nSeleccione: ";
+                int sub;
+                std::cin >> sub;
+
+                if (sub == 1 || sub == 2) {
+                    int n;
+                    std::cout << "Número de personas: ";
+                    std::cin >> n;
+                    if (n <= 0) {
+                        std::cout << "Error: Debe generar al menos 1 persona\n";
+                        break;
+                    }
+                    if (!publicador.generarEnSegundoPlano(n, sub == 2)) {
+                        std::cout << "Ya hay una generación en segundo plano; intente más tarde.\n";
+                        break;
+                    }
+                    std::cout << "Generación iniciada. El menú sigue usando la versión " << versionVista
+                              << " hasta que se publique la nueva.\n";
+                } else if (sub == 3) {
+                    PublicadorPersonas::Estadisticas e = publicador.estadisticas();
+                    std::cout << std::fixed << std::setprecision(3);
+                    std::cout << "\nPublicaciones: " << e.publicaciones << "\n";
+                    std::cout << "Latencia de intercambio (us): mín " << e.latenciaMinima
+                              << ", prom " << e.latenciaPromedio << ", máx " << e.latenciaMaxima << "\n";
+                    std::cout << "Última generación en segundo plano: " << e.ultimaGeneracion << " ms\n";
+                    std::cout << "Instantáneas liberadas: " << e.liberadas << "\n";
+                    monitor.registrar("Intercambio de instantanea (prom)", e.latenciaPromedio / 1000.0, 0);
+                } else if (sub == 4) {
+                    int n, lectores;
+                    std::cout << "Personas a generar: ";
+                    std::cin >> n;
+                    std::cout << "Hilos lectores: ";
+                    std::cin >> lectores;
+                    if (n <= 0 || lectores <= 0) {
+                        std::cout << "Error: valores inválidos\n";
+                        break;
+                    }
+                    if (!publicador.generarEnSegundoPlano(n, false)) {
+                        std::cout << "Ya hay una generación en segundo plano; intente más tarde.\n";
+                        break;
+                    }
+
+                    // Cada lector toma la instantánea vigente en cada consulta y busca el
+                    // mayor patrimonio; nunca espera al generador.
+                    std::atomic<bool> detener{false};
+                    std::vector<size_t> consultas(lectores, 0);
+                    std::vector<double> peorConsulta(lectores, 0.0);
+                    std::vector<std::vector<uint64_t>> versiones(lectores);
+                    std::vector<std::thread> hilos;
+                    for (int l = 0; l < lectores; ++l) {
+                        hilos.emplace_back([&, l]() {
+                            do {
+                                auto inicio = std::chrono::high_resolution_clock::now();
+                                std::shared_ptr<const Instantanea> vista = publicador.leer();
+                                buscarPatrimonio(vista->personas.datos());
+                                std::chrono::duration<double, std::milli> d =
+                                    std::chrono::high_resolution_clock::now() - inicio;
+                                peorConsulta[l] = std::max(peorConsulta[l], d.count());
+                                ++consultas[l];
+                                if (versiones[l].empty() || versiones[l].back() != vista->version) {
+                                    versiones[l].push_back(vista->version);
+                                }
+                            } while (!detener.load());
+                        });
+                    }
+
+                    monitor.iniciar_tiempo();
+                    publicador.esperar();
+                    double tiempo_regen = monitor.detener_tiempo();
+                    detener.store(true);
+                    for (auto& h : hilos) {
+                        h.join();
+                    }
+
+                    std::cout << "\nRegeneración publicada en " << tiempo_regen << " ms\n";
+                    std::cout << "Lector | Consultas | Peor consulta (ms) | Versiones vistas\n";
+                    for (int l = 0; l < lectores; ++l) {
+                        std::cout << std::setw(6) << l << " | " << std::setw(9) << consultas[l] << " | "
+                                  << std::setw(18) << std::fixed << std::setprecision(2) << peorConsulta[l] << " | ";
+                        for (uint64_t v : versiones[l]) {
+                            std::cout << v << " ";
+                        }
+                        std::cout << "\n";
+                    }
+                    PublicadorPersonas::Estadisticas e = publicador.estadisticas();
+                    std::cout << "Latencia promedio de intercambio (us): " << std::setprecision(3)
+                              << e.latenciaPromedio << ", instantáneas liberadas: " << e.liberadas << "\n";
+                    monitor.registrar("Regenerar con lectores", tiempo_regen, 0);
+                } else {
+                    std::cout << "Subopción inválida\n";
+                    break;
+                }
+
+                double tiempo_rcu = monitor.detener_tiempo();
+                long memoria_rcu = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Instantaneas RCU", tiempo_rcu, memoria_rcu);
+                break;
+            }
+            case 24:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                int numCriterio, numSentido;
+                std::string ruta;
+                std::cout << "\nOrdenar por (1=Patrimonio, 2=Ingresos, 3=Deudas, 4=Fecha de nacimiento): ";
+                std::cin >> numCriterio;
+                if (numCriterio < 1 || numCriterio > 4) {
+                    std::cout << "Criterio inválido\n";
+                    break;
+                }
+                std::cout << "Sentido (1=Mayor a menor, 2=Menor a mayor): ";
+                std::cin >> numSentido;
+                std::cout << "Archivo de salida: ";
+                std::cin >> ruta;
+                monitor.iniciar_tiempo(); // Sin contar el tiempo de escribir las respuestas
+
+                CriterioOrden criterio = static_cast<CriterioOrden>(numCriterio - 1);
+                ResultadoExportacion r;
+                if (!exportarOrdenado(personas.datos(), criterio, numSentido == 1, ruta, r)) {
+                    perror(("Error al exportar a " + ruta).c_str());
+                    break;
+                }
+
+                std::string etiqueta = std::string("Ranking por ") + nombreCriterio(criterio);
+                std::cout << "\n=== EXPORTACIÓN ORDENADA ===\n";
+                std::cout << r.filas << " filas (" << r.bytes / 1024 << " KB) en " << ruta << "\n";
+                std::cout << "Ordenar (radix paralelo): " << r.tiempoOrdenar << " ms\n";
+                std::cout << "Formatear y escribir: " << r.tiempoEscribir << " ms\n";
+                if (r.tiempoOrdenar + r.tiempoEscribir > 0) {
+                    std::cout << "Rendimiento: " << static_cast<long>(r.filas / ((r.tiempoOrdenar + r.tiempoEscribir) / 1000.0))
+                              << " filas/s\n";
+                }
+                monitor.registrar_rendimiento(etiqueta + ": ordenar", r.filas, r.tiempoOrdenar);
+                monitor.registrar_rendimiento(etiqueta + ": escribir", r.filas, r.tiempoEscribir);
+                monitor.registrar_rendimiento(etiqueta + ": total", r.filas, r.tiempoOrdenar + r.tiempoEscribir);
+
+                double tiempo_export = monitor.detener_tiempo();
+                long memoria_export = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Exportar ordenado", tiempo_export, memoria_export);
+                break;
+            }
+            case 25:
+            {
+                if (personas.empty())
+                {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                asegurarCubo(cubo, personas, monitor);
+
+                std::cout << "\n1. Top 3 ciudades con mayor patrimonio promedio (cubo vs recorrido)";
+                std::cout << "\n2. Persona con mayor patrimonio por calendario (cubo vs recorrido)";
+                std::cout << "\n3. Consulta libre por ciudad, calendario, declarante y década";
+                std::cout << "\nSeleccione: ";
+                int sub;
+                std::cin >> sub;
+
+                if (sub == 1) {
+                    // Recorrido: el mismo cálculo de la opción 13 sin imprimir (la consola no se mide)
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_rec = monitor.obtener_memoria();
+                    auto sumas = agregacion::sumarPorGrupo<agregacion::PorCiudad, agregacion::Patrimonio>(personas.datos());
+                    std::vector<std::pair<std::string, double>> topRecorrido;
+                    for (const auto& [ciudad, suma] : sumas) {
+                        topRecorrido.emplace_back(ciudad, suma.promedio());
+                    }
+                    size_t k = std::min<size_t>(3, topRecorrido.size());
+                    std::partial_sort(topRecorrido.begin(), topRecorrido.begin() + k, topRecorrido.end(),
+                                      [](const auto& a, const auto& b) { return a.second > b.second; });
+                    topRecorrido.resize(k);
+                    double tiempo_rec = monitor.detener_tiempo();
+                    long memoria_rec = monitor.obtener_memoria() - memoria_inicio_rec;
+
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_cubo = monitor.obtener_memoria();
+                    auto top = cubo.topCiudadesPorPromedio(CampoFinanciero::Patrimonio, 3);
+                    double tiempo_cubo = monitor.detener_tiempo();
+                    long memoria_cubo = monitor.obtener_memoria() - memoria_inicio_cubo;
+
+                    std::cout << "\n=== TOP 3 DESDE EL CUBO ===\n";
+                    bool coinciden = top.size() == topRecorrido.size();
+                    for (size_t i = 0; i < top.size(); ++i) {
+                        std::cout << i + 1 << ". " << top[i].first << ": " << std::fixed << std::setprecision(2)
+                                  << top[i].second << "\n";
+                        coinciden = coinciden && top[i].first == topRecorrido[i].first;
+                    }
+                    std::cout.unsetf(std::ios::fixed);
+                    std::cout << "Recorrido completo: " << (coinciden ? "mismas ciudades" : "DIFIERE") << "\n";
+                    mostrarComparacion("Top 3 ciudades", tiempo_rec, memoria_rec, tiempo_cubo, memoria_cubo,
+                                       "Recorrido", "Cubo");
+                } else if (sub == 2) {
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_rec = monitor.obtener_memoria();
+                    auto porCalendario = buscarPatrimonioPorCalendario(personas.datos());
+                    double tiempo_rec = monitor.detener_tiempo();
+                    long memoria_rec = monitor.obtener_memoria() - memoria_inicio_rec;
+
+                    monitor.iniciar_tiempo();
+                    long memoria_inicio_cubo = monitor.obtener_memoria();
+                    const Persona* desdeCubo[3];
+                    for (int c = 0; c < 3; ++c) {
+                        desdeCubo[c] = cubo.maximo(cubo.celda(CuboOLAP::TODOS, c, CuboOLAP::TODOS, CuboOLAP::TODOS),
+                                                   CampoFinanciero::Patrimonio);
+                    }
+                    double tiempo_cubo = monitor.detener_tiempo();
+                    long memoria_cubo = monitor.obtener_memoria() - memoria_inicio_cubo;
+
+                    std::cout << "\n=== MAYOR PATRIMONIO POR CALENDARIO (CUBO) ===\n";
+                    for (int c = 0; c < 3; ++c) {
+                        char letra = static_cast<char>('A' + c);
+                        if (!desdeCubo[c]) {
+                            continue;
+                        }
+                        std::cout << "\nCalendario " << letra << ": ";
+                        desdeCubo[c]->mostrarResumen();
+                        auto recorrido = porCalendario.find(letra);
+                        bool coincide = recorrido != porCalendario.end() &&
+                                        recorrido->second->getPatrimonio() == desdeCubo[c]->getPatrimonio();
+                        std::cout << (coincide ? " [coincide con el recorrido]" : " [DIFIERE del recorrido]");
+                    }
+                    std::cout << "\n";
+                    mostrarComparacion("Mayor patrimonio por calendario", tiempo_rec, memoria_rec, tiempo_cubo, memoria_cubo,
+                                       "Recorrido", "Cubo");
+                } else if (sub == 3) {
+                    std::string ciudadTexto = leerCiudad();
+                    std::string calendarioTexto, declaranteTexto, decadaTexto;
+                    std::cout << "Calendario (A, B, C o *): ";
+                    std::cin >> calendarioTexto;
+                    std::cout << "Declarante (s, n o *): ";
+                    std::cin >> declaranteTexto;
+                    std::cout << "Década de nacimiento (p. ej. 1980, o *): ";
+                    std::cin >> decadaTexto;
+
+                    int ciudad = ciudadTexto.empty() ? CuboOLAP::TODOS : cubo.indiceCiudad(ciudadTexto);
+                    if (!ciudadTexto.empty() && ciudad < 0) {
+                        std::cout << "Ciudad no encontrada en el conjunto\n";
+                        break;
+                    }
+                    int calendario = CuboOLAP::TODOS, declarante = CuboOLAP::TODOS, decada = CuboOLAP::TODOS;
+                    bool valida = true;
+                    if (calendarioTexto != "*") {
+                        calendario = CuboOLAP::indiceCalendario(static_cast<char>(std::toupper(calendarioTexto[0])));
+                        valida = valida && calendario >= 0;
+                    }
+                    if (declaranteTexto != "*") {
+                        declarante = declaranteTexto == "s" ? 1 : 0;
+                        valida = valida && (declaranteTexto == "s" || declaranteTexto == "n");
+                    }
+                    if (decadaTexto != "*") {
+                        decada = CuboOLAP::indiceDecada(std::atoi(decadaTexto.c_str()));
+                        valida = valida && decada >= 0;
+                    }
+                    if (!valida) {
+                        std::cout << "Dimensión inválida\n";
+                        break;
+                    }
+
+                    monitor.iniciar_tiempo();
+                    const CeldaCubo& c = cubo.celda(ciudad, calendario, declarante, decada);
+                    double tiempo_cubo = monitor.detener_tiempo();
+
+                    std::cout << "\nPersonas: " << c.conteo << "\n";
+                    const char* nombres[3] = {"Patrimonio", "Ingresos", "Deudas"};
+                    for (int m = 0; m < 3 && c.conteo > 0; ++m) {
+                        CampoFinanciero campo = static_cast<CampoFinanciero>(m);
+                        const MedidaCubo& medida = c.medida(campo);
+                        std::cout << std::fixed << std::setprecision(2) << nombres[m]
+                                  << ": suma " << medida.suma << ", promedio " << c.promedio(campo)
+                                  << ", mín " << medida.minimo << ", máx " << medida.maximo << " (";
+                        std::cout << cubo.maximo(c, campo)->getId() << ")\n";
+                    }
+                    std::cout.unsetf(std::ios::fixed);
+                    std::cout << "Consulta al cubo: " << tiempo_cubo * 1000 << " us\n";
+                    monitor.registrar("Consulta cubo OLAP", tiempo_cubo, 0);
+                } else {
+                    std::cout << "Subopción inválida\n";
+                    break;
+                }
+
+                double tiempo_olap = monitor.detener_tiempo();
+                long memoria_olap = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Cubo OLAP", tiempo_olap, memoria_olap);
+                break;
+            }
+            case 26:
+            {
+                ConfiguracionGenerador config = configuracionGenerador();
+                std::cout << "\nConfiguración actual: " << describirConfiguracion(config) << "\n";
+
+                int ciudades, dinero, edades;
+                std::cout << "Ciudades (1=Uniforme, 2=Zipf): ";
+                std::cin >> ciudades;
+                if (ciudades == 2) {
+                    std::cout << "Exponente s de Zipf (p. ej. 1.0; mayor = más concentrado): ";
+                    std::cin >> config.exponenteZipf;
+                    if (!(config.exponenteZipf > 0)) {
+                        std::cout << "El exponente debe ser positivo\n";
+                        break;
+                    }
+                }
+                std::cout << "Ingresos y patrimonio (1=Uniforme, 2=Log-normal, 3=Pareto): ";
+                std::cin >> dinero;
+                std::cout << "Edades (1=Uniforme 1960-2009, 2=Pirámide 1925-2009): ";
+                std::cin >> edades;
+                if (ciudades < 1 || ciudades > 2 || dinero < 1 || dinero > 3 || edades < 1 || edades > 2) {
+                    std::cout << "Opción inválida!\n";
+                    break;
+                }
+                config.ciudades = static_cast<DistribucionCiudades>(ciudades - 1);
+                config.dinero = static_cast<DistribucionDinero>(dinero - 1);
+                config.edades = static_cast<DistribucionEdades>(edades - 1);
+
+                // El generador no admite cambios mientras un hilo está generando
+                publicador.esperar();
+                configurarGenerador(config);
+                std::cout << "Nueva configuración: " << describirConfiguracion(config)
+                          << "\nSe aplica a las próximas generaciones (opciones 1, 22 y 23).\n";
+                break;
+            }
+
+            case 27:
+            {
+                std::cout << "\n=== MEMORIA COMPARTIDA (" << SEGMENTO_PREDETERMINADO << ") ===";
+                if (imagen.adjunta()) {
+                    std::cout << "\nAdjunto a la generación " << imagen.generacion() << " ("
+                              << imagen.size() << " personas"
+                              << (imagen.vigente() ? ")" : ", ya hay una generación más nueva)");
+                }
+                std::cout << "\n1. Publicar el conjunto actual para otros procesos";
+                std::cout << "\n2. Adjuntarse y consultar sin copiar";
+                std::cout << "\n3. Desadjuntarse y retirar el segmento";
+                std::cout << "\nSeleccione: ";
+                int sub;
+                std::cin >> sub;
+
+                if (sub == 1) {
+                    if (personas.empty()) {
+                        std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                        break;
+                    }
+                    uint64_t generacion = 0;
+                    size_t bytes = 0;
+                    monitor.iniciar_tiempo();
+                    if (!publicarEnMemoriaCompartida(personas.datos(), SEGMENTO_PREDETERMINADO, generacion, bytes)) {
+                        std::cout << "No se pudo publicar el conjunto.\n";
+                        break;
+                    }
+                    double tiempo = monitor.detener_tiempo();
+                    monitor.registrar("Publicar en memoria compartida", tiempo, 0);
+                    monitor.registrar_memoria("Imagen compartida (columnas)", bytes, personas.size());
+                    std::cout << "Generación " << generacion << " publicada: " << personas.size()
+                              << " personas, " << bytes / 1024 << " KB (" << std::fixed
+                              << std::setprecision(1) << static_cast<double>(bytes) / personas.size()
+                              << " bytes por persona) en " << std::setprecision(3) << tiempo << " ms\n";
+                    std::cout << "Otros procesos pueden adjuntarse con la opción 27 -> 2.\n";
+                } else if (sub == 2) {
+                    if (!imagen.adjunta() || !imagen.vigente()) {
+                        long memoriaAntes = monitor.obtener_memoria();
+                        monitor.iniciar_tiempo();
+                        if (!imagen.adjuntar(SEGMENTO_PREDETERMINADO)) {
+                            std::cout << "No hay un conjunto publicado (use la opción 27 -> 1 en algún proceso).\n";
+                            break;
+                        }
+                        double tiempo = monitor.detener_tiempo();
+                        monitor.registrar("Adjuntar memoria compartida", tiempo, monitor.obtener_memoria() - memoriaAntes);
+                        std::cout << "Adjunto a la generación " << imagen.generacion() << ": " << imagen.size()
+                                  << " personas, " << imagen.bytes() / 1024 << " KB mapeados en "
+                                  << std::fixed << std::setprecision(3) << tiempo << " ms (sin copiar)\n";
+                    }
+                    if (imagen.size() == 0) {
+                        std::cout << "El conjunto publicado está vacío.\n";
+                        break;
+                    }
+
+                    // Cada consulta lee solo las columnas que necesita, en su lugar
+                    auto consultar = [&](const std::string& titulo, auto consulta) {
+                        monitor.iniciar_tiempo();
+                        size_t i = consulta();
+                        double tiempo = monitor.detener_tiempo();
+                        monitor.registrar("Compartida: " + titulo, tiempo, 0);
+                        std::cout << "\n--- " << titulo << " (" << std::fixed << std::setprecision(3)
+                                  << tiempo << " ms) ---\n";
+                        if (i < imagen.size()) {
+                            imagen.persona(i).mostrar();
+                        } else {
+                            std::cout << "Sin resultado.\n";
+                        }
+                    };
+                    consultar("Mayor patrimonio", [&]() { return imagen.mayor(CampoFinanciero::Patrimonio); });
+                    consultar("Más deudas", [&]() { return imagen.mayor(CampoFinanciero::Deudas); });
+                    consultar("Más longeva", [&]() { return imagen.masLongeva(); });
+
+                    std::string ciudad(imagen.ciudad(0));
+                    monitor.iniciar_tiempo();
+                    size_t total = imagen.contarCiudad(ciudad);
+                    double tiempo = monitor.detener_tiempo();
+                    monitor.registrar("Compartida: Contar ciudad", tiempo, 0);
+                    std::cout << "\nPersonas nacidas en " << ciudad << ": " << total << " ("
+                              << tiempo << " ms)\n";
+
+                    std::string id;
+                    std::cout << "\nID a buscar en el conjunto compartido (0 para omitir): ";
+                    std::cin >> id;
+                    if (id != "0") {
+                        consultar("Buscar ID " + id, [&]() { return imagen.buscarPorID(id); });
+                    }
+                } else if (sub == 3) {
+                    imagen.desadjuntar();
+                    if (retirarMemoriaCompartida(SEGMENTO_PREDETERMINADO)) {
+                        std::cout << "Segmento retirado; los procesos adjuntos conservan su copia mapeada.\n";
+                    }
+                } else {
+                    std::cout << "Opción inválida!\n";
+                }
+                break;
+            }
+
+            case 28:
+            {
+                if (personas.empty()) {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+                const std::vector<Persona>& datos = personas.datos();
+
+                monitor.iniciar_tiempo();
+                ColeccionComprimida comprimida(datos);
+                double tiempoComprimir = monitor.detener_tiempo();
+                monitor.registrar("Comprimir columnas", tiempoComprimir, 0);
+
+                size_t bytesPersona = personas.bytesTotales();
+                size_t bytesComprimida = comprimida.bytesTotales();
+                monitor.registrar_memoria("ColeccionPersonas (con arena)", bytesPersona, personas.size());
+                monitor.registrar_memoria("ColeccionComprimida", bytesComprimida, comprimida.size());
+
+                std::cout << "\n=== COLUMNAS COMPRIMIDAS ===\n";
+                std::cout << std::fixed << std::setprecision(2);
+                std::cout << std::left << std::setw(20) << "Columna" << std::right << std::setw(12) << "KB"
+                          << std::setw(14) << "Bits/valor\n";
+                for (const auto& [nombre, columna] : comprimida.columnas()) {
+                    std::cout << std::left << std::setw(20) << nombre << std::right << std::setw(12)
+                              << columna->bytes() / 1024 << std::setw(13) << columna->bitsPorValor() << "\n";
+                }
+                std::cout << std::setprecision(1);
+                std::cout << "Persona:     " << bytesPersona / 1024 << " KB ("
+                          << static_cast<double>(bytesPersona) / personas.size() << " bytes/persona)\n";
+                std::cout << "Comprimida:  " << bytesComprimida / 1024 << " KB ("
+                          << static_cast<double>(bytesComprimida) / comprimida.size() << " bytes/persona, "
+                          << static_cast<double>(bytesPersona) / bytesComprimida << "x menos)\n";
+                std::cout << "Compresión: " << std::setprecision(3) << tiempoComprimir << " ms\n";
+
+                // Cada consulta: recorrido de filas vs escaneo de columnas empaquetadas
+                std::cout << "\n" << std::left << std::setw(26) << "Consulta" << std::right
+                          << std::setw(13) << "Filas (ms)" << std::setw(17) << "Comprimida (ms)"
+                          << std::setw(11) << "Acel." << "  Igual\n";
+                auto comparar = [&](const std::string& consulta, auto filas, auto columnas) {
+                    monitor.iniciar_tiempo();
+                    auto esperado = filas();
+                    double tiempoFilas = monitor.detener_tiempo();
+                    monitor.iniciar_tiempo();
+                    auto obtenido = columnas();
+                    double tiempoColumnas = monitor.detener_tiempo();
+                    monitor.registrar_rendimiento("Filas: " + consulta, datos.size(), tiempoFilas);
+                    monitor.registrar_rendimiento("Comprimida: " + consulta, datos.size(), tiempoColumnas);
+                    std::cout << std::left << std::setw(26) << consulta << std::right << std::setprecision(3)
+                              << std::setw(13) << tiempoFilas << std::setw(17) << tiempoColumnas
+                              << std::setprecision(2) << std::setw(10)
+                              << (tiempoColumnas > 0 ? tiempoFilas / tiempoColumnas : 0.0) << "x  "
+                              << (esperado == obtenido ? "sí" : "NO") << "\n";
+                };
+                auto posicion = [&](const Persona* p) { return p ? static_cast<size_t>(p - datos.data()) : datos.size(); };
+
+                comparar("Mayor patrimonio",
+                         [&]() { return posicion(buscarPatrimonio(datos)); },
+                         [&]() { return comprimida.mayor(CampoFinanciero::Patrimonio); });
+                comparar("Más deudas",
+                         [&]() { return posicion(buscarDeudas(datos)); },
+                         [&]() { return comprimida.mayor(CampoFinanciero::Deudas); });
+                comparar("Más longeva",
+                         [&]() { return posicion(buscarLongeva(datos)); },
+                         [&]() { return comprimida.masLongeva(); });
+                std::string ciudad(datos[0].getCiudadNacimiento());
+                comparar("Contar " + ciudad,
+                         [&]() { return static_cast<size_t>(std::count_if(datos.begin(), datos.end(),
+                                     [&](const Persona& p) { return p.getCiudadNacimiento() == ciudad; })); },
+                         [&]() { return comprimida.contarCiudad(ciudad); });
+                comparar("Contar por calendario",
+                         [&]() {
+                             std::array<size_t, 3> conteo{};
+                             for (const Persona& p : datos) {
+                                 ++conteo[p.getCalendarioTributario() - 'A'];
+                             }
+                             return conteo;
+                         },
+                         [&]() { return comprimida.contarPorCalendario(); });
+                std::string id(datos[datos.size() - 1].getId());
+                comparar("Buscar último ID",
+                         [&]() { return posicion(buscarPorID(datos, id)); },
+                         [&]() { return comprimida.buscarPorID(id); });
+
+                size_t mayor = comprimida.mayor(CampoFinanciero::Patrimonio);
+                ArenaCadenas arena;
+                std::cout << "\nMayor patrimonio reconstruido desde las columnas:\n";
+                comprimida.aPersona(mayor, arena).mostrar();
+                std::cout << "(El dinero se guarda en centavos, como en los registros compactos.)\n";
+                break;
+            }
+
+            case 29:
+            {
+                if (personas.empty()) {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+                const std::vector<Persona>& datos = personas.datos();
+
+                std::cout << "\nDimensiones (hasta " << MAXIMO_DIMENSIONES << ", separadas por espacio)\n"
+                          << "Disponibles: " << nombresDimensiones() << "\n> ";
+                std::string linea;
+                std::cin >> std::ws;
+                std::getline(std::cin, linea);
+                std::istringstream entrada(linea);
+                std::vector<DimensionGrupo> dimensiones;
+                std::string nombre;
+                bool validas = true;
+                while (entrada >> nombre) {
+                    DimensionGrupo dimension;
+                    if (!dimensionPorNombre(nombre, dimension)) {
+                        std::cout << "Dimensión desconocida: " << nombre << "\n";
+                        validas = false;
+                        break;
+                    }
+                    dimensiones.push_back(dimension);
+                }
+                if (!validas || dimensiones.empty() || dimensiones.size() > MAXIMO_DIMENSIONES) {
+                    std::cout << "Dimensiones inválidas!\n";
+                    break;
+                }
+
+                int numCampo;
+                std::cout << "Campo (1=Patrimonio, 2=Ingresos anuales, 3=Deudas): ";
+                std::cin >> numCampo;
+                if (numCampo < 1 || numCampo > 3) {
+                    std::cout << "Campo inválido!\n";
+                    break;
+                }
+                CampoFinanciero campo = static_cast<CampoFinanciero>(numCampo - 1);
+
+                // Referencia: un hilo y un std::map con la clave en texto
+                long memoria_ref_inicio = monitor.obtener_memoria();
+                monitor.iniciar_tiempo();
+                std::map<std::string, Agregado> referencia;
+                for (const Persona& p : datos) {
+                    double valor = campo == CampoFinanciero::Ingresos ? p.getIngresosAnuales()
+                                 : campo == CampoFinanciero::Deudas ? p.getDeudas() : p.getPatrimonio();
+                    referencia[textoGrupo(p, dimensiones)].agregar(valor);
+                }
+                double tiempo_ref = monitor.detener_tiempo();
+                long memoria_ref = monitor.obtener_memoria() - memoria_ref_inicio;
+                monitor.registrar("Group-by: std::map secuencial", tiempo_ref, memoria_ref);
+
+                long memoria_hash_inicio = monitor.obtener_memoria();
+                monitor.iniciar_tiempo();
+                ResultadoAgrupamiento resultado = agrupar(datos, dimensiones, campo);
+                double tiempo_hash = monitor.detener_tiempo();
+                long memoria_hash = monitor.obtener_memoria() - memoria_hash_inicio;
+                monitor.registrar("Group-by: agregación local", resultado.tiempoLocal, 0);
+                monitor.registrar("Group-by: partición", resultado.tiempoParticion, 0);
+                monitor.registrar("Group-by: combinación", resultado.tiempoCombinacion, 0);
+                monitor.registrar("Group-by: hash por hilo", tiempo_hash, memoria_hash);
+                monitor.registrar_rendimiento("Group-by: std::map secuencial", datos.size(), tiempo_ref);
+                monitor.registrar_rendimiento("Group-by: hash por hilo", datos.size(), tiempo_hash);
+
+                const size_t maximoFilas = 25;
+                std::cout << "\n=== AGRUPAMIENTO (" << resultado.filas.size() << " grupos) ===\n";
+                std::cout << std::left << std::setw(36) << "Grupo" << std::right << std::setw(10) << "Conteo"
+                          << std::setw(16) << "Suma (M)" << std::setw(14) << "Promedio"
+                          << std::setw(14) << "Mínimo" << std::setw(14) << "Máximo" << "\n";
+                std::cout << std::fixed << std::setprecision(0);
+                for (size_t i = 0; i < resultado.filas.size() && i < maximoFilas; ++i) {
+                    const FilaAgrupada& fila = resultado.filas[i];
+                    std::cout << std::left << std::setw(36) << fila.grupo << std::right
+                              << std::setw(10) << fila.agregado.conteo
+                              << std::setw(16) << fila.agregado.suma / 1e6
+                              << std::setw(14) << fila.agregado.promedio()
+                              << std::setw(14) << fila.agregado.minimo
+                              << std::setw(14) << fila.agregado.maximo << "\n";
+                }
+                if (resultado.filas.size() > maximoFilas) {
+                    std::cout << "... (" << resultado.filas.size() - maximoFilas << " grupos más)\n";
+                }
+
+                // Conteos, mínimos y máximos deben coincidir exactos; las sumas cambian de orden
+                size_t diferencias = resultado.filas.size() != referencia.size() ? 1 : 0;
+                for (const FilaAgrupada& fila : resultado.filas) {
+                    auto it = referencia.find(fila.grupo);
+                    if (it == referencia.end() || it->second.conteo != fila.agregado.conteo ||
+                        it->second.minimo != fila.agregado.minimo || it->second.maximo != fila.agregado.maximo) {
+                        ++diferencias;
+                    }
+                }
+                std::cout << "Verificación contra std::map secuencial: " << (diferencias == 0 ? "OK" : "FALLÓ") << "\n";
+
+                std::cout << std::setprecision(2);
+                std::cout << "\nHilos: " << resultado.hilos << ", particiones: " << resultado.particiones
+                          << ", grupos en tablas locales: " << resultado.gruposLocales << "\n";
+                std::cout << "Agregación local: " << resultado.tiempoLocal << " ms\n";
+                std::cout << "Partición:        " << resultado.tiempoParticion << " ms\n";
+                std::cout << "Combinación:      " << resultado.tiempoCombinacion << " ms\n";
+                mostrarComparacion("Agrupamiento", tiempo_ref, memoria_ref, tiempo_hash, memoria_hash,
+                                   "std::map 1 hilo", "Hash por hilo");
+                break;
+            }
+
+            case 30:
+            {
+                if (personas.empty()) {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+
+                // Las columnas se extraen una vez por versión; cambiar topes solo reevalúa
+                if (!evaluador || versionEvaluador != versionVista) {
+                    monitor.iniciar_tiempo();
+                    evaluador = std::make_unique<EvaluadorTributario>(personas.datos());
+                    double tiempoColumnas = monitor.detener_tiempo();
+                    versionEvaluador = versionVista;
+                    monitor.registrar("Reglas tributarias: extraer columnas", tiempoColumnas, 0);
+                    monitor.registrar_memoria("EvaluadorTributario (columnas)", evaluador->bytes(), evaluador->size());
+                    std::cout << "\nColumnas extraídas en " << std::fixed << std::setprecision(2) << tiempoColumnas
+                              << " ms (" << evaluador->bytes() / 1024 << " KB)\n";
+                }
+
+                std::cout << std::fixed << std::setprecision(0);
+                std::cout << "\n=== REGLAS TRIBUTARIAS (año gravable " << reglas.anioGravable << ") ===\n";
+                std::cout << "Valor UVT: $" << reglas.valorUVT << "\n";
+                std::cout << "Tope patrimonio: " << reglas.topePatrimonioUVT << " UVT ($" << reglas.topePatrimonio() << ")\n";
+                std::cout << "Tope ingresos:   " << reglas.topeIngresosUVT << " UVT ($" << reglas.topeIngresos() << ")\n";
+
+                double valor;
+                std::cout << "\nValor UVT (0 = mantener): ";
+                std::cin >> valor;
+                if (valor > 0) {
+                    reglas.valorUVT = valor;
+                }
+                std::cout << "Tope patrimonio en UVT (0 = mantener): ";
+                std::cin >> valor;
+                if (valor > 0) {
+                    reglas.topePatrimonioUVT = valor;
+                }
+                std::cout << "Tope ingresos en UVT (0 = mantener): ";
+                std::cin >> valor;
+                if (valor > 0) {
+                    reglas.topeIngresosUVT = valor;
+                }
+
+                monitor.iniciar_tiempo();
+                ResumenTributario resumen = evaluador->evaluar(reglas);
+                double tiempoEvaluar = monitor.detener_tiempo();
+                monitor.registrar("Reglas tributarias: evaluar", tiempoEvaluar, 0);
+                monitor.registrar_rendimiento("Reglas tributarias: evaluar", evaluador->size(), tiempoEvaluar);
+
+                auto fecha = [](int clave) { // AAAAMMDD como dd/mm/aaaa
+                    std::ostringstream texto;
+                    texto << std::setfill('0') << std::setw(2) << clave % 100 << "/" << std::setw(2)
+                          << clave / 100 % 100 << "/" << std::setw(4) << clave / 10000;
+                    return texto.str();
+                };
+                std::cout << "\nDeclarantes: " << resumen.declarantes << " de " << evaluador->size()
+                          << " (" << std::setprecision(1) << 100.0 * resumen.declarantes / evaluador->size() << " %)\n";
+                std::cout << "Cambian respecto al conjunto: " << resumen.cambios << "\n";
+                const char calendarios[] = {'A', 'B', 'C'};
+                const int digitosIniciales[] = {0, 40, 80};
+                const int digitosFinales[] = {39, 79, 99};
+                for (int c = 0; c < 3; ++c) {
+                    std::cout << "Calendario " << calendarios[c] << ": " << std::setw(10) << resumen.porCalendario[c]
+                              << " declarantes, vencen del " << fecha(vencimientoPorDigitos(digitosIniciales[c], reglas))
+                              << " al " << fecha(vencimientoPorDigitos(digitosFinales[c], reglas)) << "\n";
+                }
+                std::cout << "Evaluación: " << std::setprecision(3) << tiempoEvaluar << " ms ("
+                          << std::setprecision(1) << (tiempoEvaluar > 0 ? evaluador->size() / tiempoEvaluar / 1000.0 : 0.0)
+                          << " M personas/s)\n";
+
+                // Vencimiento de una persona: el evaluador guarda uno por posición del conjunto
+                std::string cedula;
+                std::cout << "\nCédula para consultar su vencimiento (- para omitir): ";
+                std::cin >> cedula;
+                if (cedula != "-") {
+                    const Persona* persona = buscarPorID(personas.datos(), cedula);
+                    if (!persona) {
+                        std::cout << "No se encontró la cédula " << cedula << "\n";
+                    } else {
+                        int vence = evaluador->vencimientos()[persona - personas.datos().data()];
+                        std::cout << persona->getNombre() << " " << persona->getApellido() << ": "
+                                  << (vence ? "declara, vence el " + fecha(vence) : std::string("no declara"))
+                                  << "\n";
+                    }
+                }
+
+                char aplicar;
+                std::cout << "\n¿Aplicar las marcas al conjunto? (s/n): ";
+                std::cin >> aplicar;
+                if (aplicar != 's' && aplicar != 'S') {
+                    break;
+                }
+                if (publicador.ocupado()) {
+                    std::cout << "Hay una generación en segundo plano en curso; intente de nuevo al terminar.\n";
+                    break;
+                }
+                // Versión nueva: la copia-en-escritura clona el vector (mismo orden) y se publica
+                monitor.iniciar_tiempo();
+                ColeccionPersonas actualizada = personas;
+                evaluador->aplicar(actualizada.modificar());
+                publicador.publicar(std::move(actualizada));
+                tomarInstantanea(publicador, personas, versionVista, indiceFechas, indiceValores, cubo);
+                cache.descartarAnteriores(versionVista);
+                versionEvaluador = versionVista;
+                double tiempoAplicar = monitor.detener_tiempo();
+                monitor.registrar("Reglas tributarias: aplicar", tiempoAplicar, 0);
+                std::cout << "Marcas aplicadas en " << std::setprecision(2) << tiempoAplicar
+                          << " ms (versión " << versionVista << ")\n";
+                break;
+            }
+
+            case 31:
+            {
+                int n;
+                std::cout << "\nIngrese el número de personas a generar: ";
+                std::cin >> n;
+                if (n <= 0) {
+                    std::cout << "Error: Debe generar al menos 1 persona\n";
+                    break;
+                }
+
+                // Mismo n con el generador original y con el generador por lotes
+                long memoria_fila_inicio = monitor.obtener_memoria();
+                monitor.iniciar_tiempo();
+                ColeccionPersonas porFila = generarColeccion(n);
+                double tiempo_fila = monitor.detener_tiempo();
+                long memoria_fila = monitor.obtener_memoria() - memoria_fila_inicio;
+                monitor.registrar("Generar por fila", tiempo_fila, memoria_fila);
+                monitor.registrar_rendimiento("Generar por fila", n, tiempo_fila);
+
+                long memoria_lote_inicio = monitor.obtener_memoria();
+                monitor.iniciar_tiempo();
+                ColeccionPersonas porLotes = generarColeccionPorLotes(n, 1);
+                double tiempo_lote = monitor.detener_tiempo();
+                long memoria_lote = monitor.obtener_memoria() - memoria_lote_inicio;
+                monitor.registrar("Generar por lotes (1 hilo)", tiempo_lote, memoria_lote);
+                monitor.registrar_rendimiento("Generar por lotes (1 hilo)", n, tiempo_lote);
+
+                unsigned hilos = hilosParaTamano(n, numeroHilos());
+                double tiempo_paralelo = tiempo_lote;
+                if (hilos > 1) {
+                    monitor.iniciar_tiempo();
+                    porLotes = generarColeccionPorLotes(n, hilos);
+                    tiempo_paralelo = monitor.detener_tiempo();
+                    monitor.registrar("Generar por lotes (" + std::to_string(hilos) + " hilos)", tiempo_paralelo, 0);
+                    monitor.registrar_rendimiento("Generar por lotes (" + std::to_string(hilos) + " hilos)",
+                                                  n, tiempo_paralelo);
+                }
+
+                // Mismas distribuciones: los promedios y la proporción de declarantes deben parecerse
+                auto resumir = [](const ColeccionPersonas& c, const char* nombre) {
+                    double patrimonio = 0, ingresos = 0;
+                    size_t declarantes = 0;
+                    for (const Persona& p : c) {
+                        patrimonio += p.getPatrimonio();
+                        ingresos += p.getIngresosAnuales();
+                        declarantes += p.getDeclaranteRenta();
+                    }
+                    std::cout << std::left << std::setw(10) << nombre << std::right << std::fixed
+                              << std::setprecision(1) << std::setw(16) << ingresos / c.size() / 1e6 << "M"
+                              << std::setw(16) << patrimonio / c.size() / 1e6 << "M"
+                              << std::setw(13) << 100.0 * declarantes / c.size() << " %\n";
+                };
+                std::cout << "\n=== GENERADOR POR LOTES (" << describirConfiguracion(configuracionGenerador()) << ") ===\n";
+                std::cout << std::left << std::setw(10) << "Generador" << std::right << std::setw(17) << "Ingresos prom."
+                          << std::setw(17) << "Patrim. prom." << std::setw(15) << "Declarantes\n";
+                resumir(porFila, "Por fila");
+                resumir(porLotes, "Por lotes");
+
+                std::cout << std::setprecision(2);
+                std::cout << "\nPor fila:            " << tiempo_fila << " ms\n";
+                std::cout << "Por lotes (1 hilo):  " << tiempo_lote << " ms ("
+                          << (tiempo_lote > 0 ? tiempo_fila / tiempo_lote : 0.0) << "x)\n";
+                if (hilos > 1) {
+                    std::cout << "Por lotes (" << hilos << " hilos): " << tiempo_paralelo << " ms ("
+                              << (tiempo_paralelo > 0 ? tiempo_fila / tiempo_paralelo : 0.0) << "x)\n";
+                }
+                mostrarComparacion("Generar " + std::to_string(n) + " personas", tiempo_fila, memoria_fila,
+                                   tiempo_lote, memoria_lote, "Por fila", "Lotes (1 hilo)");
+
+                char usar;
+                std::cout << "\n¿Usar el conjunto generado por lotes? (s/n): ";
+                std::cin >> usar;
+                if (usar == 's' || usar == 'S') {
+                    publicador.esperar();
+                    publicador.publicar(std::move(porLotes));
+                    tomarInstantanea(publicador, personas, versionVista, indiceFechas, indiceValores, cubo);
+                    cache.descartarAnteriores(versionVista);
+                    std::cout << "Conjunto actual: " << personas.size() << " personas (versión " << versionVista << ")\n";
+                }
+                break;
+            }
+
+            case 32:
+            {
+                if (personas.empty()) {
+                    std::cout << "\nNo hay datos disponibles. Use opción 1 primero.\n";
+                    break;
+                }
+                const std::vector<Persona>& datos = personas.datos();
+
+                double anchoMillones;
+                std::cout << "\nAncho de las cubetas de patrimonio en millones (0 = 100): ";
+                std::cin >> anchoMillones;
+                double anchoPatrimonio = anchoMillones > 0 ? anchoMillones * 1e6 : 1e8;
+
+                long memoria_hist_inicio = monitor.obtener_memoria();
+                monitor.iniciar_tiempo();
+                Histogramas histogramas = construirHistogramas(datos, anchoPatrimonio);
+                double tiempo_hist = monitor.detener_tiempo();
+                long memoria_hist = monitor.obtener_memoria() - memoria_hist_inicio;
+                monitor.registrar("Histogramas por ciudad", tiempo_hist, memoria_hist);
+                monitor.registrar_rendimiento("Histogramas por ciudad", datos.size(), tiempo_hist);
+
+                // Referencia: un recorrido completo por ciudad analizando cada fecha
+                long memoria_rec_inicio = monitor.obtener_memoria();
+                monitor.iniciar_tiempo();
+                const double inversoAncho = 1.0 / histogramas.anchoPatrimonio; // Igual que construirHistogramas
+                size_t diferencias = 0;
+                for (const HistogramaGrupo& grupo : histogramas.ciudades) {
+                    std::array<std::array<uint64_t, CUBETAS_EDAD>, 2> edades{};
+                    std::array<std::array<uint64_t, CUBETAS_PATRIMONIO>, 2> patrimonio{};
+                    for (const Persona& p : datos) {
+                        if (p.getCiudadNacimiento() != grupo.grupo) {
+                            continue;
+                        }
+                        int dia, mes, anio;
+                        p.obtenerFechaNacimiento(dia, mes, anio);
+                        int edad = std::max(0, histogramas.anioReferencia - anio);
+                        size_t sexo = p.getIndiceNombre() >= NOMBRES_FEMENINOS ? 1 : 0;
+                        ++edades[sexo][std::min(static_cast<size_t>(edad / ANCHO_EDAD), CUBETAS_EDAD - 1)];
+
+                        double cubeta = p.getPatrimonio() * inversoAncho;
+                        ++patrimonio[sexo][cubeta <= 0 ? 0
+                            : cubeta >= CUBETAS_PATRIMONIO - 1 ? CUBETAS_PATRIMONIO - 1 : static_cast<size_t>(cubeta)];
+                    }
+                    diferencias += edades != grupo.edades;
+                    diferencias += patrimonio != grupo.patrimonio;
+                }
+                double tiempo_rec = monitor.detener_tiempo();
+                long memoria_rec = monitor.obtener_memoria() - memoria_rec_inicio;
+                monitor.registrar("Histogramas: un recorrido por ciudad", tiempo_rec, memoria_rec);
+
+                mostrarPiramide(histogramas.pais);
+                mostrarHistogramaPatrimonio(histogramas.pais, histogramas.anchoPatrimonio);
+
+                std::string ciudad;
+                std::cout << "\nCiudad para su pirámide (* para omitir): ";
+                std::cin >> std::ws;
+                std::getline(std::cin, ciudad);
+                if (ciudad != "*") {
+                    auto it = std::find_if(histogramas.ciudades.begin(), histogramas.ciudades.end(),
+                                           [&](const HistogramaGrupo& g) { return g.grupo == ciudad; });
+                    if (it == histogramas.ciudades.end()) {
+                        std::cout << "Ciudad no encontrada: " << ciudad << "\n";
+                    } else {
+                        mostrarPiramide(*it);
+                        mostrarHistogramaPatrimonio(*it, histogramas.anchoPatrimonio);
+                    }
+                }
+
+                std::string ruta;
+                std::cout << "\nArchivo CSV (- para omitir): ";
+                std::cin >> ruta;
+                if (ruta != "-" && exportarHistogramasCSV(histogramas, ruta)) {
+                    std::cout << "Histogramas de " << histogramas.ciudades.size() + 1 << " grupos exportados a "
+                              << ruta << "\n";
+                }
+
+                std::cout << std::fixed << std::setprecision(2);
+                std::cout << "\nUna pasada con " << histogramas.hilos << " hilo(s): " << tiempo_hist << " ms ("
+                          << (tiempo_hist > 0 ? datos.size() / tiempo_hist / 1000.0 : 0.0) << " M personas/s)\n";
+                std::cout << "Verificación de edades y patrimonio contra el recorrido por ciudad: "
+                          << (diferencias == 0 ? "OK" : "FALLÓ") << "\n";
+                mostrarComparacion("Histogramas por ciudad", tiempo_rec, memoria_rec, tiempo_hist, memoria_hist,
+                                   "Por ciudad", "Una pasada");
+                break;
+            }
                   
             default:
                 std::cout << "Opción inválida!\n";
         }
+
+        // std::fixed y setprecision persisten en std::cout: se devuelve el formato inicial
+        // para que lo que fije una opción no cambie la salida de las siguientes
+        std::cout.flags(formatoConsola);
+        std::cout.precision(precisionConsola);
         
         // Mostrar estadísticas de la operación (excepto para opciones 0,5,6)
         if (opcion != 0 && opcion != 5 && opcion != 6) {
@@ -0,0 +1,325 @@
+#include "memoria_compartida.h"
+#include "paralelo.h"
+#include <unordered_map>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>   // perror
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const char MAGIA[8] = {'P', 'A', 'R', 'C', '1', 'S', 'H', 'M'};
+    const uint32_t VERSION_FORMATO = 1;
+    const size_t LARGO_FECHA = 10;
+
+    // Reserva `bytes` al final de la imagen respetando la alineación; devuelve el desplazamiento
+    uint64_t reservar(uint64_t& tamano, size_t bytes, size_t alineacion) {
+        tamano = (tamano + alineacion - 1) / alineacion * alineacion;
+        uint64_t desplazamiento = tamano;
+        tamano += bytes;
+        return desplazamiento;
+    }
+
+    // Caracteres que escribirFecha usa para la clave AAAAMMDD
+    size_t largoFecha(uint32_t clave) {
+        unsigned dia = clave % 100, mes = clave / 100 % 100;
+        return (dia >= 10 ? 2 : 1) + 1 + (mes >= 10 ? 2 : 1) + 1 + 4;
+    }
+
+    // Lee la generación de un segmento existente (0 si no hay uno completo)
+    uint64_t generacionExistente(const std::string& nombre) {
+        int fd = shm_open(nombre.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return 0;
+        }
+        uint64_t generacion = 0;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(CabeceraImagen)) {
+            void* mapa = mmap(nullptr, sizeof(CabeceraImagen), PROT_READ, MAP_SHARED, fd, 0);
+            if (mapa != MAP_FAILED) {
+                const CabeceraImagen* cabecera = static_cast<const CabeceraImagen*>(mapa);
+                if (std::memcmp(cabecera->magia, MAGIA, sizeof(MAGIA)) == 0) {
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    generacion = cabecera->generacion;
+                }
+                munmap(mapa, sizeof(CabeceraImagen));
+            }
+        }
+        close(fd);
+        return generacion;
+    }
+}
+
+/**
+ * Implementación de publicarEnMemoriaCompartida.
+ *
+ * POR QUÉ: Ver memoria_compartida.h.
+ * CÓMO: Las columnas van de mayor a menor alineación (double, uint32, uint16, bytes)
+ *       para no desperdiciar relleno. Los inicios de cédulas y el diccionario de
+ *       ciudades se calculan en una pasada secuencial (son sumas prefijas); el resto
+ *       se copia por bloques en paralelo. El segmento se crea con O_EXCL tras quitar el
+ *       nombre anterior, así nunca se escribe sobre páginas que otro proceso está leyendo.
+ * PARA QUÉ: Publicar millones de personas en el tiempo de unas pocas pasadas de memoria.
+ */
+bool publicarEnMemoriaCompartida(const std::vector<Persona>& personas, const std::string& nombre,
+                                 uint64_t& generacion, size_t& bytes) {
+    const size_t n = personas.size();
+
+    // Diccionario de ciudades y largo total de las cédulas
+    std::unordered_map<std::string_view, uint16_t> codigos;
+    std::vector<std::string_view> ciudades;
+    std::vector<uint16_t> codigoDe(n);
+    size_t bytesIds = 0, bytesCiudades = 0;
+    for (size_t i = 0; i < n; ++i) {
+        std::string_view ciudad = personas[i].getCiudadNacimiento();
+        auto [it, nueva] = codigos.emplace(ciudad, static_cast<uint16_t>(ciudades.size()));
+        if (nueva) {
+            ciudades.push_back(ciudad);
+            bytesCiudades += ciudad.size();
+        }
+        codigoDe[i] = it->second;
+        bytesIds += personas[i].getId().size();
+    }
+    if (ciudades.size() > UINT16_MAX || bytesIds > UINT32_MAX) {
+        std::fprintf(stderr, "Error: el conjunto no cabe en el formato de la imagen compartida\n");
+        return false;
+    }
+
+    CabeceraImagen c{};
+    c.versionFormato = VERSION_FORMATO;
+    c.numeroCiudades = static_cast<uint32_t>(ciudades.size());
+    c.generacion = generacionExistente(nombre) + 1;
+    c.personas = n;
+    uint64_t tamano = sizeof(CabeceraImagen);
+    c.patrimonio = reservar(tamano, n * sizeof(double), alignof(double));
+    c.ingresos = reservar(tamano, n * sizeof(double), alignof(double));
+    c.deudas = reservar(tamano, n * sizeof(double), alignof(double));
+    c.claveFecha = reservar(tamano, n * sizeof(uint32_t), alignof(uint32_t));
+    c.inicioId = reservar(tamano, (n + 1) * sizeof(uint32_t), alignof(uint32_t));
+    c.inicioCiudad = reservar(tamano, (ciudades.size() + 1) * sizeof(uint32_t), alignof(uint32_t));
+    c.ciudad = reservar(tamano, n * sizeof(uint16_t), alignof(uint16_t));
+    c.nombres = reservar(tamano, n * 3, 1);
+    c.declarante = reservar(tamano, n, 1);
+    c.textoFecha = reservar(tamano, n * LARGO_FECHA, 1);
+    c.textoIds = reservar(tamano, bytesIds, 1);
+    c.textoCiudades = reservar(tamano, bytesCiudades, 1);
+    c.bytesTotales = tamano;
+
+    // Quien tenga mapeada la versión anterior la conserva; el nombre pasa a la nueva
+    shm_unlink(nombre.c_str());
+    int fd = shm_open(nombre.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        perror("shm_open");
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(tamano)) != 0) {
+        perror("ftruncate");
+        close(fd);
+        shm_unlink(nombre.c_str());
+        return false;
+    }
+    void* mapa = mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        perror("mmap");
+        shm_unlink(nombre.c_str());
+        return false;
+    }
+    char* base = static_cast<char*>(mapa);
+    std::memcpy(base, &c, sizeof(c)); // Aún sin magia: incompleta hasta el final
+
+    // Sumas prefijas: inicio de cada cédula y de cada ciudad
+    uint32_t* inicioId = reinterpret_cast<uint32_t*>(base + c.inicioId);
+    inicioId[0] = 0;
+    for (size_t i = 0; i < n; ++i) {
+        inicioId[i + 1] = inicioId[i] + static_cast<uint32_t>(personas[i].getId().size());
+    }
+    uint32_t* inicioCiudad = reinterpret_cast<uint32_t*>(base + c.inicioCiudad);
+    inicioCiudad[0] = 0;
+    for (size_t k = 0; k < ciudades.size(); ++k) {
+        inicioCiudad[k + 1] = inicioCiudad[k] + static_cast<uint32_t>(ciudades[k].size());
+        std::memcpy(base + c.textoCiudades + inicioCiudad[k], ciudades[k].data(), ciudades[k].size());
+    }
+
+    double* patrimonio = reinterpret_cast<double*>(base + c.patrimonio);
+    double* ingresos = reinterpret_cast<double*>(base + c.ingresos);
+    double* deudas = reinterpret_cast<double*>(base + c.deudas);
+    uint32_t* claveFecha = reinterpret_cast<uint32_t*>(base + c.claveFecha);
+    uint16_t* ciudad = reinterpret_cast<uint16_t*>(base + c.ciudad);
+    uint8_t* nombres = reinterpret_cast<uint8_t*>(base + c.nombres);
+    uint8_t* declarante = reinterpret_cast<uint8_t*>(base + c.declarante);
+    ejecutarPorBloques(n, [&](unsigned, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) {
+            const Persona& p = personas[i];
+            patrimonio[i] = p.getPatrimonio();
+            ingresos[i] = p.getIngresosAnuales();
+            deudas[i] = p.getDeudas();
+            claveFecha[i] = static_cast<uint32_t>(p.claveFechaNacimiento());
+            ciudad[i] = codigoDe[i];
+            nombres[3 * i] = p.getIndiceNombre();
+            nombres[3 * i + 1] = p.getIndicePrimerApellido();
+            nombres[3 * i + 2] = p.getIndiceSegundoApellido();
+            declarante[i] = p.getDeclaranteRenta() ? 1 : 0;
+            std::string_view fecha = p.getFechaNacimiento();
+            std::memcpy(base + c.textoFecha + i * LARGO_FECHA, fecha.data(), std::min(fecha.size(), LARGO_FECHA));
+            std::memcpy(base + c.textoIds + inicioId[i], p.getId().data(), p.getId().size());
+        }
+    });
+
+    // La magia al final: los lectores que la ven encuentran la imagen completa
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(base, MAGIA, sizeof(MAGIA));
+    munmap(mapa, tamano);
+
+    generacion = c.generacion;
+    bytes = tamano;
+    return true;
+}
+
+bool retirarMemoriaCompartida(const std::string& nombre) {
+    if (shm_unlink(nombre.c_str()) != 0) {
+        perror("shm_unlink");
+        return false;
+    }
+    return true;
+}
+
+ImagenCompartida::~ImagenCompartida() {
+    desadjuntar();
+}
+
+/**
+ * Implementación de adjuntar.
+ *
+ * POR QUÉ: Un segmento a medio escribir o de un formato anterior no debe leerse.
+ * CÓMO: Se mapea completo en solo lectura y se valida magia, versión de formato y que
+ *       el tamaño declarado coincida con el del segmento.
+ * PARA QUÉ: Que las consultas puedan confiar en los desplazamientos de la cabecera.
+ */
+bool ImagenCompartida::adjuntar(const std::string& nombre) {
+    desadjuntar();
+    int fd = shm_open(nombre.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        perror("shm_open");
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(CabeceraImagen)) {
+        close(fd);
+        return false;
+    }
+    size_t bytesSegmento = static_cast<size_t>(info.st_size);
+    void* mapa = mmap(nullptr, bytesSegmento, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        perror("mmap");
+        return false;
+    }
+
+    const CabeceraImagen* c = static_cast<const CabeceraImagen*>(mapa);
+    bool valida = std::memcmp(c->magia, MAGIA, sizeof(MAGIA)) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!valida || c->versionFormato != VERSION_FORMATO || c->bytesTotales != bytesSegmento) {
+        munmap(mapa, bytesSegmento);
+        return false;
+    }
+    base = static_cast<const char*>(mapa);
+    cabecera = c;
+    tamano = bytesSegmento;
+    nombreSegmento = nombre;
+    return true;
+}
+
+void ImagenCompartida::desadjuntar() {
+    if (base) {
+        munmap(const_cast<char*>(base), tamano);
+    }
+    base = nullptr;
+    cabecera = nullptr;
+    tamano = 0;
+}
+
+bool ImagenCompartida::vigente() const {
+    return cabecera && generacionExistente(nombreSegmento) == cabecera->generacion;
+}
+
+const double* ImagenCompartida::columnaValor(CampoFinanciero campo) const {
+    switch (campo) {
+        case CampoFinanciero::Ingresos: return columna<double>(cabecera->ingresos);
+        case CampoFinanciero::Deudas: return columna<double>(cabecera->deudas);
+        default: return columna<double>(cabecera->patrimonio);
+    }
+}
+
+std::string_view ImagenCompartida::id(size_t i) const {
+    const uint32_t* inicio = columna<uint32_t>(cabecera->inicioId);
+    return std::string_view(base + cabecera->textoIds + inicio[i], inicio[i + 1] - inicio[i]);
+}
+
+std::string_view ImagenCompartida::nombreCiudad(size_t codigo) const {
+    const uint32_t* inicio = columna<uint32_t>(cabecera->inicioCiudad);
+    return std::string_view(base + cabecera->textoCiudades + inicio[codigo], inicio[codigo + 1] - inicio[codigo]);
+}
+
+Persona ImagenCompartida::persona(size_t i) const {
+    const uint8_t* nombres = columna<uint8_t>(cabecera->nombres) + 3 * i;
+    std::string_view fecha(base + cabecera->textoFecha + i * LARGO_FECHA, largoFecha(claveFecha(i)));
+    return Persona(nombres[0], nombres[1], nombres[2], id(i), ciudad(i), fecha,
+                   valor(i, CampoFinanciero::Ingresos), valor(i, CampoFinanciero::Patrimonio),
+                   valor(i, CampoFinanciero::Deudas), columna<uint8_t>(cabecera->declarante)[i] != 0);
+}
+
+// Recorre solo la columna de inicios y compara el texto cuando el largo coincide
+size_t ImagenCompartida::buscarPorID(std::string_view buscado) const {
+    const uint32_t* inicio = columna<uint32_t>(cabecera->inicioId);
+    const char* texto = base + cabecera->textoIds;
+    for (size_t i = 0; i < size(); ++i) {
+        if (inicio[i + 1] - inicio[i] == buscado.size() &&
+            std::memcmp(texto + inicio[i], buscado.data(), buscado.size()) == 0) {
+            return i;
+        }
+    }
+    return size();
+}
+
+size_t ImagenCompartida::masLongeva() const {
+    const uint32_t* claves = columna<uint32_t>(cabecera->claveFecha);
+    size_t mejor = size();
+    for (size_t i = 0; i < size(); ++i) {
+        if (mejor == size() || claves[i] < claves[mejor]) {
+            mejor = i;
+        }
+    }
+    return mejor;
+}
+
+size_t ImagenCompartida::mayor(CampoFinanciero campo) const {
+    const double* valores = columnaValor(campo);
+    size_t mejor = size();
+    for (size_t i = 0; i < size(); ++i) {
+        if (mejor == size() || valores[i] > valores[mejor]) {
+            mejor = i;
+        }
+    }
+    return mejor;
+}
+
+// Un solo recorrido de la columna de códigos de 16 bits
+size_t ImagenCompartida::contarCiudad(std::string_view nombre) const {
+    size_t codigo = 0;
+    while (codigo < cabecera->numeroCiudades && nombreCiudad(codigo) != nombre) {
+        ++codigo;
+    }
+    if (codigo == cabecera->numeroCiudades) {
+        return 0;
+    }
+    const uint16_t* ciudades = columna<uint16_t>(cabecera->ciudad);
+    size_t total = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        total += ciudades[i] == codigo;
+    }
+    return total;
+}
@@ -0,0 +1,129 @@
+#ifndef MEMORIA_COMPARTIDA_H
+#define MEMORIA_COMPARTIDA_H
+
+#include "persona.h"
+#include "indice_valores.h" // CampoFinanciero
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+// Nombre del segmento POSIX que usan el menú y los demás procesos por defecto
+const char* const SEGMENTO_PREDETERMINADO = "/parcial1_personas";
+
+/**
+ * Cabecera al inicio del segmento compartido.
+ *
+ * Todos los desplazamientos son en bytes desde el inicio del segmento, así la imagen
+ * no contiene apuntadores y sirve en cualquier dirección donde cada proceso la mapee.
+ * `magia` se escribe al final: un lector que la encuentra completa sabe que el resto
+ * de la imagen ya está escrito.
+ */
+struct CabeceraImagen {
+    char magia[8];
+    uint32_t versionFormato;   // Cambia si cambia la distribución de las columnas
+    uint32_t numeroCiudades;
+    uint64_t generacion;       // Aumenta con cada publicación en el mismo nombre
+    uint64_t personas;
+    uint64_t bytesTotales;
+
+    // Columnas (una entrada por persona salvo que se indique otra cosa)
+    uint64_t patrimonio;       // double
+    uint64_t ingresos;         // double
+    uint64_t deudas;           // double
+    uint64_t claveFecha;       // uint32 AAAAMMDD (para comparar sin leer el texto)
+    uint64_t textoFecha;       // char[10] "d/m/aaaa" (escribirFecha); el largo sale de la clave
+    uint64_t ciudad;           // uint16 código en el diccionario de ciudades
+    uint64_t nombres;          // uint8[3]: nombre, primer y segundo apellido (nombres.h)
+    uint64_t declarante;       // uint8
+    uint64_t inicioId;         // uint32, personas + 1 entradas: inicio de cada cédula
+    uint64_t textoIds;         // char: cédulas seguidas
+    uint64_t inicioCiudad;     // uint32, numeroCiudades + 1 entradas
+    uint64_t textoCiudades;    // char: nombres de ciudad seguidos
+};
+
+/**
+ * Publica el conjunto como imagen columnar en un segmento de memoria compartida.
+ *
+ * POR QUÉ: Varios procesos de análisis trabajan sobre la misma población y cada uno
+ *          generaba o cargaba su propia copia.
+ * CÓMO: Se calcula el tamaño de todas las columnas, se crea el segmento con shm_open
+ *       (reemplazando uno anterior del mismo nombre: quien ya lo tenía mapeado conserva
+ *       su versión hasta desadjuntarse), se dimensiona con ftruncate y se llena en
+ *       paralelo a través de mmap. Las ciudades se internan en un diccionario.
+ * PARA QUÉ: Que otras instancias de ./programa se adjunten (ImagenCompartida) y
+ *           consulten sin copiar: N procesos, una sola copia de los datos en memoria.
+ *
+ * @param generacion Recibe la generación publicada (la anterior del mismo nombre + 1).
+ * @param bytes Recibe el tamaño del segmento.
+ * @return false si no se pudo crear o mapear el segmento (el error se informa con perror).
+ */
+bool publicarEnMemoriaCompartida(const std::vector<Persona>& personas, const std::string& nombre,
+                                 uint64_t& generacion, size_t& bytes);
+
+// Elimina el nombre del segmento; los procesos adjuntos conservan su mapeo
+bool retirarMemoriaCompartida(const std::string& nombre);
+
+/**
+ * Vista de solo lectura de una imagen publicada por otro proceso (o por este).
+ *
+ * POR QUÉ: Consultar la población compartida sin traerla a la memoria del proceso.
+ * CÓMO: Mapea el segmento con PROT_READ y valida la cabecera; los accesores leen las
+ *       columnas en su lugar. persona(i) arma una Persona cuyas vistas de texto apuntan
+ *       dentro del segmento, así que solo es válida mientras la imagen siga adjunta.
+ * PARA QUÉ: Las consultas recorren solo las columnas que necesitan y todas las páginas
+ *           son compartidas con los demás procesos.
+ */
+class ImagenCompartida {
+public:
+    ImagenCompartida() = default;
+    ~ImagenCompartida();
+
+    ImagenCompartida(const ImagenCompartida&) = delete;
+    ImagenCompartida& operator=(const ImagenCompartida&) = delete;
+
+    /**
+     * Se adjunta al segmento (soltando el que tuviera antes).
+     *
+     * @return false si el segmento no existe, no está completo o tiene otro formato.
+     */
+    bool adjuntar(const std::string& nombre);
+    void desadjuntar();
+    bool adjunta() const { return cabecera != nullptr; }
+
+    // false si el nombre ya apunta a otra generación (o se retiró)
+    bool vigente() const;
+
+    size_t size() const { return cabecera ? cabecera->personas : 0; }
+    uint64_t generacion() const { return cabecera->generacion; }
+    size_t bytes() const { return tamano; }
+    const std::string& nombre() const { return nombreSegmento; }
+
+    double valor(size_t i, CampoFinanciero campo) const { return columnaValor(campo)[i]; }
+    uint32_t claveFecha(size_t i) const { return columna<uint32_t>(cabecera->claveFecha)[i]; }
+    std::string_view id(size_t i) const;
+    std::string_view ciudad(size_t i) const { return nombreCiudad(columna<uint16_t>(cabecera->ciudad)[i]); }
+    Persona persona(size_t i) const;
+
+    // Consultas sobre las columnas; devuelven la posición o size() si no hay resultado
+    size_t buscarPorID(std::string_view id) const;
+    size_t masLongeva() const;
+    size_t mayor(CampoFinanciero campo) const;
+    size_t contarCiudad(std::string_view ciudad) const;
+
+private:
+    template <typename T>
+    const T* columna(uint64_t desplazamiento) const {
+        return reinterpret_cast<const T*>(base + desplazamiento);
+    }
+    std::string_view nombreCiudad(size_t codigo) const;
+    const double* columnaValor(CampoFinanciero campo) const;
+
+    const char* base = nullptr;
+    const CabeceraImagen* cabecera = nullptr;
+    size_t tamano = 0;
+    std::string nombreSegmento;
+};
+
+#endif // MEMORIA_COMPARTIDA_H
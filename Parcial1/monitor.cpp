@@ -1,6 +1,7 @@
 #include "monitor.h"
 #include <unistd.h> // sysconf
 #include <cstdio>   // FILE, fscanf
+#include <algorithm> // std::max, std::find_if, std::any_of
 
 /**
  * Inicia el cronómetro.
@@ -71,6 +72,85 @@ void Monitor::registrar(const std::string& operacion, double tiempo, long memori
     }
 }
 
+/**
+ * Registra el tamaño de una estructura de datos.
+ * 
+ * POR QUÉ: El RSS medido alrededor de una operación mezcla memoria temporal y
+ *          definitiva; para comparar representaciones interesa su tamaño exacto.
+ * CÓMO: Guardando los bytes calculados por la propia estructura y su número de elementos.
+ * PARA QUÉ: Mostrar bytes por elemento en el resumen y comparar representaciones.
+ */
+void Monitor::registrar_memoria(const std::string& estructura, size_t bytes, size_t elementos) {
+    memorias.push_back({estructura, bytes, elementos});
+}
+
+/**
+ * Registra los tiempos por partición de una operación distribuida entre nodos.
+ * 
+ * POR QUÉ: El tiempo total de una consulta particionada lo marca la partición más
+ *          lenta; un nodo sobrecargado o con memoria remota no se ve en el total.
+ * CÓMO: Guardando el nodo y el tiempo de cada partición en el mismo orden.
+ * PARA QUÉ: Mostrar en el resumen el desglose y el desbalance entre nodos.
+ */
+void Monitor::registrar_particiones(const std::string& operacion, const std::vector<int>& nodos,
+                                    const std::vector<double>& tiempos) {
+    particiones.push_back({operacion, nodos, tiempos});
+}
+
+/**
+ * Registra cuántas filas procesó una operación de volumen y en cuánto tiempo.
+ * 
+ * POR QUÉ: Para ordenar o exportar 10M-100M filas el tiempo total no se compara entre
+ *          tamaños distintos; las filas por segundo sí.
+ * CÓMO: Guardando filas y tiempo; la tasa se calcula al mostrar el resumen.
+ * PARA QUÉ: Ver si el rendimiento se sostiene al crecer el conjunto.
+ */
+void Monitor::registrar_rendimiento(const std::string& operacion, size_t filas, double tiempo) {
+    rendimientos.push_back({operacion, filas, tiempo});
+}
+
+/**
+ * Acumula un acierto o un fallo de la caché de resultados.
+ * 
+ * POR QUÉ: Una caché solo vale la pena si sus aciertos ahorran más de lo que cuesta.
+ * CÓMO: Un registro por consulta con contadores; el ahorro es el costo original de
+ *       cada resultado servido desde la caché.
+ * PARA QUÉ: Mostrar tasa de aciertos y tiempo ahorrado en el resumen.
+ */
+void Monitor::registrar_cache(const std::string& consulta, bool acierto, double tiempo_ahorrado) {
+    auto it = std::find_if(caches.begin(), caches.end(),
+                           [&](const RegistroCache& reg) { return reg.consulta == consulta; });
+    if (it == caches.end()) {
+        caches.push_back({consulta, 0, 0, 0.0});
+        it = caches.end() - 1;
+    }
+    if (acierto) {
+        ++it->aciertos;
+        it->ahorrado += tiempo_ahorrado;
+    } else {
+        ++it->fallos;
+    }
+}
+
+/**
+ * Registra un punto de un barrido de escalado (tamaño × hilos).
+ * 
+ * POR QUÉ: Para planear capacidad hacen falta curvas: cómo cambian tiempo, memoria y
+ *          rendimiento al crecer n y al agregar hilos.
+ * CÓMO: Es un registro normal (cuenta en el total y en la memoria máxima) con columnas
+ *       extra; la eficiencia paralela se deriva al exportar (aceleración / hilos).
+ * PARA QUÉ: Que exportar_csv escriba todo el barrido en un solo archivo.
+ */
+void Monitor::registrar_escalado(const std::string& operacion, size_t n, unsigned hilos, double tiempo,
+                                 long memoria, double rendimiento, double aceleracion) {
+    registrar(operacion, tiempo, memoria);
+    Registro& reg = registros.back();
+    reg.n = n;
+    reg.hilos = hilos;
+    reg.rendimiento = rendimiento;
+    reg.aceleracion = aceleracion;
+}
+
 /**
  * Muestra las estadísticas de una operación.
  * 
@@ -99,6 +179,58 @@ void Monitor::mostrar_resumen() {
     }
     std::cout << "\nTotal tiempo: " << total_tiempo << " ms";
     std::cout << "\nMemoria máxima: " << max_memoria << " KB\n";
+
+    if (!memorias.empty()) {
+        std::cout << "\n=== MEMORIA POR ESTRUCTURA ===";
+        for (const auto& mem : memorias) {
+            std::cout << "\n" << mem.estructura << ": " << mem.bytes / 1024 << " KB";
+            if (mem.elementos > 0) {
+                std::cout << " (" << static_cast<double>(mem.bytes) / mem.elementos
+                          << " bytes/elemento, " << mem.elementos << " elementos)";
+            }
+        }
+        std::cout << "\n";
+    }
+
+    if (!particiones.empty()) {
+        std::cout << "\n=== TIEMPOS POR PARTICIÓN NUMA ===";
+        for (const auto& reg : particiones) {
+            std::cout << "\n" << reg.operacion << ":";
+            double suma = 0, maximo = 0;
+            for (size_t i = 0; i < reg.tiempos.size(); ++i) {
+                std::cout << " nodo " << reg.nodos[i] << " = " << reg.tiempos[i] << " ms;";
+                suma += reg.tiempos[i];
+                maximo = std::max(maximo, reg.tiempos[i]);
+            }
+            if (!reg.tiempos.empty() && suma > 0) {
+                // 1.0 = perfectamente balanceado; 2.0 = la más lenta tarda el doble del promedio
+                std::cout << " desbalance (máx/prom) = " << maximo / (suma / reg.tiempos.size());
+            }
+        }
+        std::cout << "\n";
+    }
+
+    if (!rendimientos.empty()) {
+        std::cout << "\n=== RENDIMIENTO (FILAS/S) ===";
+        for (const auto& reg : rendimientos) {
+            std::cout << "\n" << reg.operacion << ": " << reg.filas << " filas en " << reg.tiempo << " ms";
+            if (reg.tiempo > 0) {
+                std::cout << " (" << static_cast<long>(reg.filas / (reg.tiempo / 1000.0)) << " filas/s)";
+            }
+        }
+        std::cout << "\n";
+    }
+
+    if (!caches.empty()) {
+        std::cout << "\n=== CACHÉ DE RESULTADOS ===";
+        for (const auto& reg : caches) {
+            size_t total = reg.aciertos + reg.fallos;
+            std::cout << "\n" << reg.consulta << ": " << reg.aciertos << " aciertos, " << reg.fallos
+                      << " fallos (" << 100.0 * reg.aciertos / total << " %), tiempo ahorrado "
+                      << reg.ahorrado << " ms";
+        }
+        std::cout << "\n";
+    }
 }
 
 /**
@@ -115,9 +247,21 @@ void Monitor::exportar_csv(const std::string& nombre_archivo) {
         std::cerr << "Error al abrir archivo: " << nombre_archivo << std::endl;
         return;
     }
-    archivo << "Operacion,Tiempo(ms),Memoria(KB)\n";
+    // Las columnas de escalado solo aparecen si hay puntos de un barrido
+    bool escalado = std::any_of(registros.begin(), registros.end(),
+                                [](const Registro& reg) { return reg.n > 0; });
+    archivo << "Operacion,Tiempo(ms),Memoria(KB)";
+    if (escalado) {
+        archivo << ",N,Hilos,Rendimiento(elem/s),Aceleracion,Eficiencia";
+    }
+    archivo << "\n";
     for (const auto& reg : registros) {
-        archivo << reg.operacion << "," << reg.tiempo << "," << reg.memoria << "\n";
+        archivo << reg.operacion << "," << reg.tiempo << "," << reg.memoria;
+        if (escalado) {
+            archivo << "," << reg.n << "," << reg.hilos << "," << reg.rendimiento << ","
+                    << reg.aceleracion << "," << (reg.hilos ? reg.aceleracion / reg.hilos : 0.0);
+        }
+        archivo << "\n";
     }
     archivo.close();
     std::cout << "Estadísticas exportadas a " << nombre_archivo << "\n";
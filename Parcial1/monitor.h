@@ -21,6 +21,13 @@ public:
     long obtener_memoria();
     
     void registrar(const std::string& operacion, double tiempo, long memoria);
+    void registrar_memoria(const std::string& estructura, size_t bytes, size_t elementos);
+    void registrar_particiones(const std::string& operacion, const std::vector<int>& nodos,
+                               const std::vector<double>& tiempos);
+    void registrar_rendimiento(const std::string& operacion, size_t filas, double tiempo);
+    void registrar_cache(const std::string& consulta, bool acierto, double tiempo_ahorrado);
+    void registrar_escalado(const std::string& operacion, size_t n, unsigned hilos, double tiempo,
+                            long memoria, double rendimiento, double aceleracion);
     void mostrar_estadistica(const std::string& operacion, double tiempo, long memoria);
     void mostrar_resumen();
     void exportar_csv(const std::string& nombre_archivo = "estadisticas.csv");
@@ -31,10 +38,48 @@ private:
         std::string operacion; // Nombre de la operación
         double tiempo;         // Tiempo en milisegundos
         long memoria;          // Memoria en KB
+        // Solo para puntos de un barrido de escalado (n == 0 en los demás registros)
+        size_t n = 0;             // Personas del conjunto
+        unsigned hilos = 0;       // Hilos usados
+        double rendimiento = 0;   // Elementos (filas o consultas) por segundo
+        double aceleracion = 0;   // Tiempo con 1 hilo / tiempo con `hilos`
+    };
+    
+    // Memoria ocupada por una estructura de datos (no por una operación)
+    struct RegistroMemoria {
+        std::string estructura; // Nombre de la representación medida
+        size_t bytes;           // Bytes totales ocupados
+        size_t elementos;       // Personas (u otros elementos) que contiene
+    };
+    
+    // Tiempo de cada partición (nodo NUMA) dentro de una misma operación
+    struct RegistroParticiones {
+        std::string operacion;       // Operación medida
+        std::vector<int> nodos;      // Nodo de cada partición
+        std::vector<double> tiempos; // Tiempo en ms de cada partición
+    };
+    
+    // Filas procesadas por una operación de volumen (ordenar, exportar)
+    struct RegistroRendimiento {
+        std::string operacion; // Operación medida
+        size_t filas;          // Filas procesadas
+        double tiempo;         // Tiempo en milisegundos
+    };
+    
+    // Uso de la caché de resultados por consulta
+    struct RegistroCache {
+        std::string consulta;  // Consulta memorizada
+        size_t aciertos;       // Respuestas servidas desde la caché
+        size_t fallos;         // Respuestas que hubo que calcular
+        double ahorrado;       // ms que habrían tomado los aciertos
     };
     
     std::chrono::high_resolution_clock::time_point inicio; // Punto de inicio del cronómetro
     std::vector<Registro> registros; // Historial de registros
+    std::vector<RegistroMemoria> memorias; // Comparaciones de memoria entre estructuras
+    std::vector<RegistroParticiones> particiones; // Desglose por nodo de operaciones particionadas
+    std::vector<RegistroRendimiento> rendimientos; // Filas/s de operaciones de volumen
+    std::vector<RegistroCache> caches; // Aciertos y fallos de la caché por consulta
     double total_tiempo = 0;         // Tiempo total acumulado
     long max_memoria = 0;            // Máximo de memoria utilizado
 };
@@ -0,0 +1,191 @@
+#include "motor_consultas.h"
+#include "generador.h"
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+
+namespace {
+    struct NombreConsulta {
+        const char* nombre;
+        TipoConsulta tipo;
+    };
+
+    const NombreConsulta NOMBRES[] = {
+        {"ping", TipoConsulta::Ping},
+        {"tamano", TipoConsulta::Tamano},
+        {"buscar_id", TipoConsulta::BuscarID},
+        {"percentil", TipoConsulta::PercentilPatrimonio},
+        {"rango", TipoConsulta::RangoPatrimonio},
+        {"contar_ciudad", TipoConsulta::ContarCiudad},
+        {"longeva", TipoConsulta::LongevaPais},
+        {"patrimonio", TipoConsulta::PatrimonioPais},
+        {"deudas", TipoConsulta::DeudasPais},
+        {"nombre_largo", TipoConsulta::NombreMasLargo},
+        {"contar_nacidos", TipoConsulta::ContarNacidos},
+    };
+
+    void describirPersona(std::ostringstream& salida, const Persona& p) {
+        salida << p.getId() << '|' << p.getNombre() << '|' << p.getApellido() << '|'
+               << p.getCiudadNacimiento() << '|' << p.getFechaNacimiento() << '|'
+               << std::fixed << std::setprecision(2) << p.getIngresosAnuales() << '|'
+               << p.getPatrimonio() << '|' << p.getDeudas() << '|'
+               << (p.getDeclaranteRenta() ? 1 : 0) << '|' << p.getCalendarioTributario();
+    }
+}
+
+void MotorConsultas::cargar(ColeccionPersonas nuevas) {
+    personas = std::move(nuevas);
+    valores.construir(personas.datos());
+    fechas.construir(personas.datos());
+    std::lock_guard<std::mutex> candado(candadoCache);
+    cache.descartarAnteriores(++generacion);
+}
+
+/**
+ * Implementación de resolverConsulta.
+ *
+ * POR QUÉ: Cada consulta debe poder resolverse en cualquier hilo.
+ * CÓMO: Despacho por tipo sobre el motor, que no se modifica; las búsquedas por cédula
+ *       y por percentil usan el índice de valores y los conteos el de fechas. Los
+ *       recorridos completos se calculan con el candado de la caché tomado: si varios
+ *       hilos piden el mismo a la vez, solo el primero recorre. Cada acierto o fallo
+ *       se cuenta en usoCache bajo el mismo candado.
+ * PARA QUÉ: Responder igual desde el servidor y desde un script.
+ */
+EstadoRespuesta resolverConsulta(const MotorConsultas& motor, TipoConsulta tipo,
+                                 const std::string& arg, std::string& texto) {
+    std::ostringstream salida;
+    EstadoRespuesta estado = EstadoRespuesta::Ok;
+
+    switch (tipo) {
+        case TipoConsulta::Ping:
+        case TipoConsulta::Apagar:
+            salida << "pong";
+            break;
+        case TipoConsulta::Tamano:
+            salida << motor.personas.size() << ' '
+                   << (motor.personas.empty() ? std::string_view("0") : motor.personas[0].getId());
+            break;
+        case TipoConsulta::BuscarID:
+        case TipoConsulta::RangoPatrimonio: {
+            size_t rango;
+            double percentil;
+            const Persona* persona = nullptr;
+            if (!motor.valores.rangoDeID(CampoFinanciero::Patrimonio, arg, rango, percentil, persona)) {
+                estado = EstadoRespuesta::NoEncontrado;
+            } else if (tipo == TipoConsulta::BuscarID) {
+                describirPersona(salida, *persona);
+            } else {
+                salida << rango << ' ' << std::fixed << std::setprecision(4) << percentil;
+            }
+            break;
+        }
+        case TipoConsulta::PercentilPatrimonio: {
+            char* fin = nullptr;
+            double p = std::strtod(arg.c_str(), &fin);
+            if (arg.empty() || *fin != '\0' || p < 0 || p > 100 || motor.personas.empty()) {
+                estado = EstadoRespuesta::Invalida;
+            } else {
+                salida << std::fixed << std::setprecision(2)
+                       << motor.valores.valorEnPercentil(CampoFinanciero::Patrimonio, p);
+            }
+            break;
+        }
+        case TipoConsulta::ContarCiudad:
+            salida << motor.fechas.contarRango(0, 99999999, arg);
+            break;
+        case TipoConsulta::ContarNacidos: {
+            std::istringstream entrada(arg);
+            int desde, hasta;
+            if (!(entrada >> desde >> hasta) || desde > hasta) {
+                estado = EstadoRespuesta::Invalida;
+            } else {
+                salida << motor.fechas.contarRango(desde, hasta);
+            }
+            break;
+        }
+        case TipoConsulta::LongevaPais:
+        case TipoConsulta::PatrimonioPais:
+        case TipoConsulta::DeudasPais:
+        case TipoConsulta::NombreMasLargo: {
+            auto recorrer = [&]() {
+                const std::vector<Persona>& datos = motor.personas.datos();
+                const Persona* persona = tipo == TipoConsulta::LongevaPais ? buscarLongeva(datos)
+                                       : tipo == TipoConsulta::PatrimonioPais ? buscarPatrimonio(datos)
+                                       : tipo == TipoConsulta::DeudasPais ? buscarDeudas(datos)
+                                       : buscarNombreMasLargo(datos);
+                std::ostringstream descripcion;
+                if (persona) {
+                    describirPersona(descripcion, *persona);
+                }
+                return std::make_pair(persona ? EstadoRespuesta::Ok : EstadoRespuesta::NoEncontrado,
+                                      descripcion.str());
+            };
+            if (!motor.usarCache) {
+                auto respuesta = recorrer();
+                estado = respuesta.first;
+                salida << respuesta.second;
+                break;
+            }
+            std::lock_guard<std::mutex> candado(motor.candadoCache);
+            bool acierto;
+            double ahorro;
+            const auto& respuesta = motor.cache.obtener(std::to_string(static_cast<int>(tipo)), "", motor.generacion,
+                                                        recorrer, acierto, ahorro);
+            UsoCache& uso = motor.usoCache[tipo];
+            if (acierto) {
+                ++uso.aciertos;
+                uso.ahorro += ahorro;
+            } else {
+                ++uso.fallos;
+            }
+            estado = respuesta.first;
+            salida << respuesta.second;
+            break;
+        }
+        default:
+            estado = EstadoRespuesta::Invalida;
+    }
+
+    texto = salida.str();
+    return estado;
+}
+
+bool consultaPorNombre(const std::string& nombre, TipoConsulta& tipo) {
+    for (const auto& n : NOMBRES) {
+        if (nombre == n.nombre) {
+            tipo = n.tipo;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string nombresConsultas() {
+    std::string lista;
+    for (const auto& n : NOMBRES) {
+        lista += lista.empty() ? "" : " ";
+        lista += n.nombre;
+    }
+    return lista;
+}
+
+void mostrarUsoCache(const MotorConsultas& motor) {
+    std::lock_guard<std::mutex> candado(motor.candadoCache);
+    if (motor.usoCache.empty()) {
+        return;
+    }
+    std::cout << "\n=== CACHÉ DEL MOTOR ===";
+    for (const auto& [tipo, uso] : motor.usoCache) {
+        auto it = std::find_if(std::begin(NOMBRES), std::end(NOMBRES),
+                               [tipo = tipo](const NombreConsulta& n) { return n.tipo == tipo; });
+        size_t total = uso.aciertos + uso.fallos;
+        std::cout << "\n" << (it != std::end(NOMBRES) ? it->nombre : "?") << ": " << uso.aciertos << " aciertos, "
+                  << uso.fallos << " fallos (" << 100.0 * uso.aciertos / total << " %), tiempo ahorrado "
+                  << uso.ahorro << " ms";
+    }
+    std::cout << "\n";
+}
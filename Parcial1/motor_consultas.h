@@ -0,0 +1,72 @@
+#ifndef MOTOR_CONSULTAS_H
+#define MOTOR_CONSULTAS_H
+
+#include "coleccion.h"
+#include "indice_fechas.h"
+#include "indice_valores.h"
+#include "protocolo.h"
+#include "cache_consultas.h"
+#include <string>
+#include <mutex>
+#include <map>
+#include <cstdint>
+
+/**
+ * Conjunto residente con sus índices, listo para resolver consultas sueltas.
+ *
+ * POR QUÉ: El servidor de sockets y el modo script resuelven las mismas consultas;
+ *          cada uno con su propio despacho terminaría respondiendo distinto.
+ * CÓMO: cargar() reemplaza el conjunto y reconstruye ambos índices de una vez. Después
+ *       el motor solo se lee, así que varios hilos pueden consultarlo a la vez. Las
+ *       consultas que recorren todo el conjunto (longeva, patrimonio, deudas, nombre
+ *       largo) guardan su respuesta en la caché bajo la generación actual; cargar()
+ *       cambia la generación y descarta lo anterior. Los aciertos, fallos y el tiempo
+ *       ahorrado se cuentan por consulta; con usarCache en false cada recorrido se
+ *       calcula de nuevo (para medir el recorrido y no la caché).
+ * PARA QUÉ: Un único punto de entrada (resolverConsulta) para cualquier frontal, y que
+ *           el servidor y los scripts no repitan recorridos cuyo resultado ya conocen.
+ */
+struct UsoCache {
+    size_t aciertos = 0;
+    size_t fallos = 0;
+    double ahorro = 0;                 // ms que habrían costado los aciertos
+};
+
+struct MotorConsultas {
+    ColeccionPersonas personas;
+    IndiceValores valores;
+    IndiceFechas fechas;
+
+    uint64_t generacion = 0;           // Aumenta con cada cargar()
+    mutable CacheConsultas cache;      // Respuestas de los recorridos completos
+    mutable std::mutex candadoCache;   // La caché se comparte entre los hilos que consultan
+    mutable std::map<TipoConsulta, UsoCache> usoCache; // Por consulta; protegido por candadoCache
+    bool usarCache = true;
+
+    void cargar(ColeccionPersonas nuevas);
+};
+
+/**
+ * Resuelve una consulta y escribe su respuesta en texto.
+ *
+ * @param arg Argumento en texto (cédula, ciudad, percentil...), vacío si no aplica.
+ * @param texto Recibe la respuesta; una persona se escribe como
+ *              "id|nombre|apellido|ciudad|fecha|ingresos|patrimonio|deudas|declarante|calendario".
+ */
+EstadoRespuesta resolverConsulta(const MotorConsultas& motor, TipoConsulta tipo,
+                                 const std::string& arg, std::string& texto);
+
+/**
+ * Traduce el nombre usado en los scripts ("buscar_id", "percentil"...) a su tipo.
+ *
+ * @return false si el nombre no corresponde a ninguna consulta.
+ */
+bool consultaPorNombre(const std::string& nombre, TipoConsulta& tipo);
+
+// Lista de nombres aceptados por consultaPorNombre, separados por espacios
+std::string nombresConsultas();
+
+// Aciertos, fallos y tiempo ahorrado de la caché del motor por consulta (nada si no se usó)
+void mostrarUsoCache(const MotorConsultas& motor);
+
+#endif // MOTOR_CONSULTAS_H
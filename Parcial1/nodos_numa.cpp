@@ -0,0 +1,68 @@
+#include "nodos_numa.h"
+#include "paralelo.h"
+
+#ifdef CON_LIBNUMA
+#include <numa.h>
+#endif
+
+bool numaDisponible() {
+#ifdef CON_LIBNUMA
+    return numa_available() >= 0;
+#else
+    return false;
+#endif
+}
+
+std::vector<int> nodosNUMA() {
+    std::vector<int> nodos;
+#ifdef CON_LIBNUMA
+    if (numaDisponible()) {
+        for (int nodo = 0; nodo <= numa_max_node(); ++nodo) {
+            if (numa_bitmask_isbitset(numa_nodes_ptr, nodo)) {
+                nodos.push_back(nodo);
+            }
+        }
+    }
+#endif
+    if (nodos.empty()) {
+        nodos.push_back(0);
+    }
+    return nodos;
+}
+
+int numeroNodosNUMA() {
+    return static_cast<int>(nodosNUMA().size());
+}
+
+bool fijarHiloEnNodo(int nodo) {
+#ifdef CON_LIBNUMA
+    if (numaDisponible()) {
+        if (numa_run_on_node(nodo) != 0) {
+            return false;
+        }
+        numa_set_preferred(nodo); // Páginas nuevas del hilo, en este nodo si hay espacio
+        return true;
+    }
+#endif
+    (void)nodo;
+    return false;
+}
+
+unsigned hilosPorNodo(int nodo) {
+#ifdef CON_LIBNUMA
+    if (numaDisponible()) {
+        struct bitmask* cpus = numa_allocate_cpumask();
+        unsigned total = 0;
+        if (numa_node_to_cpus(nodo, cpus) == 0) {
+            total = numa_bitmask_weight(cpus);
+        }
+        numa_free_cpumask(cpus);
+        if (total > 0) {
+            return total;
+        }
+    }
+#endif
+    (void)nodo;
+    unsigned nodos = static_cast<unsigned>(numeroNodosNUMA());
+    return std::max(1u, numeroHilos() / nodos);
+}
@@ -0,0 +1,43 @@
+#ifndef NODOS_NUMA_H
+#define NODOS_NUMA_H
+
+#include <vector>
+
+/**
+ * Consulta de la topología NUMA y fijación de hilos a nodos.
+ *
+ * POR QUÉ: En máquinas de varios sockets la memoria queda en el nodo del hilo que la
+ *          toca primero; si un solo hilo genera todo, los recorridos paralelos de los
+ *          demás sockets leen a través de la interconexión.
+ * CÓMO: Con libnuma (compilado con -DCON_LIBNUMA, lo detecta el Makefile) se usan
+ *       numa_run_on_node y numa_set_preferred. Sin libnuma, o si el kernel no tiene
+ *       NUMA, todo se comporta como un único nodo 0 y fijar un hilo no hace nada.
+ * PARA QUÉ: Que cada partición del conjunto se reserve, se llene y se recorra desde
+ *           hilos del mismo nodo.
+ */
+
+// true si libnuma está enlazada y el sistema reporta NUMA
+bool numaDisponible();
+
+/**
+ * Identificadores de los nodos NUMA con memoria ({0} sin libnuma).
+ *
+ * Los identificadores no tienen por qué ser 0..n-1: un nodo sin memoria o fuera de
+ * línea deja un hueco (p. ej. {0, 2}).
+ */
+std::vector<int> nodosNUMA();
+
+// Número de nodos NUMA con memoria (1 sin libnuma)
+int numeroNodosNUMA();
+
+/**
+ * Fija el hilo llamador a las CPU del nodo y prefiere su memoria para nuevas páginas.
+ *
+ * @return true si se pudo fijar; false en el modo sin NUMA (el hilo sigue libre).
+ */
+bool fijarHiloEnNodo(int nodo);
+
+// Hilos a usar por nodo: los núcleos del nodo, o el reparto uniforme de numeroHilos()
+unsigned hilosPorNodo(int nodo);
+
+#endif // NODOS_NUMA_H
@@ -0,0 +1,78 @@
+#include "nombres.h"
+#include <string>
+#include <vector>
+
+namespace {
+    // Nombres comunes en Colombia: primero los femeninos, luego los masculinos
+    const char* const NOMBRES[TOTAL_NOMBRES] = {
+        "María", "Luisa", "Carmen", "Ana", "Sofía", "Isabel", "Laura", "Andrea", "Paula", "Valentina",
+        "Camila", "Daniela", "Carolina", "Fernanda", "Gabriela", "Patricia", "Claudia", "Diana", "Lucía", "Ximena",
+
+        "Juan", "Carlos", "José", "James", "Andrés", "Miguel", "Luis", "Pedro", "Alejandro", "Ricardo",
+        "Felipe", "David", "Jorge", "Santiago", "Daniel", "Fernando", "Diego", "Rafael", "Martín", "Óscar",
+        "Edison", "Nestor", "Gertridis"
+    };
+
+    // Apellidos comunes en Colombia
+    const char* const APELLIDOS[TOTAL_APELLIDOS] = {
+        "Gómez", "Rodríguez", "Martínez", "López", "García", "Pérez", "González", "Sánchez", "Ramírez", "Torres",
+        "Díaz", "Vargas", "Castro", "Ruiz", "Álvarez", "Romero", "Suárez", "Rojas", "Moreno", "Muñoz", "Valencia"
+    };
+
+    struct Tablas {
+        std::string_view nombres[TOTAL_NOMBRES];
+        std::string_view apellidos[TOTAL_APELLIDOS];
+        std::vector<std::string> compuestos; // TOTAL_APELLIDOS x TOTAL_APELLIDOS, por filas
+        uint8_t largoNombre[TOTAL_NOMBRES];
+        uint8_t largoApellido[TOTAL_APELLIDOS];
+
+        Tablas() {
+            for (size_t i = 0; i < TOTAL_NOMBRES; ++i) {
+                nombres[i] = NOMBRES[i];
+                largoNombre[i] = static_cast<uint8_t>(nombres[i].size());
+            }
+            for (size_t i = 0; i < TOTAL_APELLIDOS; ++i) {
+                apellidos[i] = APELLIDOS[i];
+                largoApellido[i] = static_cast<uint8_t>(apellidos[i].size());
+            }
+            compuestos.reserve(TOTAL_APELLIDOS * TOTAL_APELLIDOS);
+            for (size_t a = 0; a < TOTAL_APELLIDOS; ++a) {
+                for (size_t b = 0; b < TOTAL_APELLIDOS; ++b) {
+                    std::string texto(apellidos[a]);
+                    texto += ' ';
+                    texto += apellidos[b];
+                    compuestos.push_back(std::move(texto));
+                }
+            }
+        }
+    };
+
+    // Se construye en el primer uso (inicialización estática local, segura entre hilos)
+    const Tablas& tablas() {
+        static const Tablas instancia;
+        return instancia;
+    }
+}
+
+std::string_view nombrePorIndice(uint8_t indice) {
+    return indice < TOTAL_NOMBRES ? tablas().nombres[indice] : std::string_view();
+}
+
+std::string_view apellidoPorIndice(uint8_t indice) {
+    return indice < TOTAL_APELLIDOS ? tablas().apellidos[indice] : std::string_view();
+}
+
+std::string_view apellidoCompuesto(uint8_t primero, uint8_t segundo) {
+    if (primero >= TOTAL_APELLIDOS || segundo >= TOTAL_APELLIDOS) {
+        return std::string_view();
+    }
+    return tablas().compuestos[primero * TOTAL_APELLIDOS + segundo];
+}
+
+size_t largoNombreCompleto(uint8_t nombre, uint8_t primero, uint8_t segundo) {
+    if (nombre >= TOTAL_NOMBRES || primero >= TOTAL_APELLIDOS || segundo >= TOTAL_APELLIDOS) {
+        return 0;
+    }
+    const Tablas& t = tablas();
+    return t.largoNombre[nombre] + t.largoApellido[primero] + 1 + t.largoApellido[segundo];
+}
@@ -0,0 +1,45 @@
+#ifndef NOMBRES_H
+#define NOMBRES_H
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Tablas fijas de nombres y apellidos con acceso por índice.
+ *
+ * POR QUÉ: Todos los nombres del sistema salen de unas pocas decenas de entradas, pero
+ *          cada Persona guardaba el texto completo (o una vista de 16 bytes por campo).
+ * CÓMO: Cada persona guarda tres índices de un byte (nombre, primer y segundo apellido)
+ *       y el texto se resuelve al mostrarlo consultando estas tablas. Los apellidos
+ *       compuestos "Primero Segundo" se precalculan una sola vez (todas las parejas), de
+ *       modo que resolverlos devuelve una vista sin construir cadenas.
+ * PARA QUÉ: Reducir el costo de los nombres a 3 bytes por persona y responder consultas
+ *           de longitud con tablas de largos precalculados.
+ *
+ * Los índices de nombre [0, NOMBRES_FEMENINOS) son femeninos y los siguientes
+ * NOMBRES_MASCULINOS son masculinos.
+ */
+constexpr size_t NOMBRES_FEMENINOS = 20;
+constexpr size_t NOMBRES_MASCULINOS = 23;
+constexpr size_t TOTAL_NOMBRES = NOMBRES_FEMENINOS + NOMBRES_MASCULINOS;
+constexpr size_t TOTAL_APELLIDOS = 21;
+constexpr uint8_t INDICE_VACIO = 0xFF; // Persona sin nombre (p. ej. resultado no encontrado)
+
+// Textos (UTF-8) por índice; INDICE_VACIO (o cualquier índice fuera de rango) da ""
+std::string_view nombrePorIndice(uint8_t indice);
+std::string_view apellidoPorIndice(uint8_t indice);
+
+// "Primero Segundo" precalculado para cada pareja de apellidos
+std::string_view apellidoCompuesto(uint8_t primero, uint8_t segundo);
+
+/**
+ * Longitud en bytes de "nombre" + "Primero Segundo" sin resolver los textos.
+ *
+ * POR QUÉ: buscarNombreMasLargo solo necesita comparar longitudes.
+ * CÓMO: Suma de tres largos precalculados por índice más el espacio entre apellidos.
+ * PARA QUÉ: Recorrer millones de personas leyendo solo tres bytes de cada una.
+ */
+size_t largoNombreCompleto(uint8_t nombre, uint8_t primero, uint8_t segundo);
+
+#endif // NOMBRES_H
@@ -0,0 +1,117 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+// Utilidades de ejecución paralela con std::thread (solo cabecera, son plantillas)
+
+/**
+ * Número de hilos a usar por defecto.
+ *
+ * POR QUÉ: hardware_concurrency() puede devolver 0 si no se conoce el valor.
+ * CÓMO: Usando 1 como respaldo.
+ * PARA QUÉ: Dimensionar los recorridos paralelos según los núcleos disponibles.
+ */
+inline unsigned numeroHilos() {
+    unsigned hilos = std::thread::hardware_concurrency();
+    return hilos ? hilos : 1;
+}
+
+/**
+ * Cuántos hilos conviene usar para n elementos.
+ *
+ * POR QUÉ: Con pocos elementos, crear hilos cuesta más que el trabajo útil.
+ * CÓMO: Limita los hilos para que cada uno reciba al menos minimoPorHilo elementos.
+ * PARA QUÉ: Que quien necesite dimensionar parciales por hilo conozca el número
+ *           exacto de bloques que usará ejecutarPorBloques.
+ */
+inline unsigned hilosParaTamano(size_t n, unsigned hilos = numeroHilos(), size_t minimoPorHilo = 16384) {
+    size_t maximoUtil = n / minimoPorHilo;
+    if (maximoUtil < hilos) {
+        hilos = static_cast<unsigned>(std::max<size_t>(1, maximoUtil));
+    }
+    return hilos;
+}
+
+/**
+ * Reparte el rango [0, n) en bloques contiguos y ejecuta fn(hilo, inicio, fin) en paralelo.
+ *
+ * POR QUÉ: Casi todos los recorridos sobre la colección se pueden dividir por bloques.
+ * CÓMO: Lanza un std::thread por bloque (el bloque 0 corre en el hilo llamador) y
+ *       espera a todos con join(). El reparto es determinista: para los mismos n,
+ *       hilos y minimoPorHilo, el bloque h siempre cubre el mismo rango.
+ * PARA QUÉ: Que cada módulo acumule resultados parciales por hilo y luego los combine.
+ * @return Número de bloques (hilos) realmente usados, para dimensionar los parciales.
+ */
+template <typename Funcion>
+unsigned ejecutarPorBloques(size_t n, Funcion fn, unsigned hilos = numeroHilos(),
+                            size_t minimoPorHilo = 16384) {
+    hilos = hilosParaTamano(n, hilos, minimoPorHilo);
+
+    size_t tamBloque = (n + hilos - 1) / hilos;
+    std::vector<std::thread> trabajadores;
+    trabajadores.reserve(hilos);
+
+    for (unsigned h = 1; h < hilos; ++h) {
+        size_t inicio = std::min(n, h * tamBloque);
+        size_t fin = std::min(n, inicio + tamBloque);
+        trabajadores.emplace_back(fn, h, inicio, fin);
+    }
+    fn(0u, size_t{0}, std::min(n, tamBloque));
+
+    for (auto& t : trabajadores) {
+        t.join();
+    }
+    return hilos;
+}
+
+/**
+ * Ordena un vector en paralelo: ordena bloques por separado y luego los mezcla.
+ *
+ * POR QUÉ: std::sort es secuencial y C++17 sin TBB no ofrece políticas de ejecución.
+ * CÓMO: Cada hilo ordena su bloque con std::sort; después se mezclan pares de bloques
+ *       vecinos con std::inplace_merge, también en paralelo, hasta quedar uno solo.
+ * PARA QUÉ: Construir índices ordenados sobre millones de elementos.
+ */
+template <typename T, typename Comparador>
+void ordenarParalelo(std::vector<T>& datos, Comparador comp, unsigned hilos = numeroHilos()) {
+    size_t n = datos.size();
+    std::vector<size_t> limites;
+
+    unsigned usados = ejecutarPorBloques(n, [&](unsigned, size_t inicio, size_t fin) {
+        std::sort(datos.begin() + inicio, datos.begin() + fin, comp);
+    }, hilos);
+
+    size_t tamBloque = (n + usados - 1) / std::max(1u, usados);
+    for (unsigned b = 0; b <= usados; ++b) {
+        limites.push_back(std::min(n, b * tamBloque));
+    }
+
+    // Mezclar bloques vecinos por rondas: 1+1, 2+2, 4+4, ...
+    while (limites.size() > 2) {
+        std::vector<size_t> siguientes;
+        std::vector<std::thread> mezcladores;
+        for (size_t i = 0; i + 2 < limites.size(); i += 2) {
+            size_t a = limites[i], m = limites[i + 1], b = limites[i + 2];
+            mezcladores.emplace_back([&datos, a, m, b, comp]() {
+                std::inplace_merge(datos.begin() + a, datos.begin() + m, datos.begin() + b, comp);
+            });
+            siguientes.push_back(a);
+        }
+        if (limites.size() % 2 == 0) {
+            // Número impar de bloques: el último pasa sin mezclar a la siguiente ronda
+            siguientes.push_back(limites[limites.size() - 2]);
+        }
+        siguientes.push_back(limites.back());
+        for (auto& t : mezcladores) {
+            t.join();
+        }
+        limites.swap(siguientes);
+    }
+}
+
+#endif // PARALELO_H
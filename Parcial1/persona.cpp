@@ -1,6 +1,5 @@
 #include "persona.h"
 #include <iomanip> // Para std::setprecision
-#include <sstream>
 
 /**
  * Implementación del constructor por defecto de Persona.
@@ -10,37 +9,40 @@
  * PARA QUÉ: Permitir retorno de objetos vacíos cuando no se encuentran resultados.
  */
 Persona::Persona()
-    : nombre(""), 
-      apellido(""), 
-      id(""), 
-      ciudadNacimiento(""),
-      fechaNacimiento(""), 
+    : id(), 
+      ciudadNacimiento(),
+      fechaNacimiento(), 
       ingresosAnuales(0.0), 
       patrimonio(0.0),
       deudas(0.0), 
       declaranteRenta(false),
-      calendarioTributario('A') {}
+      calendarioTributario('A'),
+      indiceNombre(INDICE_VACIO),
+      indicePrimerApellido(INDICE_VACIO),
+      indiceSegundoApellido(INDICE_VACIO) {}
 
 /**
  * Implementación del constructor de Persona.
  * 
  * POR QUÉ: Inicializar los miembros de la clase.
- * CÓMO: Usando la lista de inicialización y moviendo los strings para evitar copias.
+ * CÓMO: Usando la lista de inicialización; los índices ocupan un byte cada uno y las
+ *       vistas se copian (16 bytes cada una), los caracteres no.
  * PARA QUÉ: Eficiencia y correcta construcción del objeto.
  */
-Persona::Persona(std::string nom, std::string ape, std::string id, 
-                 std::string ciudad, std::string fecha, double ingresos, 
+Persona::Persona(uint8_t nom, uint8_t ape1, uint8_t ape2, std::string_view id, 
+                 std::string_view ciudad, std::string_view fecha, double ingresos, 
                  double patri, double deud, bool declara)
-    : nombre(std::move(nom)), 
-      apellido(std::move(ape)), 
-      id(std::move(id)), 
-      ciudadNacimiento(std::move(ciudad)),
-      fechaNacimiento(std::move(fecha)), 
+    : id(id), 
+      ciudadNacimiento(ciudad),
+      fechaNacimiento(fecha), 
       ingresosAnuales(ingresos), 
       patrimonio(patri),
       deudas(deud), 
       declaranteRenta(declara),
-      calendarioTributario(calcularCalendarioTributario()) {}
+      calendarioTributario(calcularCalendarioTributario()),
+      indiceNombre(nom),
+      indicePrimerApellido(ape1),
+      indiceSegundoApellido(ape2) {}
 
 /**
  * Implementación de mostrar.
@@ -51,7 +53,7 @@ Persona::Persona(std::string nom, std::string ape, std::string id,
  */
 void Persona::mostrar() const {
     std::cout << "-------------------------------------\n";
-    std::cout << "[" << id << "] Nombre: " << nombre << " " << apellido << "\n";
+    std::cout << "[" << id << "] Nombre: " << getNombre() << " " << getApellido() << "\n";
     std::cout << "   - Ciudad de nacimiento: " << ciudadNacimiento << "\n";
     std::cout << "   - Fecha de nacimiento: " << fechaNacimiento << "\n\n";
     std::cout << std::fixed << std::setprecision(2); // Formato de números
@@ -71,7 +73,7 @@ void Persona::mostrar() const {
  * PARA QUÉ: Listados rápidos y eficientes.
  */
 void Persona::mostrarResumen() const {
-    std::cout << "[" << id << "] " << nombre << " " << apellido
+    std::cout << "[" << id << "] " << getNombre() << " " << getApellido()
               << " | " << ciudadNacimiento 
               << " | $" << std::fixed << std::setprecision(2) << ingresosAnuales;
 }
@@ -80,8 +82,8 @@ char Persona::calcularCalendarioTributario() const {
     char calendario = 'A'; 
    
     if (id.length() >= 2) {
-        std::string ultDosDigs = id.substr(id.length() - 2, 2);
-        int numeroCal = std::stoi(ultDosDigs);
+        // Los dos últimos dígitos, sin crear una cadena temporal
+        int numeroCal = (id[id.length() - 2] - '0') * 10 + (id[id.length() - 1] - '0');
         
         if (numeroCal < 40) {
             calendario = 'A';
@@ -102,19 +104,47 @@ char Persona::calcularCalendarioTributario() const {
 
 void Persona::obtenerFechaNacimiento(int& dia, int& mes, int& anio) const
 {
-    // Crear un stringstream con la fecha completa (formato: DD/MM/AAAA)
-    std::stringstream ss(fechaNacimiento);
-    std::string token;
-
-    // Extraer el día (primer token antes del primer '/')
-    std::getline(ss, token, '/');
-    dia = std::stoi(token);
+    // Recorrer la fecha (formato: DD/MM/AAAA) acumulando dígitos; cada '/' cierra
+    // un campo. Sin stringstream ni cadenas temporales.
+    int campos[3] = {0, 0, 0};
+    int actual = 0;
+    for (char c : fechaNacimiento) {
+        if (c == '/') {
+            if (++actual == 3) {
+                break;
+            }
+        } else if (c >= '0' && c <= '9') {
+            campos[actual] = campos[actual] * 10 + (c - '0');
+        }
+    }
+    dia = campos[0];
+    mes = campos[1];
+    anio = campos[2];
+}
 
-    // Extraer el mes (segundo token entre las dos '/')
-    std::getline(ss, token, '/');
-    mes = std::stoi(token);
+int Persona::claveFechaNacimiento() const
+{
+    int dia, mes, anio;
+    obtenerFechaNacimiento(dia, mes, anio);
+    return anio * 10000 + mes * 100 + dia;
+}
 
-    // Extraer el año (tercer token después del segundo '/')
-    std::getline(ss, token, '/');
-    anio = std::stoi(token);
-}
\ No newline at end of file
+size_t escribirFecha(char* destino, int dia, int mes, int anio)
+{
+    size_t n = 0;
+    auto dosDigitos = [&](int valor) {
+        if (valor >= 10) {
+            destino[n++] = static_cast<char>('0' + valor / 10);
+        }
+        destino[n++] = static_cast<char>('0' + valor % 10);
+    };
+    dosDigitos(dia);
+    destino[n++] = '/';
+    dosDigitos(mes);
+    destino[n++] = '/';
+    destino[n++] = static_cast<char>('0' + anio / 1000 % 10);
+    destino[n++] = static_cast<char>('0' + anio / 100 % 10);
+    destino[n++] = static_cast<char>('0' + anio / 10 % 10);
+    destino[n++] = static_cast<char>('0' + anio % 10);
+    return n;
+}
@@ -2,8 +2,11 @@
 #define PERSONA_H
 
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
+#include "nombres.h"
 
 /**
  * Clase que representa una persona con datos personales y financieros.
@@ -11,19 +14,26 @@
  * POR QUÉ: Para modelar una entidad persona con atributos relevantes para el sistema.
  * CÓMO: Mediante una clase con atributos privados y métodos públicos de acceso y visualización.
  * PARA QUÉ: Centralizar y encapsular la información de una persona, garantizando integridad de datos.
+ *
+ * Nombre y apellidos se guardan de forma procedural: tres índices de un byte en las
+ * tablas de nombres.h, resueltos a texto solo cuando se consultan. Los demás textos son
+ * vistas (std::string_view): Persona NO es dueña de ellos; viven en las tablas del
+ * generador o en la ArenaCadenas de la colección, que debe seguir viva mientras se use
+ * la persona (ver ColeccionPersonas).
  */
 class Persona {
 private:
-    std::string nombre;           // Nombre de pila
-    std::string apellido;         // Apellidos
-    std::string id;               // Identificador único (cédula)
-    std::string ciudadNacimiento; // Ciudad de nacimiento
-    std::string fechaNacimiento;  // Fecha de nacimiento en formato DD/MM/AAAA
+    std::string_view id;               // Identificador único (cédula)
+    std::string_view ciudadNacimiento; // Ciudad de nacimiento
+    std::string_view fechaNacimiento;  // Fecha de nacimiento en formato DD/MM/AAAA
     double ingresosAnuales;       // Ingresos anuales en pesos colombianos
     double patrimonio;            // Patrimonio total (activos)
     double deudas;                // Deudas totales (pasivos)
     bool declaranteRenta;         // Si es declarante de renta
     char calendarioTributario;    // Según los 2 últimos digitos de la cédulo: A de 00 a 39; B de 40 a 79; y C de 80 a 99
+    uint8_t indiceNombre;            // Nombre de pila (índice en las tablas de nombres.h)
+    uint8_t indicePrimerApellido;    // Apellidos (índices en la tabla de apellidos)
+    uint8_t indiceSegundoApellido;
 
 public:
     /**
@@ -39,25 +49,37 @@ public:
      * Constructor para inicializar todos los atributos de la persona.
      * 
      * POR QUÉ: Necesidad de crear instancias de Persona con todos sus datos.
-     * CÓMO: Recibe cada atributo por valor y los mueve a los miembros correspondientes.
-     * PARA QUÉ: Construir objetos Persona completos y válidos.
+     * CÓMO: Guarda los índices de nombre/apellidos y las vistas recibidas; no copia
+     *       caracteres.
+     * PARA QUÉ: Construir objetos Persona completos sin asignar memoria.
      */
-    Persona(std::string nom, std::string ape, std::string id, 
-            std::string ciudad, std::string fecha, double ingresos, 
+    Persona(uint8_t nom, uint8_t ape1, uint8_t ape2, std::string_view id, 
+            std::string_view ciudad, std::string_view fecha, double ingresos, 
             double patri, double deud, bool declara);
     
-    // Métodos de acceso (getters) - Implementados inline para eficiencia
-    std::string getNombre() const { return nombre; }
-    std::string getApellido() const { return apellido; }
-    std::string getId() const { return id; }
-    std::string getCiudadNacimiento() const { return ciudadNacimiento; }
-    std::string getFechaNacimiento() const { return fechaNacimiento; }
+    // Métodos de acceso (getters) - Implementados inline; devuelven vistas sin copiar.
+    // Nombre y apellido se resuelven desde las tablas en cada llamada.
+    std::string_view getNombre() const { return nombrePorIndice(indiceNombre); }
+    std::string_view getApellido() const { return apellidoCompuesto(indicePrimerApellido, indiceSegundoApellido); }
+    uint8_t getIndiceNombre() const { return indiceNombre; }
+    uint8_t getIndicePrimerApellido() const { return indicePrimerApellido; }
+    uint8_t getIndiceSegundoApellido() const { return indiceSegundoApellido; }
+    // Bytes de getNombre() + getApellido() calculados con los largos precalculados
+    size_t largoNombreCompleto() const {
+        return ::largoNombreCompleto(indiceNombre, indicePrimerApellido, indiceSegundoApellido);
+    }
+    std::string_view getId() const { return id; }
+    std::string_view getCiudadNacimiento() const { return ciudadNacimiento; }
+    std::string_view getFechaNacimiento() const { return fechaNacimiento; }
     double getIngresosAnuales() const { return ingresosAnuales; }
     double getPatrimonio() const { return patrimonio; }
     double getDeudas() const { return deudas; }
     bool getDeclaranteRenta() const { return declaranteRenta; }
     char getCalendarioTributario() const {return calendarioTributario; }
-    
+
+    // La obligación de declarar depende de topes configurables (ver reglas_tributarias.h)
+    void setDeclaranteRenta(bool declara) { declaranteRenta = declara; }
+
     /**
      * Verifica si la persona está vacía (sin datos).
      * 
@@ -88,6 +110,26 @@ public:
     char calcularCalendarioTributario() const;
 
     void obtenerFechaNacimiento(int& dia, int& mes, int& anio) const;
+
+    /**
+     * Devuelve la fecha de nacimiento como entero AAAAMMDD.
+     * 
+     * POR QUÉ: Comparar fechas en formato DD/MM/AAAA exige separar sus tres partes.
+     * CÓMO: anio * 10000 + mes * 100 + dia (el orden numérico coincide con el cronológico).
+     * PARA QUÉ: Ordenar y buscar por fecha con una sola comparación de enteros.
+     */
+    int claveFechaNacimiento() const;
 };
 
+/**
+ * Escribe una fecha como "d/m/aaaa" (sin ceros a la izquierda) en un buffer.
+ * 
+ * POR QUÉ: El generador y la conversión desde el formato compacto producen fechas en
+ *          la arena y no deben pasar por std::to_string ni por cadenas temporales.
+ * CÓMO: Dígito a dígito; el destino debe tener espacio para al menos 10 caracteres.
+ * PARA QUÉ: Mantener un único formato de fecha que obtenerFechaNacimiento sabe leer.
+ * @return Número de caracteres escritos.
+ */
+size_t escribirFecha(char* destino, int dia, int mes, int anio);
+
 #endif // PERSONA_H
\ No newline at end of file
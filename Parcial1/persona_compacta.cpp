@@ -0,0 +1,157 @@
+#include "persona_compacta.h"
+#include <unordered_map>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace {
+    const uint32_t VALOR_ID_EXCEPCIONAL = std::numeric_limits<uint32_t>::max();
+
+    int64_t aCentavos(double pesos) {
+        return static_cast<int64_t>(std::llround(pesos * 100.0));
+    }
+
+    double aPesos(int64_t centavos) {
+        return static_cast<double>(centavos) / 100.0;
+    }
+
+    // Convierte la cédula en número si es puramente numérica y cabe en 32 bits
+    bool idNumerico(std::string_view id, uint32_t& valor) {
+        if (id.empty() || id.size() > 10 || (id.size() > 1 && id[0] == '0')) {
+            return false;
+        }
+        uint64_t acumulado = 0;
+        for (char c : id) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            acumulado = acumulado * 10 + (c - '0');
+        }
+        if (acumulado >= VALOR_ID_EXCEPCIONAL) {
+            return false;
+        }
+        valor = static_cast<uint32_t>(acumulado);
+        return true;
+    }
+}
+
+/**
+ * Implementación del constructor de ColeccionCompacta.
+ *
+ * POR QUÉ: Empaquetar cada persona en 32 bytes.
+ * CÓMO: Los índices de nombre y apellidos se copian tal cual; las ciudades se internan
+ *       con una tabla hash local (solo existe durante la conversión); la fecha se separa
+ *       una vez con obtenerFechaNacimiento y se guarda en bits.
+ * PARA QUÉ: Construir la representación compacta en una sola pasada.
+ */
+ColeccionCompacta::ColeccionCompacta(const std::vector<Persona>& personas) {
+    std::unordered_map<std::string, uint8_t> codigosCiudad;
+
+    registros.reserve(personas.size());
+    ids.reserve(personas.size());
+
+    for (size_t i = 0; i < personas.size(); ++i) {
+        const Persona& p = personas[i];
+
+        // Ciudad: código de 8 bits en el diccionario de la colección
+        std::string ciudad(p.getCiudadNacimiento());
+        auto itCiudad = codigosCiudad.find(ciudad);
+        if (itCiudad == codigosCiudad.end()) {
+            if (ciudades.size() > 0xFF) {
+                std::cerr << "Error: el formato compacto admite como máximo 256 ciudades\n";
+                registros.clear();
+                ids.clear();
+                return;
+            }
+            itCiudad = codigosCiudad.emplace(ciudad, static_cast<uint8_t>(ciudades.size())).first;
+            ciudades.push_back(ciudad);
+        }
+
+        int dia, mes, anio;
+        p.obtenerFechaNacimiento(dia, mes, anio);
+        uint32_t atributos = static_cast<uint32_t>(dia & 0x1F)
+                           | static_cast<uint32_t>(mes & 0xF) << 5
+                           | static_cast<uint32_t>((anio - 1900) & 0xFF) << 9
+                           | static_cast<uint32_t>(itCiudad->second) << 17
+                           | static_cast<uint32_t>((p.getCalendarioTributario() - 'A') & 0x3) << 25
+                           | static_cast<uint32_t>(p.getDeclaranteRenta() ? 1 : 0) << 27;
+
+        registros.push_back({aCentavos(p.getIngresosAnuales()),
+                             aCentavos(p.getPatrimonio()),
+                             aCentavos(p.getDeudas()),
+                             atributos,
+                             static_cast<uint32_t>(p.getIndiceNombre())
+                               | static_cast<uint32_t>(p.getIndicePrimerApellido()) << 8
+                               | static_cast<uint32_t>(p.getIndiceSegundoApellido()) << 16});
+
+        uint32_t idValor;
+        if (idNumerico(p.getId(), idValor)) {
+            ids.push_back(idValor);
+        } else {
+            ids.push_back(VALOR_ID_EXCEPCIONAL);
+            idsExcepcionales[i] = std::string(p.getId());
+        }
+    }
+
+    registros.shrink_to_fit();
+    ids.shrink_to_fit();
+}
+
+std::string_view ColeccionCompacta::nombre(size_t i) const {
+    return nombrePorIndice(registros[i].indiceNombre());
+}
+
+std::string_view ColeccionCompacta::apellido(size_t i) const {
+    const PersonaCompacta& r = registros[i];
+    return apellidoCompuesto(r.indicePrimerApellido(), r.indiceSegundoApellido());
+}
+
+std::string ColeccionCompacta::id(size_t i) const {
+    if (ids[i] == VALOR_ID_EXCEPCIONAL) {
+        return idsExcepcionales.at(i);
+    }
+    return std::to_string(ids[i]);
+}
+
+/**
+ * Implementación de aPersona.
+ *
+ * POR QUÉ: Las consultas existentes y mostrar() trabajan con Persona.
+ * CÓMO: Desempaqueta los bits; nombre y apellidos pasan como índices y los demás
+ *       textos se copian a la arena recibida (Persona solo guarda vistas, así que
+ *       necesita una memoria que la sobreviva).
+ * PARA QUÉ: Conversión inversa sin pérdida (salvo centavos por debajo de 0.01).
+ */
+Persona ColeccionCompacta::aPersona(size_t i, ArenaCadenas& arena) const {
+    const PersonaCompacta& r = registros[i];
+    char* fecha = arena.reservar(10);
+    size_t largoFecha = escribirFecha(fecha, r.dia(), r.mes(), r.anio());
+
+    return Persona(r.indiceNombre(), r.indicePrimerApellido(), r.indiceSegundoApellido(),
+                   arena.guardar(id(i)), arena.guardar(ciudad(i)),
+                   std::string_view(fecha, largoFecha),
+                   aPesos(r.ingresosCentavos), aPesos(r.patrimonioCentavos),
+                   aPesos(r.deudasCentavos), r.declarante());
+}
+
+ColeccionPersonas ColeccionCompacta::aPersonas() const {
+    auto arena = std::make_shared<ArenaCadenas>();
+    std::vector<Persona> personas;
+    personas.reserve(registros.size());
+    for (size_t i = 0; i < registros.size(); ++i) {
+        personas.push_back(aPersona(i, *arena));
+    }
+    return ColeccionPersonas(std::move(personas), std::move(arena));
+}
+
+size_t ColeccionCompacta::bytesTotales() const {
+    size_t bytes = registros.capacity() * sizeof(PersonaCompacta)
+                 + ids.capacity() * sizeof(uint32_t);
+    for (const auto& [pos, id] : idsExcepcionales) {
+        bytes += sizeof(pos) + sizeof(std::string) + id.size() + 32; // Nodo del map (aprox.)
+    }
+    for (const auto& ciudad : ciudades) {
+        bytes += sizeof(std::string) + ciudad.size();
+    }
+    return bytes;
+}
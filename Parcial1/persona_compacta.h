@@ -0,0 +1,100 @@
+#ifndef PERSONA_COMPACTA_H
+#define PERSONA_COMPACTA_H
+
+#include "persona.h"
+#include "coleccion.h"
+#include "arena.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdint>
+
+/**
+ * Registro compacto de 32 bytes para una persona.
+ *
+ * POR QUÉ: Una Persona ocupa tres std::string_view (16 bytes cada una), tres double y
+ *          varios bytes sueltos, más el ID y la fecha en la arena de la colección.
+ *          Con 100 millones de personas eso no cabe en memoria.
+ * CÓMO: - Dinero en centavos como int64 (punto fijo, sin error de redondeo al sumar).
+ *       - Fecha, ciudad, calendario y declarante empaquetados en 32 bits.
+ *       - Nombre y apellidos como los mismos índices de un byte que usa Persona
+ *         (tablas de nombres.h), empaquetados en 32 bits.
+ * PARA QUÉ: Representar conjuntos muy grandes con poca memoria y recorridos que
+ *           caben mejor en caché (dos registros por línea de 64 bytes).
+ *
+ * Distribución de fechaYAtributos (bit 0 = menos significativo):
+ *   0-4   día (1-31)           5-8   mes (1-12)
+ *   9-16  año - 1900 (0-255)   17-24 código de ciudad (diccionario de la colección)
+ *   25-26 calendario (0=A, 1=B, 2=C)
+ *   27    declarante de renta
+ */
+struct PersonaCompacta {
+    int64_t ingresosCentavos;
+    int64_t patrimonioCentavos;
+    int64_t deudasCentavos;
+    uint32_t fechaYAtributos;
+    uint32_t nombres;           // Bits 0-7 nombre, 8-15 primer apellido, 16-23 segundo
+
+    int dia() const { return fechaYAtributos & 0x1F; }
+    int mes() const { return (fechaYAtributos >> 5) & 0xF; }
+    int anio() const { return 1900 + ((fechaYAtributos >> 9) & 0xFF); }
+    int claveFecha() const { return anio() * 10000 + mes() * 100 + dia(); }
+    uint8_t ciudad() const { return (fechaYAtributos >> 17) & 0xFF; }
+    char calendario() const { return static_cast<char>('A' + ((fechaYAtributos >> 25) & 0x3)); }
+    bool declarante() const { return (fechaYAtributos >> 27) & 0x1; }
+    uint8_t indiceNombre() const { return nombres & 0xFF; }
+    uint8_t indicePrimerApellido() const { return (nombres >> 8) & 0xFF; }
+    uint8_t indiceSegundoApellido() const { return (nombres >> 16) & 0xFF; }
+};
+
+static_assert(sizeof(PersonaCompacta) == 32, "PersonaCompacta debe ocupar exactamente 32 bytes");
+
+/**
+ * Colección de registros compactos con su montón de cadenas y diccionario de ciudades.
+ *
+ * POR QUÉ: Un registro compacto por sí solo no tiene los textos; la colección los guarda.
+ * CÓMO: Además de los registros mantiene la columna de IDs (las cédulas numéricas caben
+ *       en 32 bits) y la lista de ciudades. Los nombres no necesitan almacenamiento
+ *       propio: se resuelven con las tablas de nombres.h.
+ * PARA QUÉ: Convertir desde y hacia Persona y medir la memoria real de la representación.
+ */
+class ColeccionCompacta {
+public:
+    ColeccionCompacta() = default;
+
+    /**
+     * Convierte un vector de Persona al formato compacto.
+     *
+     * POR QUÉ: Los datos se generan como Persona.
+     * CÓMO: Una pasada que interna ciudades y empaqueta el resto.
+     * PARA QUÉ: Obtener la representación de 32 bytes por persona.
+     */
+    explicit ColeccionCompacta(const std::vector<Persona>& personas);
+
+    size_t size() const { return registros.size(); }
+    const PersonaCompacta& operator[](size_t i) const { return registros[i]; }
+    const std::vector<PersonaCompacta>& datos() const { return registros; }
+
+    // Reconstrucción de una persona (sus textos se copian a la arena dada) o de todo
+    // el conjunto, que recibe su propia arena
+    Persona aPersona(size_t i, ArenaCadenas& arena) const;
+    ColeccionPersonas aPersonas() const;
+
+    // Acceso a los textos sin reconstruir la Persona completa
+    std::string_view nombre(size_t i) const;
+    std::string_view apellido(size_t i) const;
+    std::string id(size_t i) const;
+    const std::string& ciudad(size_t i) const { return ciudades[registros[i].ciudad()]; }
+    const std::vector<std::string>& diccionarioCiudades() const { return ciudades; }
+
+    // Bytes ocupados: registros + IDs + diccionario de ciudades
+    size_t bytesTotales() const;
+
+private:
+    std::vector<PersonaCompacta> registros;
+    std::vector<uint32_t> ids;                // Cédula numérica; VALOR_ID_EXCEPCIONAL si no cabe
+    std::map<size_t, std::string> idsExcepcionales; // IDs no numéricos o mayores de 32 bits
+    std::vector<std::string> ciudades;        // Código de ciudad -> nombre
+};
+
+#endif // PERSONA_COMPACTA_H
@@ -0,0 +1,86 @@
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+
+#include <thread>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <algorithm>
+
+/**
+ * Conjunto fijo de hilos trabajadores con una cola de tareas.
+ *
+ * POR QUÉ: ejecutarPorBloques crea y destruye hilos en cada recorrido; para muchas
+ *          tareas pequeñas e independientes (consultas del servidor o de un script)
+ *          ese costo domina.
+ * CÓMO: Los hilos se crean una vez y esperan en una variable de condición; enviar()
+ *       encola la tarea envuelta en un std::packaged_task y devuelve su std::future.
+ * PARA QUÉ: Ejecutar consultas concurrentes sin crear un hilo por consulta.
+ */
+class PoolHilos {
+public:
+    explicit PoolHilos(unsigned hilos) {
+        for (unsigned i = 0; i < std::max(1u, hilos); ++i) {
+            trabajadores.emplace_back([this]() { atender(); });
+        }
+    }
+
+    // Termina las tareas ya encoladas y detiene los hilos
+    ~PoolHilos() {
+        {
+            std::lock_guard<std::mutex> bloqueo(mutex);
+            detenido = true;
+        }
+        hayTrabajo.notify_all();
+        for (auto& t : trabajadores) {
+            t.join();
+        }
+    }
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    template <typename Funcion>
+    auto enviar(Funcion fn) -> std::future<decltype(fn())> {
+        using Resultado = decltype(fn());
+        auto tarea = std::make_shared<std::packaged_task<Resultado()>>(std::move(fn));
+        std::future<Resultado> futuro = tarea->get_future();
+        {
+            std::lock_guard<std::mutex> bloqueo(mutex);
+            tareas.emplace([tarea]() { (*tarea)(); });
+        }
+        hayTrabajo.notify_one();
+        return futuro;
+    }
+
+    size_t size() const { return trabajadores.size(); }
+
+private:
+    void atender() {
+        for (;;) {
+            std::function<void()> tarea;
+            {
+                std::unique_lock<std::mutex> bloqueo(mutex);
+                hayTrabajo.wait(bloqueo, [this]() { return detenido || !tareas.empty(); });
+                if (tareas.empty()) {
+                    return; // detenido y sin pendientes
+                }
+                tarea = std::move(tareas.front());
+                tareas.pop();
+            }
+            tarea();
+        }
+    }
+
+    std::vector<std::thread> trabajadores;
+    std::queue<std::function<void()>> tareas;
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    bool detenido = false;
+};
+
+#endif // POOL_HILOS_H
@@ -0,0 +1,96 @@
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cerrno>
+#include <unistd.h>     // read, write
+#include <sys/socket.h> // send, MSG_NOSIGNAL
+
+/**
+ * Protocolo binario entre el servidor de consultas y sus clientes.
+ *
+ * POR QUÉ: Un protocolo de texto obliga a separar líneas y convertir números en cada
+ *          solicitud; con cabeceras fijas el servidor sabe cuántos bytes leer.
+ * CÓMO: Cada solicitud es una CabeceraSolicitud de 8 bytes seguida de `largo` bytes de
+ *       argumento (un ID, una ciudad, un percentil en texto). Cada respuesta es una
+ *       CabeceraRespuesta de 12 bytes seguida de `largo` bytes de texto. El cliente
+ *       puede enviar varias solicitudes sin esperar (pipelining); el servidor responde
+ *       cada lote leído con un solo write, y el campo id enlaza respuesta y solicitud.
+ *       Los enteros viajan en el orden de bytes de la máquina (socket Unix local).
+ * PARA QUÉ: Manejar el motor de consultas desde otros procesos y medir su capacidad.
+ */
+
+// Ruta por defecto del socket del servidor
+constexpr const char* RUTA_SOCKET_PREDETERMINADA = "/tmp/parcial1.sock";
+
+enum class TipoConsulta : uint16_t {
+    Ping = 1,                // Sin argumento; responde "pong"
+    Tamano = 2,              // Responde "<personas> <primer ID>"
+    BuscarID = 3,            // Argumento: cédula. Responde la persona
+    PercentilPatrimonio = 4, // Argumento: percentil (p. ej. "99.5"). Responde el valor
+    RangoPatrimonio = 5,     // Argumento: cédula. Responde "<rango> <percentil>"
+    ContarCiudad = 6,        // Argumento: ciudad. Responde el número de personas
+    LongevaPais = 7,         // Recorrido completo. Responde la persona
+    PatrimonioPais = 8,      // Recorrido completo. Responde la persona
+    DeudasPais = 9,          // Recorrido completo. Responde la persona
+    NombreMasLargo = 10,     // Recorrido completo. Responde la persona
+    ContarNacidos = 11,      // Argumento: "desde hasta" en AAAAMMDD. Responde el conteo
+    Apagar = 99              // Detiene el servidor tras responder
+};
+
+enum class EstadoRespuesta : uint16_t {
+    Ok = 0,
+    NoEncontrado = 1,
+    Invalida = 2
+};
+
+struct CabeceraSolicitud {
+    uint32_t id;     // Elegido por el cliente; se devuelve en la respuesta
+    uint16_t tipo;   // TipoConsulta
+    uint16_t largo;  // Bytes de argumento que siguen
+};
+
+struct CabeceraRespuesta {
+    uint32_t id;
+    uint16_t estado;    // EstadoRespuesta
+    uint16_t reservado;
+    uint32_t largo;     // Bytes de texto que siguen
+};
+
+static_assert(sizeof(CabeceraSolicitud) == 8, "CabeceraSolicitud debe ocupar 8 bytes");
+static_assert(sizeof(CabeceraRespuesta) == 12, "CabeceraRespuesta debe ocupar 12 bytes");
+
+// Escribe todo el buffer (reintenta escrituras parciales); false si se cerró la conexión
+inline bool escribirTodo(int fd, const char* datos, size_t n) {
+    while (n > 0) {
+        ssize_t escritos = send(fd, datos, n, MSG_NOSIGNAL);
+        if (escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (escritos <= 0) {
+            return false;
+        }
+        datos += escritos;
+        n -= static_cast<size_t>(escritos);
+    }
+    return true;
+}
+
+// Lee exactamente n bytes; false si la conexión se cerró antes
+inline bool leerTodo(int fd, char* datos, size_t n) {
+    while (n > 0) {
+        ssize_t leidos = read(fd, datos, n);
+        if (leidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (leidos <= 0) {
+            return false;
+        }
+        datos += leidos;
+        n -= static_cast<size_t>(leidos);
+    }
+    return true;
+}
+
+#endif // PROTOCOLO_H
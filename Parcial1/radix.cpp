@@ -0,0 +1,87 @@
+#include "radix.h"
+#include <numeric>
+
+namespace {
+    const int BITS_DIGITO = 11;                       // 2048 cubetas: el histograma cabe en L1
+    const size_t CUBETAS = size_t{1} << BITS_DIGITO;
+    const int PASADAS = (64 + BITS_DIGITO - 1) / BITS_DIGITO;
+}
+
+/**
+ * Implementación de ordenarRadixParalelo.
+ *
+ * POR QUÉ: Ver radix.h.
+ * CÓMO: Dos arreglos de claves y dos de posiciones se alternan como origen y
+ *       destino en cada pasada (ping-pong), así no se reserva memoria por pasada.
+ * PARA QUÉ: Ordenamiento estable y lineal de claves de 64 bits.
+ */
+std::vector<uint32_t> ordenarRadixParalelo(const std::vector<uint64_t>& claves,
+                                           std::vector<uint64_t>* clavesOrdenadas,
+                                           unsigned hilos) {
+    size_t n = claves.size();
+    std::vector<uint64_t> origenClaves(claves), destinoClaves(n);
+    std::vector<uint32_t> origenPos(n), destinoPos(n);
+    std::iota(origenPos.begin(), origenPos.end(), 0u);
+
+    hilos = hilosParaTamano(n, hilos);
+    // histogramas[h][d]: cuántas claves del bloque h tienen el dígito d
+    std::vector<std::vector<size_t>> histogramas(hilos, std::vector<size_t>(CUBETAS));
+
+    for (int pasada = 0; pasada < PASADAS; ++pasada) {
+        int desplazamiento = pasada * BITS_DIGITO;
+
+        // FASE 1: histograma por hilo
+        ejecutarPorBloques(n, [&](unsigned h, size_t inicio, size_t fin) {
+            std::vector<size_t>& hist = histogramas[h];
+            std::fill(hist.begin(), hist.end(), 0);
+            for (size_t i = inicio; i < fin; ++i) {
+                ++hist[(origenClaves[i] >> desplazamiento) & (CUBETAS - 1)];
+            }
+        }, hilos);
+
+        // Si un solo dígito concentra todas las claves, la pasada no cambia el orden
+        bool pasadaTrivial = false;
+        for (size_t d = 0; d < CUBETAS && !pasadaTrivial; ++d) {
+            size_t total = 0;
+            for (unsigned h = 0; h < hilos; ++h) {
+                total += histogramas[h][d];
+            }
+            if (total == n) {
+                pasadaTrivial = true;
+            } else if (total > 0) {
+                break;
+            }
+        }
+        if (pasadaTrivial) {
+            continue;
+        }
+
+        // FASE 2: convertir conteos en posiciones de inicio (dígito mayor, hilo después)
+        size_t acumulado = 0;
+        for (size_t d = 0; d < CUBETAS; ++d) {
+            for (unsigned h = 0; h < hilos; ++h) {
+                size_t cantidad = histogramas[h][d];
+                histogramas[h][d] = acumulado;
+                acumulado += cantidad;
+            }
+        }
+
+        // FASE 3: reparto estable de cada bloque a su destino
+        ejecutarPorBloques(n, [&](unsigned h, size_t inicio, size_t fin) {
+            std::vector<size_t>& siguiente = histogramas[h];
+            for (size_t i = inicio; i < fin; ++i) {
+                size_t destino = siguiente[(origenClaves[i] >> desplazamiento) & (CUBETAS - 1)]++;
+                destinoClaves[destino] = origenClaves[i];
+                destinoPos[destino] = origenPos[i];
+            }
+        }, hilos);
+
+        origenClaves.swap(destinoClaves);
+        origenPos.swap(destinoPos);
+    }
+
+    if (clavesOrdenadas) {
+        *clavesOrdenadas = std::move(origenClaves);
+    }
+    return origenPos;
+}
@@ -0,0 +1,43 @@
+#ifndef RADIX_H
+#define RADIX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "paralelo.h"
+
+/**
+ * Convierte un double en un entero sin signo que se ordena igual que el double.
+ *
+ * POR QUÉ: El ordenamiento radix trabaja sobre los bits de claves enteras.
+ * CÓMO: Para positivos se enciende el bit de signo; para negativos se invierten
+ *       todos los bits (así los negativos más grandes en magnitud quedan primero).
+ * PARA QUÉ: Ordenar patrimonio, ingresos o deudas con radix sin comparaciones.
+ */
+inline uint64_t claveOrdenable(double valor) {
+    uint64_t bits;
+    std::memcpy(&bits, &valor, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+/**
+ * Ordenamiento radix LSD paralelo sobre pares (clave, posición).
+ *
+ * POR QUÉ: Ordenar decenas de millones de claves de 64 bits con std::sort es
+ *          O(n log n) en comparaciones; radix es lineal en el número de dígitos.
+ * CÓMO: Procesa dígitos de 11 bits desde el menos significativo. En cada pasada
+ *       cada hilo cuenta los dígitos de su bloque, se calculan los desplazamientos
+ *       globales (dígito mayor, hilo después) y cada hilo reparte su bloque de forma
+ *       estable. Se omiten las pasadas en las que todas las claves tienen el mismo
+ *       dígito (frecuente en los bits altos de rangos acotados).
+ * PARA QUÉ: Obtener la permutación ordenada que usan los índices y la exportación.
+ *
+ * @param claves Claves a ordenar (no se modifican).
+ * @param clavesOrdenadas Si no es nullptr, recibe las claves en orden ascendente.
+ * @return Permutación: posición original de cada elemento en orden ascendente.
+ */
+std::vector<uint32_t> ordenarRadixParalelo(const std::vector<uint64_t>& claves,
+                                           std::vector<uint64_t>* clavesOrdenadas = nullptr,
+                                           unsigned hilos = numeroHilos());
+
+#endif // RADIX_H
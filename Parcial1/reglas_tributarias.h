@@ -0,0 +1,90 @@
+#ifndef REGLAS_TRIBUTARIAS_H
+#define REGLAS_TRIBUTARIAS_H
+
+#include "persona.h"
+#include "paralelo.h"
+#include <vector>
+#include <array>
+#include <cstdint>
+
+/**
+ * Topes de declaración de renta de personas naturales y plazos por calendario.
+ *
+ * POR QUÉ: Los topes se fijan en UVT y el valor de la UVT cambia cada año, así que
+ *          "quién declara" no es un dato de la persona sino una regla configurable.
+ * CÓMO: Obliga a declarar un patrimonio bruto o unos ingresos brutos mayores que su
+ *       tope (UVT × valor de la UVT). Los plazos vencen el año siguiente al gravable:
+ *       cada calendario (A: 00-39, B: 40-79, C: 80-99, según los dos últimos dígitos
+ *       de la cédula) empieza en su fecha y avanza un día cada `digitosPorDia` finales.
+ * PARA QUÉ: Cambiar los topes y volver a evaluar toda la población.
+ */
+struct ReglasTributarias {
+    int anioGravable = 2024;
+    double valorUVT = 47065;          // UVT 2024 en pesos
+    double topePatrimonioUVT = 4500;
+    double topeIngresosUVT = 1400;
+    int mesInicio[3] = {8, 9, 10};    // Primer vencimiento de los calendarios A, B y C
+    int diaInicio[3] = {12, 9, 7};
+    int digitosPorDia = 2;
+
+    double topePatrimonio() const { return topePatrimonioUVT * valorUVT; }
+    double topeIngresos() const { return topeIngresosUVT * valorUVT; }
+};
+
+inline bool debeDeclarar(double ingresos, double patrimonio, const ReglasTributarias& reglas) {
+    return patrimonio > reglas.topePatrimonio() || ingresos > reglas.topeIngresos();
+}
+
+/**
+ * Fecha de vencimiento (AAAAMMDD) para unos dos últimos dígitos de cédula.
+ */
+int vencimientoPorDigitos(int digitos, const ReglasTributarias& reglas);
+
+struct ResumenTributario {
+    size_t declarantes = 0;
+    size_t cambios = 0;                       // Personas cuya marca difiere de la del conjunto
+    std::array<size_t, 3> porCalendario{};    // Declarantes en A, B y C
+};
+
+/**
+ * Evaluación por lotes de la obligación de declarar para toda la población.
+ *
+ * POR QUÉ: Probar topes distintos recorriendo objetos Persona de 80 bytes lee mucho
+ *          más de lo necesario: la regla solo usa patrimonio, ingresos y los dos
+ *          últimos dígitos de la cédula.
+ * CÓMO: El constructor copia esos tres campos a columnas contiguas (una vez por
+ *       versión del conjunto). evaluar() recorre las columnas en paralelo con una
+ *       comparación sin saltos por persona, y el vencimiento sale de una tabla de 100
+ *       fechas calculada antes del recorrido. aplicar() escribe las marcas en las personas.
+ * PARA QUÉ: Reevaluar millones de personas en milisegundos cada vez que cambia un tope.
+ */
+class EvaluadorTributario {
+public:
+    explicit EvaluadorTributario(const std::vector<Persona>& personas, unsigned hilos = numeroHilos());
+
+    ResumenTributario evaluar(const ReglasTributarias& reglas, unsigned hilos = numeroHilos());
+
+    // Resultado de la última evaluación, por posición en el conjunto
+    const std::vector<uint8_t>& declarantes() const { return marcas; }
+    const std::vector<int>& vencimientos() const { return fechas; } // AAAAMMDD; 0 si no declara
+
+    /**
+     * Escribe en las personas la marca de la última evaluación.
+     *
+     * @param personas El mismo conjunto (mismo orden) con que se construyó.
+     */
+    void aplicar(std::vector<Persona>& personas, unsigned hilos = numeroHilos());
+
+    size_t size() const { return patrimonio.size(); }
+    size_t bytes() const;
+
+private:
+    std::vector<double> patrimonio;
+    std::vector<double> ingresos;
+    std::vector<uint8_t> digitos;    // Dos últimos dígitos de la cédula (0 a 99)
+    std::vector<uint8_t> originales; // Marca vigente en el conjunto
+    std::vector<uint8_t> marcas;
+    std::vector<int> fechas;
+};
+
+#endif // REGLAS_TRIBUTARIAS_H
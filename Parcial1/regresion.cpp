@@ -0,0 +1,476 @@
+#include "regresion.h"
+#include "generador.h"
+#include "motor_consultas.h"
+#include "radix.h"
+#include "agregacion.h"
+#include "cubo_olap.h"
+#include "agrupamiento.h"
+#include "histogramas.h"
+#include "reglas_tributarias.h"
+#include "columnas_comprimidas.h"
+#include "paralelo.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    const int FORMATO = 1;                  // Versión del archivo de línea base
+    const unsigned SEMILLA = 20250101;
+    const double MUESTRA_MINIMA_MS = 20.0;  // Las operaciones más cortas se repiten dentro de la muestra
+    const int ITERACIONES_MAXIMAS = 100000;
+    const size_t IDS_POR_LOTE = 1000;
+
+    using Reloj = std::chrono::steady_clock;
+
+    // Destino de los resultados para que el compilador no elimine las operaciones medidas
+    volatile size_t sumidero = 0;
+
+    struct Resumen {
+        std::string nombre;
+        std::vector<double> muestras; // ms por iteración
+        double media = 0;
+        double desviacion = 0;
+        double mediana = 0;
+        double icInferior = 0;        // Intervalo de confianza del 95 % de la media
+        double icSuperior = 0;
+        bool paralela = false;        // Su tiempo depende de la cantidad de hilos
+    };
+
+    struct LineaBase {
+        unsigned semilla = SEMILLA;
+        size_t personas = 0;
+        unsigned hilos = 0;
+        int repeticiones = 0;
+        std::vector<Resumen> operaciones;
+    };
+
+    double milisegundos(Reloj::time_point desde) {
+        return std::chrono::duration<double, std::milli>(Reloj::now() - desde).count();
+    }
+
+    // t de Student de dos colas al 95 %; con grados de libertad fraccionarios redondea
+    // hacia abajo (valor crítico mayor: conservador)
+    double tCritico(double gradosLibertad) {
+        static const double tabla[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                       2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                       2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+        int g = static_cast<int>(gradosLibertad);
+        if (g < 1) {
+            return tabla[0];
+        }
+        return g <= 30 ? tabla[g - 1] : 1.96;
+    }
+
+    // Media y desviación estándar muestral (n - 1)
+    void mediaYDesviacion(const std::vector<double>& valores, double& media, double& desviacion) {
+        size_t n = valores.size();
+        media = desviacion = 0;
+        if (n == 0) {
+            return;
+        }
+        for (double v : valores) {
+            media += v;
+        }
+        media /= n;
+        double cuadrados = 0;
+        for (double v : valores) {
+            cuadrados += (v - media) * (v - media);
+        }
+        desviacion = n > 1 ? std::sqrt(cuadrados / (n - 1)) : 0.0;
+    }
+
+    void resumir(Resumen& r) {
+        size_t n = r.muestras.size();
+        if (n == 0) {
+            return;
+        }
+        mediaYDesviacion(r.muestras, r.media, r.desviacion);
+
+        std::vector<double> ordenadas = r.muestras;
+        std::sort(ordenadas.begin(), ordenadas.end());
+        r.mediana = n % 2 ? ordenadas[n / 2] : (ordenadas[n / 2 - 1] + ordenadas[n / 2]) / 2;
+
+        double margen = n > 1 ? tCritico(n - 1.0) * r.desviacion / std::sqrt(static_cast<double>(n)) : 0.0;
+        r.icInferior = r.media - margen;
+        r.icSuperior = r.media + margen;
+    }
+
+    struct Operacion {
+        std::string nombre;
+        std::function<void()> ejecutar;
+        int iteraciones = 1; // Por muestra
+        bool paralela = false;
+    };
+
+    // Calienta la operación y calcula cuántas iteraciones suman MUESTRA_MINIMA_MS
+    int calibrar(const std::function<void()>& operacion) {
+        auto inicio = Reloj::now();
+        operacion();
+        double calentamiento = milisegundos(inicio);
+        if (calentamiento >= MUESTRA_MINIMA_MS) {
+            return 1;
+        }
+        return static_cast<int>(std::min<double>(ITERACIONES_MAXIMAS,
+                                                 std::ceil(MUESTRA_MINIMA_MS / std::max(calentamiento, 1e-4))));
+    }
+
+    /**
+     * Toma las repeticiones por rondas: en cada ronda una muestra de cada operación.
+     *
+     * POR QUÉ: Con todas las muestras de una operación seguidas, un intervalo lento de la
+     *          máquina (otro proceso, cambio de frecuencia) cae entero sobre una sola
+     *          operación y la prueba t lo toma como una regresión real.
+     * CÓMO: Intercalando, ese intervalo se reparte entre todas las operaciones y aparece
+     *       como varianza de sus muestras, que es lo que la prueba descuenta.
+     */
+    std::vector<Resumen> medir(std::vector<Operacion>& operaciones, int repeticiones) {
+        std::vector<Resumen> resultados(operaciones.size());
+        for (int rep = 0; rep < repeticiones; ++rep) {
+            for (size_t o = 0; o < operaciones.size(); ++o) {
+                auto inicio = Reloj::now();
+                for (int it = 0; it < operaciones[o].iteraciones; ++it) {
+                    operaciones[o].ejecutar();
+                }
+                resultados[o].muestras.push_back(milisegundos(inicio) / operaciones[o].iteraciones);
+            }
+        }
+
+        std::cout << std::left << std::setw(20) << "Operación" << std::right << std::setw(14) << "Media (ms)"
+                  << std::setw(14) << "Mediana" << std::setw(24) << "IC 95 %" << std::setw(8) << "Iter." << "\n";
+        for (size_t o = 0; o < operaciones.size(); ++o) {
+            Resumen& r = resultados[o];
+            r.nombre = operaciones[o].nombre;
+            r.paralela = operaciones[o].paralela;
+            resumir(r);
+            std::ostringstream intervalo;
+            intervalo << std::fixed << std::setprecision(4) << "[" << r.icInferior << ", " << r.icSuperior << "]";
+            std::cout << std::left << std::setw(20) << r.nombre << std::right << std::fixed << std::setprecision(4)
+                      << std::setw(14) << r.media << std::setw(14) << r.mediana << std::setw(24) << intervalo.str()
+                      << std::setw(8) << operaciones[o].iteraciones << "\n";
+        }
+        return resultados;
+    }
+
+    /**
+     * Carga fija: el mismo conjunto sembrado y las mismas operaciones en cada corrida.
+     */
+    std::vector<Resumen> correrCarga(unsigned semilla, size_t n, int repeticiones) {
+        configurarGenerador(ConfiguracionGenerador());
+        std::vector<Operacion> operaciones;
+        auto agregar = [&](const std::string& nombre, std::function<void()> operacion, bool paralela = false) {
+            int iteraciones = calibrar(operacion);
+            operaciones.push_back({nombre, std::move(operacion), iteraciones, paralela});
+        };
+        const int tamano = static_cast<int>(n);
+
+        agregar("generar", [&]() {
+            sembrarGenerador(semilla);
+            sumidero = generarColeccion(tamano).size();
+        });
+        agregar("generar_lotes", [&]() {
+            sembrarGenerador(semilla);
+            sumidero = generarColeccionPorLotes(tamano, 1).size();
+        });
+
+        sembrarGenerador(semilla);
+        MotorConsultas motor;
+        motor.cargar(generarColeccionPorLotes(tamano, 1));
+        const std::vector<Persona>& datos = motor.personas.datos();
+
+        // Los recorridos se llaman directamente: a través del motor, desde la segunda vez
+        // se responderían desde su caché
+        agregar("longeva", [&]() { sumidero = buscarLongeva(datos) != nullptr; });
+        agregar("patrimonio", [&]() { sumidero = buscarPatrimonio(datos) != nullptr; });
+        agregar("deudas", [&]() { sumidero = buscarDeudas(datos) != nullptr; });
+        agregar("nombre_largo", [&]() { sumidero = buscarNombreMasLargo(datos) != nullptr; });
+        const std::string ciudad(datos[0].getCiudadNacimiento());
+        agregar("contar_ciudad", [&]() {
+            std::string texto;
+            resolverConsulta(motor, TipoConsulta::ContarCiudad, ciudad, texto);
+            sumidero = texto.size();
+        });
+
+        std::vector<std::string> ids;
+        for (size_t i = 0; i < std::min(n, IDS_POR_LOTE); ++i) {
+            ids.emplace_back(datos[i * (n / std::min(n, IDS_POR_LOTE))].getId());
+        }
+        agregar("buscar_id", [&]() {
+            std::string texto;
+            for (const std::string& id : ids) {
+                resolverConsulta(motor, TipoConsulta::BuscarID, id, texto);
+            }
+            sumidero = texto.size();
+        });
+
+        std::vector<uint64_t> claves(n);
+        for (size_t i = 0; i < n; ++i) {
+            claves[i] = claveOrdenable(datos[i].getPatrimonio());
+        }
+        // Desde aquí, salvo las columnas comprimidas, las operaciones reparten el trabajo entre hilos
+        agregar("radix", [&]() { sumidero = ordenarRadixParalelo(claves, nullptr).size(); }, true);
+        agregar("por_ciudad", [&]() {
+            sumidero = agregacion::mejorPorGrupo<agregacion::PorCiudad, agregacion::Patrimonio, std::greater<>>(
+                datos, numeroHilos()).size();
+        }, true);
+        agregar("cubo_olap", [&]() {
+            CuboOLAP cubo;
+            cubo.construir(datos);
+            sumidero = cubo.numeroCeldas();
+        }, true);
+        agregar("agrupar", [&]() {
+            sumidero = agrupar(datos, {DimensionGrupo::PrimerApellido, DimensionGrupo::Ciudad},
+                               CampoFinanciero::Patrimonio).filas.size();
+        }, true);
+        // Casi un grupo por persona: tablas grandes en la fase de combinación
+        agregar("agrupar_muchos", [&]() {
+            sumidero = agrupar(datos, {DimensionGrupo::AnioNacimiento, DimensionGrupo::Nombre,
+                                       DimensionGrupo::PrimerApellido, DimensionGrupo::SegundoApellido},
+                               CampoFinanciero::Patrimonio).filas.size();
+        }, true);
+        agregar("histogramas", [&]() { sumidero = construirHistogramas(datos).ciudades.size(); }, true);
+
+        EvaluadorTributario evaluador(datos);
+        const ReglasTributarias reglas;
+        agregar("reglas_evaluar", [&]() { sumidero = evaluador.evaluar(reglas).declarantes; }, true);
+
+        agregar("comprimir", [&]() { sumidero = ColeccionComprimida(datos).bytesTotales(); });
+        ColeccionComprimida comprimida(datos);
+        agregar("escaneo_comprimido", [&]() { sumidero = comprimida.mayor(CampoFinanciero::Patrimonio); });
+        return medir(operaciones, repeticiones);
+    }
+
+    bool guardarLineaBase(const LineaBase& base, const std::string& ruta) {
+        std::ofstream archivo(ruta);
+        if (!archivo) {
+            std::cerr << "Error al abrir archivo: " << ruta << std::endl;
+            return false;
+        }
+        archivo << std::setprecision(9);
+        archivo << "{\n  \"formato\": " << FORMATO << ",\n  \"semilla\": " << base.semilla
+                << ",\n  \"personas\": " << base.personas << ",\n  \"hilos\": " << base.hilos
+                << ",\n  \"repeticiones\": " << base.repeticiones << ",\n  \"operaciones\": [\n";
+        for (size_t i = 0; i < base.operaciones.size(); ++i) {
+            const Resumen& r = base.operaciones[i];
+            archivo << "    {\"nombre\": \"" << r.nombre << "\", \"media_ms\": " << r.media
+                    << ", \"mediana_ms\": " << r.mediana << ", \"desviacion_ms\": " << r.desviacion
+                    << ", \"ic95_ms\": [" << r.icInferior << ", " << r.icSuperior << "], \"muestras_ms\": [";
+            for (size_t m = 0; m < r.muestras.size(); ++m) {
+                archivo << (m ? ", " : "") << r.muestras[m];
+            }
+            archivo << "]}" << (i + 1 < base.operaciones.size() ? "," : "") << "\n";
+        }
+        archivo << "  ]\n}\n";
+        return static_cast<bool>(archivo);
+    }
+
+    // Valor numérico de "clave": en el texto (el primero que aparezca)
+    bool leerNumero(const std::string& texto, const std::string& clave, double& valor) {
+        size_t p = texto.find("\"" + clave + "\"");
+        if (p == std::string::npos || (p = texto.find(':', p)) == std::string::npos) {
+            return false;
+        }
+        valor = std::strtod(texto.c_str() + p + 1, nullptr);
+        return true;
+    }
+
+    // Números del arreglo "clave": [a, b, ...] dentro de un objeto
+    std::vector<double> leerArreglo(const std::string& objeto, const std::string& clave) {
+        std::vector<double> valores;
+        size_t p = objeto.find("\"" + clave + "\"");
+        if (p == std::string::npos || (p = objeto.find('[', p)) == std::string::npos) {
+            return valores;
+        }
+        const char* c = objeto.c_str() + p + 1;
+        while (*c && *c != ']') {
+            char* siguiente;
+            double valor = std::strtod(c, &siguiente);
+            if (siguiente == c) {
+                ++c; // Coma o espacio
+                continue;
+            }
+            valores.push_back(valor);
+            c = siguiente;
+        }
+        return valores;
+    }
+
+    /**
+     * Lee una línea base escrita por guardarLineaBase.
+     *
+     * CÓMO: No es un lector de JSON general: busca las claves conocidas y toma de cada
+     *       operación su nombre y sus muestras; las estadísticas se recalculan.
+     */
+    bool leerLineaBase(const std::string& ruta, LineaBase& base) {
+        std::ifstream archivo(ruta);
+        if (!archivo) {
+            return false;
+        }
+        std::stringstream contenido;
+        contenido << archivo.rdbuf();
+        const std::string texto = contenido.str();
+
+        size_t inicioOperaciones = texto.find("\"operaciones\"");
+        if (inicioOperaciones == std::string::npos) {
+            std::cerr << "Error: " << ruta << " no tiene \"operaciones\"\n";
+            return false;
+        }
+        const std::string cabecera = texto.substr(0, inicioOperaciones);
+        double formato = 0, semilla = 0, personas = 0, hilos = 0, repeticiones = 0;
+        if (!leerNumero(cabecera, "formato", formato) || static_cast<int>(formato) != FORMATO ||
+            !leerNumero(cabecera, "semilla", semilla) || !leerNumero(cabecera, "personas", personas) ||
+            !leerNumero(cabecera, "repeticiones", repeticiones) || personas < 1) {
+            std::cerr << "Error: cabecera inválida o de otro formato en " << ruta << "\n";
+            return false;
+        }
+        leerNumero(cabecera, "hilos", hilos);
+        base.semilla = static_cast<unsigned>(semilla);
+        base.personas = static_cast<size_t>(personas);
+        base.hilos = static_cast<unsigned>(hilos);
+        base.repeticiones = static_cast<int>(repeticiones);
+
+        for (size_t p = texto.find('{', inicioOperaciones); p != std::string::npos; p = texto.find('{', p)) {
+            size_t fin = texto.find('}', p);
+            if (fin == std::string::npos) {
+                break;
+            }
+            const std::string objeto = texto.substr(p, fin - p);
+            p = fin;
+
+            Resumen r;
+            size_t nombre = objeto.find("\"nombre\"");
+            r.muestras = leerArreglo(objeto, "muestras_ms");
+            if (nombre == std::string::npos || r.muestras.empty()) {
+                continue;
+            }
+            size_t abre = objeto.find('"', objeto.find(':', nombre));
+            size_t cierra = objeto.find('"', abre + 1);
+            r.nombre = objeto.substr(abre + 1, cierra - abre - 1);
+            resumir(r);
+            base.operaciones.push_back(std::move(r));
+        }
+        return !base.operaciones.empty();
+    }
+
+    /**
+     * Compara cada operación con la línea base; devuelve cuántas empeoraron.
+     *
+     * CÓMO: Prueba t de Welch (varianzas distintas) sobre las muestras de ambas
+     *       corridas, con los grados de libertad de Welch-Satterthwaite. Si la base se
+     *       midió con otra cantidad de hilos, las operaciones paralelas se omiten.
+     */
+    size_t comparar(const LineaBase& base, const std::vector<Resumen>& actuales, double umbral) {
+        const bool mismosHilos = base.hilos == numeroHilos();
+        std::cout << "\n" << std::left << std::setw(20) << "Operación" << std::right << std::setw(13) << "Base (ms)"
+                  << std::setw(14) << "Actual (ms)" << std::setw(10) << "Cambio" << std::setw(8) << "t"
+                  << "  Estado\n";
+        size_t regresiones = 0;
+        for (const Resumen& actual : actuales) {
+            auto it = std::find_if(base.operaciones.begin(), base.operaciones.end(),
+                                   [&](const Resumen& r) { return r.nombre == actual.nombre; });
+            std::cout << std::left << std::setw(20) << actual.nombre << std::right << std::fixed;
+            if (actual.paralela && !mismosHilos) {
+                std::cout << std::setw(13) << "-" << std::setprecision(4) << std::setw(14) << actual.media
+                          << std::setw(10) << "-" << std::setw(8) << "-" << "  OMITIDA (hilos distintos)\n";
+                continue;
+            }
+            if (it == base.operaciones.end() || it->media <= 0) {
+                std::cout << std::setw(13) << "-" << std::setprecision(4) << std::setw(14) << actual.media
+                          << std::setw(10) << "-" << std::setw(8) << "-" << "  SIN BASE\n";
+                continue;
+            }
+            const Resumen& anterior = *it;
+            double varianzaBase = anterior.desviacion * anterior.desviacion / anterior.muestras.size();
+            double varianzaActual = actual.desviacion * actual.desviacion / actual.muestras.size();
+            double errorEstandar = std::sqrt(varianzaBase + varianzaActual);
+            double t = errorEstandar > 0 ? (actual.media - anterior.media) / errorEstandar : 0.0;
+            bool significativo;
+            if (errorEstandar > 0) {
+                double gradosLibertad = (varianzaBase + varianzaActual) * (varianzaBase + varianzaActual) /
+                    ((anterior.muestras.size() > 1 ? varianzaBase * varianzaBase / (anterior.muestras.size() - 1) : 0) +
+                     (actual.muestras.size() > 1 ? varianzaActual * varianzaActual / (actual.muestras.size() - 1) : 0));
+                significativo = std::fabs(t) > tCritico(gradosLibertad);
+            } else {
+                significativo = actual.media != anterior.media;
+            }
+
+            double cambio = (actual.media - anterior.media) / anterior.media * 100.0;
+            const char* estado = "OK";
+            if (cambio > umbral && significativo) {
+                estado = "REGRESIÓN";
+                ++regresiones;
+            } else if (cambio < -umbral && significativo) {
+                estado = "MEJORA";
+            } else if (std::fabs(cambio) > umbral) {
+                estado = "RUIDO (no significativo)";
+            }
+            std::cout << std::setprecision(4) << std::setw(13) << anterior.media << std::setw(14) << actual.media
+                      << std::setprecision(1) << std::setw(9) << cambio << "%" << std::setprecision(2)
+                      << std::setw(8) << t << "  " << estado << "\n";
+        }
+        return regresiones;
+    }
+}
+
+/**
+ * Implementación de ejecutarRegresion.
+ *
+ * POR QUÉ: Ver regresion.h.
+ * CÓMO: Al comparar, la carga se corre con la semilla, el tamaño y las repeticiones
+ *       de la línea base (no con los argumentos), para medir exactamente lo mismo.
+ */
+int ejecutarRegresion(bool compararContraBase, const std::string& archivo, double umbral,
+                      size_t personas, int repeticiones) {
+    LineaBase base;
+    if (compararContraBase) {
+        if (!std::ifstream(archivo).good()) {
+            std::cerr << "Error: no existe la línea base " << archivo << "; ejecute `make linea-base` primero\n";
+            return 2;
+        }
+        if (!leerLineaBase(archivo, base)) {
+            std::cerr << "Error: no se pudo leer la línea base " << archivo << "\n";
+            return 2;
+        }
+        personas = base.personas;
+        repeticiones = base.repeticiones;
+        if (base.hilos != numeroHilos()) {
+            std::cout << "Aviso: la línea base se midió con " << base.hilos << " hilos y esta máquina tiene "
+                      << numeroHilos() << "; las operaciones paralelas se omiten\n";
+        }
+    }
+
+    std::cout << "=== PUERTA DE REGRESIÓN ===\n"
+              << personas << " personas (semilla " << base.semilla << "), " << repeticiones
+              << " repeticiones, " << numeroHilos() << " hilos\n\n";
+    std::vector<Resumen> actuales = correrCarga(base.semilla, personas, repeticiones);
+
+    if (!compararContraBase) {
+        LineaBase nueva;
+        nueva.semilla = base.semilla;
+        nueva.personas = personas;
+        nueva.hilos = numeroHilos();
+        nueva.repeticiones = repeticiones;
+        nueva.operaciones = std::move(actuales);
+        if (!guardarLineaBase(nueva, archivo)) {
+            return 2;
+        }
+        std::cout << "\nLínea base guardada en " << archivo << "\n";
+        return 0;
+    }
+
+    size_t regresiones = comparar(base, actuales, umbral);
+    std::cout.unsetf(std::ios::floatfield);
+    if (regresiones > 0) {
+        std::cout << "\nFALLÓ: " << regresiones << " operación(es) más de " << umbral
+                  << " % más lentas que la línea base\n";
+        return 1;
+    }
+    std::cout << "\nOK: ninguna operación empeoró más de " << umbral << " % de forma significativa\n";
+    return 0;
+}
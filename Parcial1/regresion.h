@@ -0,0 +1,41 @@
+#ifndef REGRESION_H
+#define REGRESION_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * Puerta de regresión de rendimiento con línea base guardada en JSON.
+ *
+ * POR QUÉ: Monitor::exportar_csv y el barrido dejan mediciones sueltas que nadie
+ *          compara con corridas anteriores; una consulta que se vuelve 30 % más lenta
+ *          pasa desapercibida.
+ * CÓMO: Corre una carga fija y sembrada (mismo conjunto de personas en cada corrida)
+ *       con las consultas principales: generación, consultas del motor, radix,
+ *       agregación por ciudad, cubo OLAP, group-by, histogramas, reglas tributarias y
+ *       columnas comprimidas. Cada operación se calienta una vez y se mide
+ *       `repeticiones` veces en rondas intercaladas (las muy cortas se agrupan en
+ *       iteraciones hasta sumar al menos 20 ms por muestra); se resume con media,
+ *       mediana, desviación e intervalo de confianza del 95 % (t de Student).
+ *         - guardar: escribe el resumen y las muestras en la línea base.
+ *         - comparar: repite la carga con los parámetros de la línea base y aplica
+ *           una prueba t de Welch por operación. Es regresión si la media empeora
+ *           más que el umbral y la diferencia es significativa; si supera el umbral
+ *           pero no es significativa se reporta como ruido. Si la línea base se
+ *           midió con otra cantidad de hilos, las operaciones paralelas se omiten.
+ * PARA QUÉ: `make regresion` falla cuando una consulta se vuelve más lenta.
+ *
+ * La línea base solo vale para la máquina donde se guardó. En máquinas compartidas la
+ * velocidad cambia entre corridas más de lo que varía dentro de una: ahí conviene un
+ * umbral mayor (make regresion UMBRAL=30).
+ *
+ * @param comparar false: guardar la línea base; true: compararse contra ella (si el
+ *                 archivo no existe devuelve 2: primero hay que guardarla).
+ * @param umbral Empeoramiento tolerado en porcentaje (p. ej. 10).
+ * @return 0 sin regresiones; 1 si alguna operación empeoró; 2 si la línea base no
+ *         existe o no se pudo leer o escribir.
+ */
+int ejecutarRegresion(bool comparar, const std::string& archivo, double umbral,
+                      size_t personas, int repeticiones);
+
+#endif // REGRESION_H
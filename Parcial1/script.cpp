@@ -0,0 +1,377 @@
+#include "script.h"
+#include "motor_consultas.h"
+#include "instantaneas.h"
+#include "generador.h"
+#include "monitor.h"
+#include "pool_hilos.h"
+#include "exportacion.h"
+#include "paralelo.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    struct Orden {
+        int linea = 0;
+        std::string comando;
+        std::string argumento;     // Resto de la línea (ruta, número, argumento de consulta)
+        std::string consulta;      // Nombre de la consulta (solo "consulta")
+        TipoConsulta tipo = TipoConsulta::Ping;
+        long numero = 0;           // N de generar, K de repetir, hilos de paralelo
+        CriterioOrden criterio = CriterioOrden::Patrimonio; // Solo "ordenar"
+        bool descendente = true;                            // Solo "ordenar"
+        double exponente = 1.0;                             // Solo "distribucion ciudades zipf"
+        std::vector<Orden> cuerpo; // Órdenes de repetir / paralelo
+    };
+
+    struct Contexto {
+        MotorConsultas motor;
+        Monitor monitor;
+        bool mostrar = true;
+        std::map<std::string, std::vector<double>> tiempos; // Para el resumen final
+    };
+
+    std::string recortar(const std::string& texto) {
+        size_t inicio = texto.find_first_not_of(" \t\r");
+        if (inicio == std::string::npos) {
+            return "";
+        }
+        size_t fin = texto.find_last_not_of(" \t\r");
+        return texto.substr(inicio, fin - inicio + 1);
+    }
+
+    // Separa la primera palabra del resto de la línea
+    void partir(const std::string& texto, std::string& primera, std::string& resto) {
+        size_t espacio = texto.find_first_of(" \t");
+        primera = texto.substr(0, espacio);
+        resto = espacio == std::string::npos ? "" : recortar(texto.substr(espacio));
+    }
+
+    bool leerEntero(const std::string& texto, long minimo, long& valor) {
+        char* fin = nullptr;
+        valor = std::strtol(texto.c_str(), &fin, 10);
+        return !texto.empty() && *fin == '\0' && valor >= minimo;
+    }
+
+    bool error(const std::string& origen, int linea, const std::string& mensaje) {
+        std::cerr << origen << ":" << linea << ": " << mensaje << "\n";
+        return false;
+    }
+
+    /**
+     * Lee órdenes hasta el fin del flujo o hasta un "fin" que cierre el bloque.
+     *
+     * POR QUÉ: Un error en la línea 40 no debe descubrirse después de generar millones
+     *          de personas en la línea 1.
+     * CÓMO: Análisis recursivo: repetir y paralelo leen su cuerpo con esta misma función.
+     * PARA QUÉ: Validar el script completo antes de ejecutar la primera orden.
+     */
+    bool leerBloque(std::istream& entrada, const std::string& origen, int& linea,
+                    std::vector<Orden>& destino, const Orden* abierto) {
+        std::string texto;
+        while (std::getline(entrada, texto)) {
+            ++linea;
+            texto = recortar(texto.substr(0, texto.find('#')));
+            if (texto.empty()) {
+                continue;
+            }
+
+            Orden orden;
+            orden.linea = linea;
+            partir(texto, orden.comando, orden.argumento);
+            const std::string& c = orden.comando;
+
+            if (c == "fin") {
+                if (!abierto) {
+                    return error(origen, linea, "'fin' sin 'repetir' ni 'paralelo'");
+                }
+                return true;
+            }
+            if (abierto && abierto->comando == "paralelo" && c != "consulta") {
+                return error(origen, linea, "dentro de 'paralelo' solo se permiten consultas");
+            }
+
+            if (c == "generar") {
+                if (!leerEntero(orden.argumento, 1, orden.numero)) {
+                    return error(origen, linea, "uso: generar N (N > 0)");
+                }
+            } else if (c == "cargar" || c == "guardar") {
+                if (orden.argumento.empty()) {
+                    return error(origen, linea, "uso: " + c + " RUTA");
+                }
+            } else if (c == "consulta") {
+                partir(orden.argumento, orden.consulta, orden.argumento);
+                if (!consultaPorNombre(orden.consulta, orden.tipo) || orden.tipo == TipoConsulta::Apagar) {
+                    return error(origen, linea, "consulta desconocida '" + orden.consulta +
+                                 "'; disponibles: " + nombresConsultas());
+                }
+            } else if (c == "ordenar") {
+                std::istringstream partes(orden.argumento);
+                std::string criterio, sentido, ruta;
+                partes >> criterio >> sentido >> ruta;
+                bool criterioValido = false;
+                for (CriterioOrden opcion : {CriterioOrden::Patrimonio, CriterioOrden::Ingresos,
+                                             CriterioOrden::Deudas, CriterioOrden::FechaNacimiento}) {
+                    if (criterio == nombreCriterio(opcion)) {
+                        orden.criterio = opcion;
+                        criterioValido = true;
+                    }
+                }
+                if (!criterioValido || (sentido != "asc" && sentido != "desc") || ruta.empty()) {
+                    return error(origen, linea, "uso: ordenar patrimonio|ingresos|deudas|fecha asc|desc RUTA");
+                }
+                orden.descendente = sentido == "desc";
+                orden.argumento = ruta;
+            } else if (c == "distribucion") {
+                std::istringstream partes(orden.argumento);
+                std::string dimension, tipo;
+                partes >> dimension >> tipo;
+                bool valida = (dimension == "ciudades" && (tipo == "uniforme" || tipo == "zipf")) ||
+                              (dimension == "dinero" && (tipo == "uniforme" || tipo == "lognormal" || tipo == "pareto")) ||
+                              (dimension == "edades" && (tipo == "uniforme" || tipo == "piramide"));
+                double exponente = 1.0;
+                std::string sobrante;
+                if (tipo == "zipf" && partes >> sobrante) {
+                    // Si viene un exponente debe ser un número completo ("abc" o "1.5x" son error)
+                    char* fin = nullptr;
+                    exponente = std::strtod(sobrante.c_str(), &fin);
+                    valida = valida && *fin == '\0';
+                }
+                if (partes >> sobrante) {
+                    valida = false; // Palabras de más después del tipo (o del exponente)
+                }
+                if (!valida || !(exponente > 0)) {
+                    return error(origen, linea, "uso: distribucion ciudades uniforme|zipf [S] | "
+                                 "dinero uniforme|lognormal|pareto | edades uniforme|piramide");
+                }
+                orden.consulta = dimension;
+                orden.argumento = tipo;
+                orden.exponente = exponente;
+            } else if (c == "mostrar" || c == "cache") {
+                if (orden.argumento != "si" && orden.argumento != "no") {
+                    return error(origen, linea, "uso: " + c + " si|no");
+                }
+            } else if (c == "repetir") {
+                if (!leerEntero(orden.argumento, 1, orden.numero)) {
+                    return error(origen, linea, "uso: repetir K (K > 0) ... fin");
+                }
+            } else if (c == "paralelo") {
+                orden.numero = numeroHilos();
+                if (!orden.argumento.empty() && !leerEntero(orden.argumento, 1, orden.numero)) {
+                    return error(origen, linea, "uso: paralelo [HILOS] ... fin");
+                }
+            } else if (c != "exportar" && c != "resumen") {
+                return error(origen, linea, "orden desconocida '" + c + "'");
+            }
+
+            if (c == "repetir" || c == "paralelo") {
+                if (!leerBloque(entrada, origen, linea, orden.cuerpo, &orden)) {
+                    return false;
+                }
+            }
+            destino.push_back(std::move(orden));
+        }
+
+        if (abierto) {
+            return error(origen, abierto->linea, "'" + abierto->comando + "' sin 'fin'");
+        }
+        return true;
+    }
+
+    const char* nombreEstado(EstadoRespuesta estado) {
+        switch (estado) {
+            case EstadoRespuesta::Ok: return "ok";
+            case EstadoRespuesta::NoEncontrado: return "no encontrado";
+            default: return "inválida";
+        }
+    }
+
+    void registrar(Contexto& ctx, const std::string& operacion, double tiempo, long memoria) {
+        ctx.monitor.registrar("Script: " + operacion, tiempo, memoria);
+        ctx.tiempos[operacion].push_back(tiempo);
+    }
+
+    void mostrarConsulta(const Orden& orden, EstadoRespuesta estado, const std::string& texto, double tiempo) {
+        std::cout << "[" << orden.linea << "] " << orden.consulta
+                  << (orden.argumento.empty() ? "" : " ") << orden.argumento << " -> "
+                  << nombreEstado(estado) << (texto.empty() ? "" : ": ") << texto
+                  << " (" << tiempo << " ms)\n";
+    }
+
+    // Reemplaza el conjunto del motor y mide por separado la construcción de índices
+    void cargarEnMotor(Contexto& ctx, ColeccionPersonas personas) {
+        ctx.monitor.iniciar_tiempo();
+        long memoria_inicio = ctx.monitor.obtener_memoria();
+        ctx.motor.cargar(std::move(personas));
+        registrar(ctx, "indexar", ctx.monitor.detener_tiempo(), ctx.monitor.obtener_memoria() - memoria_inicio);
+    }
+
+    bool ejecutar(const std::vector<Orden>& ordenes, Contexto& ctx, const std::string& origen) {
+        for (const Orden& orden : ordenes) {
+            const std::string& c = orden.comando;
+
+            if (c == "generar") {
+                ctx.monitor.iniciar_tiempo();
+                long memoria_inicio = ctx.monitor.obtener_memoria();
+                ColeccionPersonas personas = generarColeccion(static_cast<int>(orden.numero));
+                double tiempo = ctx.monitor.detener_tiempo();
+                registrar(ctx, "generar", tiempo, ctx.monitor.obtener_memoria() - memoria_inicio);
+                std::cout << "[" << orden.linea << "] generadas " << personas.size()
+                          << " personas en " << tiempo << " ms\n";
+                cargarEnMotor(ctx, std::move(personas));
+            } else if (c == "cargar") {
+                ctx.monitor.iniciar_tiempo();
+                long memoria_inicio = ctx.monitor.obtener_memoria();
+                ColeccionPersonas personas;
+                if (!cargarInstantanea(orden.argumento, personas)) {
+                    return error(origen, orden.linea, "no se pudo cargar " + orden.argumento);
+                }
+                double tiempo = ctx.monitor.detener_tiempo();
+                registrar(ctx, "cargar", tiempo, ctx.monitor.obtener_memoria() - memoria_inicio);
+                std::cout << "[" << orden.linea << "] cargadas " << personas.size()
+                          << " personas en " << tiempo << " ms\n";
+                cargarEnMotor(ctx, std::move(personas));
+            } else if (c == "guardar") {
+                ctx.monitor.iniciar_tiempo();
+                if (!guardarInstantanea(ctx.motor.personas, orden.argumento)) {
+                    return error(origen, orden.linea, "no se pudo escribir " + orden.argumento);
+                }
+                double tiempo = ctx.monitor.detener_tiempo();
+                registrar(ctx, "guardar", tiempo, 0);
+                std::cout << "[" << orden.linea << "] guardadas " << ctx.motor.personas.size()
+                          << " personas en " << tiempo << " ms\n";
+            } else if (c == "ordenar") {
+                ResultadoExportacion r;
+                if (!exportarOrdenado(ctx.motor.personas.datos(), orden.criterio, orden.descendente,
+                                      orden.argumento, r)) {
+                    return error(origen, orden.linea, "no se pudo escribir " + orden.argumento);
+                }
+                std::string etiqueta = std::string("ordenar ") + nombreCriterio(orden.criterio);
+                registrar(ctx, etiqueta, r.tiempoOrdenar + r.tiempoEscribir, 0);
+                ctx.monitor.registrar_rendimiento("Script: " + etiqueta, r.filas, r.tiempoOrdenar + r.tiempoEscribir);
+                std::cout << "[" << orden.linea << "] " << r.filas << " filas en " << orden.argumento
+                          << " (ordenar " << r.tiempoOrdenar << " ms, escribir " << r.tiempoEscribir << " ms)\n";
+            } else if (c == "consulta") {
+                if (!ctx.motor.valores.construido()) {
+                    return error(origen, orden.linea, "no hay datos: use 'generar' o 'cargar' antes");
+                }
+                std::string texto;
+                ctx.monitor.iniciar_tiempo();
+                long memoria_inicio = ctx.monitor.obtener_memoria();
+                EstadoRespuesta estado = resolverConsulta(ctx.motor, orden.tipo, orden.argumento, texto);
+                double tiempo = ctx.monitor.detener_tiempo();
+                registrar(ctx, "consulta " + orden.consulta, tiempo, ctx.monitor.obtener_memoria() - memoria_inicio);
+                if (ctx.mostrar) {
+                    mostrarConsulta(orden, estado, texto, tiempo);
+                }
+            } else if (c == "distribucion") {
+                ConfiguracionGenerador config = configuracionGenerador();
+                if (orden.consulta == "ciudades") {
+                    config.ciudades = orden.argumento == "zipf" ? DistribucionCiudades::Zipf
+                                                                : DistribucionCiudades::Uniforme;
+                    config.exponenteZipf = orden.exponente;
+                } else if (orden.consulta == "dinero") {
+                    config.dinero = orden.argumento == "lognormal" ? DistribucionDinero::LogNormal
+                                  : orden.argumento == "pareto" ? DistribucionDinero::Pareto
+                                  : DistribucionDinero::Uniforme;
+                } else {
+                    config.edades = orden.argumento == "piramide" ? DistribucionEdades::Piramide
+                                                                  : DistribucionEdades::Uniforme;
+                }
+                configurarGenerador(config);
+                std::cout << "[" << orden.linea << "] " << describirConfiguracion(config) << "\n";
+            } else if (c == "mostrar") {
+                ctx.mostrar = orden.argumento == "si";
+            } else if (c == "cache") {
+                ctx.motor.usarCache = orden.argumento == "si";
+            } else if (c == "exportar") {
+                ctx.monitor.exportar_csv(orden.argumento.empty() ? "estadisticas.csv" : orden.argumento);
+            } else if (c == "resumen") {
+                ctx.monitor.mostrar_resumen();
+                mostrarUsoCache(ctx.motor);
+            } else if (c == "repetir") {
+                for (long i = 0; i < orden.numero; ++i) {
+                    if (!ejecutar(orden.cuerpo, ctx, origen)) {
+                        return false;
+                    }
+                }
+            } else if (c == "paralelo") {
+                if (!ctx.motor.valores.construido()) {
+                    return error(origen, orden.linea, "no hay datos: use 'generar' o 'cargar' antes");
+                }
+                // El motor no cambia durante el bloque: las consultas son independientes
+                struct Resultado {
+                    EstadoRespuesta estado;
+                    std::string texto;
+                    double tiempo;
+                };
+                PoolHilos pool(static_cast<unsigned>(orden.numero));
+                ctx.monitor.iniciar_tiempo();
+                std::vector<std::future<Resultado>> futuros;
+                for (const Orden& consulta : orden.cuerpo) {
+                    futuros.push_back(pool.enviar([&ctx, &consulta]() {
+                        auto inicio = std::chrono::high_resolution_clock::now();
+                        Resultado r;
+                        r.estado = resolverConsulta(ctx.motor, consulta.tipo, consulta.argumento, r.texto);
+                        std::chrono::duration<double, std::milli> d = std::chrono::high_resolution_clock::now() - inicio;
+                        r.tiempo = d.count();
+                        return r;
+                    }));
+                }
+                std::vector<Resultado> resultados;
+                for (auto& f : futuros) {
+                    resultados.push_back(f.get());
+                }
+                double tiempo = ctx.monitor.detener_tiempo();
+
+                double suma = 0;
+                for (size_t i = 0; i < resultados.size(); ++i) {
+                    const Orden& consulta = orden.cuerpo[i];
+                    registrar(ctx, "consulta " + consulta.consulta + " (paralelo)", resultados[i].tiempo, 0);
+                    suma += resultados[i].tiempo;
+                    if (ctx.mostrar) {
+                        mostrarConsulta(consulta, resultados[i].estado, resultados[i].texto, resultados[i].tiempo);
+                    }
+                }
+                registrar(ctx, "paralelo", tiempo, 0);
+                std::cout << "[" << orden.linea << "] " << resultados.size() << " consultas con "
+                          << pool.size() << " hilos en " << tiempo << " ms (suma secuencial "
+                          << suma << " ms)\n";
+            }
+        }
+        return true;
+    }
+}
+
+int ejecutarScript(std::istream& entrada, const std::string& origen) {
+    std::vector<Orden> ordenes;
+    int linea = 0;
+    if (!leerBloque(entrada, origen, linea, ordenes, nullptr)) {
+        return 1;
+    }
+
+    Contexto ctx;
+    bool completo = ejecutar(ordenes, ctx, origen);
+
+    std::cout << "\n=== RESUMEN DEL SCRIPT ===\n";
+    std::cout << std::left << std::setw(40) << "Orden" << std::right << std::setw(8) << "Veces"
+              << std::setw(14) << "Mín (ms)" << std::setw(14) << "Prom (ms)" << std::setw(14) << "Máx (ms)" << "\n";
+    for (const auto& [operacion, tiempos] : ctx.tiempos) {
+        auto [minimo, maximo] = std::minmax_element(tiempos.begin(), tiempos.end());
+        double suma = 0;
+        for (double t : tiempos) {
+            suma += t;
+        }
+        std::cout << std::left << std::setw(40) << operacion << std::right << std::setw(8) << tiempos.size()
+                  << std::fixed << std::setprecision(4) << std::setw(14) << *minimo
+                  << std::setw(14) << suma / tiempos.size() << std::setw(14) << *maximo << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    mostrarUsoCache(ctx.motor); // Los tiempos de las consultas servidas desde la caché no son recorridos
+    return completo ? 0 : 1;
+}
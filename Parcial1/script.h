@@ -0,0 +1,36 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <istream>
+#include <string>
+
+/**
+ * Modo script: ejecuta una secuencia de órdenes sin pasar por el menú.
+ *
+ * POR QUÉ: Para medir se repetían a mano las mismas opciones del menú, y leer cada
+ *          respuesta con std::cin es lento y fácil de desalinear (un número donde se
+ *          esperaba una cédula deja el menú en un ciclo infinito).
+ * CÓMO: Se lee y valida todo el script antes de ejecutar nada; luego cada orden corre
+ *       seguida de la anterior y queda registrada en el Monitor. Órdenes (una por
+ *       línea, '#' inicia un comentario):
+ *         generar N               genera N personas y construye los índices
+ *         distribucion DIM TIPO   ciudades uniforme|zipf [S], dinero uniforme|lognormal|pareto,
+ *                                 edades uniforme|piramide (ver configurarGenerador)
+ *         cargar RUTA             carga un conjunto guardado (ver cargarInstantanea)
+ *         guardar RUTA            guarda el conjunto actual
+ *         consulta NOMBRE [ARG]   resuelve una consulta del motor (ver motor_consultas.h)
+ *         mostrar si|no           imprime o no el resultado de cada consulta
+ *         cache si|no             usa o no la caché del motor en los recorridos completos
+ *         exportar [RUTA]         exporta las estadísticas del Monitor a CSV
+ *         ordenar CRITERIO asc|desc RUTA  exporta la población ordenada (ver exportacion.h)
+ *         resumen                 muestra el resumen del Monitor
+ *         repetir K ... fin       repite el bloque K veces
+ *         paralelo [HILOS] ... fin  corre las consultas del bloque a la vez
+ * PARA QUÉ: `./programa --script archivo.txt` o `./programa --script -` (entrada
+ *           estándar); al final se muestra el mínimo/promedio/máximo por orden y
+ *           los aciertos de la caché del motor.
+ * @return 0 si todo el script se ejecutó; 1 ante un error de sintaxis o de ejecución.
+ */
+int ejecutarScript(std::istream& entrada, const std::string& origen);
+
+#endif // SCRIPT_H
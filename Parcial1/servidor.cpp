@@ -0,0 +1,199 @@
+#include "servidor.h"
+#include "protocolo.h"
+#include "pool_hilos.h"
+#include "generador.h"
+#include "motor_consultas.h"
+#include "monitor.h"
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    struct Solicitud {
+        CabeceraSolicitud cabecera;
+        std::string argumento;
+    };
+
+    // Agrega la respuesta de una solicitud (cabecera + texto) a la salida del lote
+    void responder(const MotorConsultas& motor, const Solicitud& solicitud, std::string& salida) {
+        std::string cuerpo;
+        EstadoRespuesta estado = resolverConsulta(motor, static_cast<TipoConsulta>(solicitud.cabecera.tipo),
+                                                  solicitud.argumento, cuerpo);
+        CabeceraRespuesta cabecera{solicitud.cabecera.id, static_cast<uint16_t>(estado), 0,
+                                   static_cast<uint32_t>(cuerpo.size())};
+        salida.append(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+        salida.append(cuerpo);
+    }
+
+    std::atomic<bool> apagando{false};
+    std::atomic<size_t> solicitudesAtendidas{0};
+    std::atomic<size_t> lotesAtendidos{0};
+
+    // Conexiones abiertas, para despertar al apagar a los clientes que no envían nada.
+    // Se cierran con el candado tomado: así el número de un fd cerrado no se reutiliza
+    // antes de que el apagado lo recorra.
+    std::mutex candadoClientes;
+    std::set<int> clientesAbiertos;
+
+    void cerrarCliente(int fd) {
+        std::lock_guard<std::mutex> candado(candadoClientes);
+        clientesAbiertos.erase(fd);
+        close(fd);
+    }
+
+    /**
+     * Atiende una conexión hasta que el cliente la cierre.
+     *
+     * POR QUÉ: Con pipelining llegan varias solicitudes en cada lectura.
+     * CÓMO: Acumula bytes, separa todas las solicitudes completas, reparte el lote en
+     *       trozos entre el pool, junta las respuestas en orden y las envía con una
+     *       sola escritura. Lo incompleto queda en el buffer para la siguiente lectura.
+     * PARA QUÉ: Pocas llamadas al sistema por solicitud y trabajo en paralelo.
+     */
+    void atenderConexion(int fd, const MotorConsultas& motor, PoolHilos& pool, int servidor) {
+        std::vector<char> entrada;
+        std::vector<char> bloque(64 * 1024);
+        size_t consumido = 0;
+
+        for (;;) {
+            ssize_t leidos = read(fd, bloque.data(), bloque.size());
+            if (leidos < 0 && errno == EINTR) {
+                continue;
+            }
+            if (leidos <= 0) {
+                break;
+            }
+            entrada.insert(entrada.end(), bloque.begin(), bloque.begin() + leidos);
+
+            std::vector<Solicitud> lote;
+            while (entrada.size() - consumido >= sizeof(CabeceraSolicitud)) {
+                Solicitud s;
+                std::memcpy(&s.cabecera, entrada.data() + consumido, sizeof(s.cabecera));
+                size_t total = sizeof(s.cabecera) + s.cabecera.largo;
+                if (entrada.size() - consumido < total) {
+                    break;
+                }
+                s.argumento.assign(entrada.data() + consumido + sizeof(s.cabecera), s.cabecera.largo);
+                lote.push_back(std::move(s));
+                consumido += total;
+            }
+            entrada.erase(entrada.begin(), entrada.begin() + consumido);
+            consumido = 0;
+            if (lote.empty()) {
+                continue;
+            }
+
+            size_t trozo = std::max<size_t>(1, (lote.size() + pool.size() - 1) / pool.size());
+            std::vector<std::future<std::string>> partes;
+            for (size_t inicio = 0; inicio < lote.size(); inicio += trozo) {
+                size_t fin = std::min(lote.size(), inicio + trozo);
+                partes.push_back(pool.enviar([&motor, &lote, inicio, fin]() {
+                    std::string salida;
+                    for (size_t i = inicio; i < fin; ++i) {
+                        responder(motor, lote[i], salida);
+                    }
+                    return salida;
+                }));
+            }
+
+            std::string respuesta;
+            for (auto& parte : partes) {
+                respuesta += parte.get();
+            }
+            solicitudesAtendidas += lote.size();
+            ++lotesAtendidos;
+            if (!escribirTodo(fd, respuesta.data(), respuesta.size())) {
+                break;
+            }
+
+            for (const auto& s : lote) {
+                if (s.cabecera.tipo == static_cast<uint16_t>(TipoConsulta::Apagar)) {
+                    apagando = true;
+                    shutdown(servidor, SHUT_RDWR); // Despierta al accept() del hilo principal
+                }
+            }
+        }
+        cerrarCliente(fd);
+    }
+}
+
+int ejecutarServidor(const std::string& ruta, int n, unsigned hilos) {
+    Monitor monitor;
+    MotorConsultas motor;
+
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    motor.cargar(generarColeccion(n));
+    double tiempo_carga = monitor.detener_tiempo();
+    monitor.registrar("Servidor: generar e indexar", tiempo_carga, monitor.obtener_memoria() - memoria_inicio);
+    std::cout << "Conjunto de " << motor.personas.size() << " personas listo en " << tiempo_carga << " ms\n";
+
+    int servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (servidor < 0) {
+        perror("Error al crear el socket");
+        return 1;
+    }
+    sockaddr_un direccion{};
+    direccion.sun_family = AF_UNIX;
+    if (ruta.size() >= sizeof(direccion.sun_path)) {
+        std::cerr << "Error: ruta de socket demasiado larga: " << ruta << "\n";
+        close(servidor);
+        return 1;
+    }
+    std::strncpy(direccion.sun_path, ruta.c_str(), sizeof(direccion.sun_path) - 1);
+    unlink(ruta.c_str()); // Socket huérfano de una ejecución anterior
+    if (bind(servidor, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0 ||
+        listen(servidor, 128) < 0) {
+        perror("Error al abrir el socket");
+        close(servidor);
+        return 1;
+    }
+
+    PoolHilos pool(hilos);
+    std::cout << "Escuchando en " << ruta << " con " << pool.size() << " hilos trabajadores\n";
+
+    std::vector<std::thread> conexiones;
+    monitor.iniciar_tiempo();
+    while (!apagando) {
+        int cliente = accept(servidor, nullptr, nullptr);
+        if (cliente < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break; // shutdown() desde una conexión que pidió Apagar
+        }
+        {
+            std::lock_guard<std::mutex> candado(candadoClientes);
+            clientesAbiertos.insert(cliente);
+        }
+        conexiones.emplace_back(atenderConexion, cliente, std::cref(motor), std::ref(pool), servidor);
+    }
+    {
+        // Un cliente conectado pero inactivo dejaría su hilo en read() para siempre
+        std::lock_guard<std::mutex> candado(candadoClientes);
+        for (int fd : clientesAbiertos) {
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+    for (auto& c : conexiones) {
+        c.join();
+    }
+    double tiempo_servicio = monitor.detener_tiempo();
+    close(servidor);
+    unlink(ruta.c_str());
+
+    size_t solicitudes = solicitudesAtendidas.load();
+    size_t lotes = lotesAtendidos.load();
+    monitor.registrar("Servidor: atender solicitudes", tiempo_servicio, 0);
+    std::cout << "Servidor detenido: " << solicitudes << " solicitudes en " << lotes << " lotes ("
+              << (lotes ? static_cast<double>(solicitudes) / lotes : 0.0) << " por lote), "
+              << conexiones.size() << " conexiones\n";
+    monitor.mostrar_resumen();
+    mostrarUsoCache(motor);
+    return 0;
+}
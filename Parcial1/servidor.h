@@ -0,0 +1,21 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <string>
+
+/**
+ * Modo servidor: mantiene el conjunto en memoria y atiende consultas por socket Unix.
+ *
+ * POR QUÉ: El menú interactivo no se puede manejar desde otros servicios ni someter
+ *          a pruebas de carga.
+ * CÓMO: Genera n personas y construye los índices una sola vez; luego acepta
+ *       conexiones en un socket de dominio Unix. Cada conexión lee lotes de solicitudes
+ *       (ver protocolo.h), reparte el lote entre los hilos de un PoolHilos y responde
+ *       el lote completo con una sola escritura.
+ * PARA QUÉ: `./programa --servidor [ruta] [personas] [hilos]`; el programa
+ *           cliente_carga mide consultas por segundo y percentiles de latencia.
+ * @return Código de salida del proceso (0 si se apagó con la consulta Apagar).
+ */
+int ejecutarServidor(const std::string& ruta, int n, unsigned hilos);
+
+#endif // SERVIDOR_H
@@ -0,0 +1,79 @@
+#ifndef XOSHIRO_H
+#define XOSHIRO_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Generador xoshiro256+ con varios carriles independientes.
+ *
+ * POR QUÉ: std::mt19937 más una std::uniform_real_distribution por número (y rand()
+ *          con su estado global) cuestan decenas de ciclos por valor y no se pueden
+ *          vectorizar: cada número depende del anterior.
+ * CÓMO: CARRILES copias de xoshiro256+ guardadas como estructura de arreglos
+ *       (estado[palabra][carril]). Un paso avanza todos los carriles con sumas,
+ *       desplazamientos y xor sobre arreglos contiguos, que el compilador convierte en
+ *       instrucciones SIMD; llenar() entrega CARRILES números por paso. Las semillas
+ *       de cada carril salen de splitmix64, como recomiendan los autores de xoshiro.
+ * PARA QUÉ: Llenar bloques enteros de números aleatorios de una vez para el
+ *           generador por lotes.
+ *
+ * xoshiro256+ tiene los bits bajos algo débiles: para reales y rangos se usan solo los
+ * altos, y cada campo toma su propia palabra en lugar de partir una en dos.
+ */
+class XoshiroCarriles {
+public:
+    static constexpr size_t CARRILES = 8;
+
+    explicit XoshiroCarriles(uint64_t semilla) {
+        for (size_t c = 0; c < CARRILES; ++c) {
+            for (int p = 0; p < 4; ++p) {
+                estado[p][c] = splitmix64(semilla);
+            }
+        }
+    }
+
+    // Escribe n números (n múltiplo de CARRILES; si no, el último paso se recorta)
+    void llenar(uint64_t* salida, size_t n) {
+        for (size_t i = 0; i < n; i += CARRILES) {
+            uint64_t paso[CARRILES];
+            for (size_t c = 0; c < CARRILES; ++c) {
+                uint64_t s0 = estado[0][c], s1 = estado[1][c], s2 = estado[2][c], s3 = estado[3][c];
+                paso[c] = s0 + s3;
+                uint64_t t = s1 << 17;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= t;
+                s3 = (s3 << 45) | (s3 >> 19);
+                estado[0][c] = s0;
+                estado[1][c] = s1;
+                estado[2][c] = s2;
+                estado[3][c] = s3;
+            }
+            for (size_t c = 0; c < CARRILES && i + c < n; ++c) {
+                salida[i + c] = paso[c];
+            }
+        }
+    }
+
+    // Real uniforme en [0, 1) con los 53 bits altos
+    static double aUnidad(uint64_t u) { return static_cast<double>(u >> 11) * 0x1.0p-53; }
+
+    // Entero uniforme en [0, n) con los 32 bits altos (multiplicar y desplazar, sin división)
+    static uint32_t aRango(uint64_t u, uint32_t n) { return static_cast<uint32_t>(((u >> 32) * n) >> 32); }
+
+    // Avanza x y devuelve su siguiente valor mezclado (también sirve para derivar semillas)
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t estado[4][CARRILES];
+};
+
+#endif // XOSHIRO_H